@@ -62,14 +62,21 @@
 
 //#define CGCS_MALLOC_ENABLE_LOGGING
 
-#define MGR_ENABLE_TEST_A
-#define MGR_ENABLE_TEST_B
-#define MGR_ENABLE_TEST_C
-#define MGR_ENABLE_TEST_D
-#define MGR_ENABLE_TEST_E
-#define MGR_ENABLE_TEST_F
-
 #include "memgrind_c.h"
+#include "mgr_stats.h"
+#include "mgr_hist.h"
+#include "mgr_alloc.h"
+#include "mgr_calib.h"
+#include "mgr_config.h"
+#include "mgr_footprint.h"
+#include "mgr_locality.h"
+#include "mgr_matrix.h"
+#include "mgr_perf.h"
+#include "mgr_report.h"
+#include "mgr_script.h"
+#include "mgr_thread.h"
+#include "mgr_trace.h"
+#include "mgr_workload.h"
 
 #include "cgcs_ulog.h"
 #include "cgcs_vector.h"
@@ -78,22 +85,102 @@
 #include <stdarg.h>
 #include <stdint.h>
 
-typedef void (*memgrind_func_t)(uint32_t, uint32_t, uint32_t);
+/*
+    Run configuration, from the command line and config files
+    (see mgr_config.h, or run with --help).
+ */
+static mgr_config cfg;
+
+/*
+    Per-operation latency recorder, allocated by main
+    when op latency mode is enabled.
+ */
+static mgr_oplat *oplat_recorder = NULL;
+
+/*
+    Hardware counters, opened by main when --perf is given;
+    mgr_measure leaves the totals of the timed repetitions in
+    perf_totals, and the allocator calls they made in measured_ops.
+ */
+static mgr_perf perf_counters;
+static bool perf_enabled = false;
+static mgr_perf_counts perf_totals;
+static uint64_t measured_ops = 0;
+
+/*
+    mgr_realloc calls the timed repetitions made, and how many
+    of them kept the block in place.
+ */
+static uint64_t measured_reallocs = 0;
+static uint64_t measured_in_place = 0;
+
+/*
+    Time the timed repetitions spent traversing what they allocated
+    (tests o through q), and, with --perf, the counts of a second
+    set of counters, running during traversals only.
+ */
+static mgr_traversal measured_traversal;
+static mgr_perf traversal_counters;
+static bool traversal_perf_enabled = false;
+static mgr_perf_counts traversal_totals;
+
+/*
+    Thread cache counters before and after the timed repetitions,
+    when the backend has them (see mgr_cache_stats).
+ */
+static mgr_cache_stats cache_before;
+static mgr_cache_stats cache_after;
+static bool measured_cache = false;
 
-void mgr_run_test( memgrind_func_t test,
-                   char tch,
-                   uint32_t min,
-                   uint32_t max,
-                   uint32_t interval,
-                   FILE *dest);
+/*
+    With --calibrate, mgr_measure first runs the test on the null
+    backend and leaves the summary here (see mgr_calib.h).
+ */
+static mgr_summary harness;
+static bool calibrating = false;
 
-// memgrind: tests a through f (in order)
-void mgr_simple_alloc_free(uint32_t max_iter, uint32_t alloc_sz, uint32_t unused_value);
-void mgr_alloc_array_interval(uint32_t max_iter, uint32_t alloc_sz, uint32_t interval);
-void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t alloc_sz_max);
-void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value);
-void mgr_vector(uint32_t min, uint32_t max, uint32_t initial);
+/*
+    With --memory, mgr_measure leaves the footprint of one extra,
+    untimed repetition here, with the page faults of the timed ones.
+ */
+static mgr_footprint footprint;
+
+/*
+    With --heap, mgr_run_test walks the heap after every test and leaves
+    the summary here, and with --heap-dump, appends the snapshot to
+    heap_dump (see mgr_heap.h).
+ */
+static mgr_heap_summary heap_summary;
+static bool heap_walked = false;
+static FILE *heap_dump = NULL;
 
+/*
+    JSON/CSV results, when --json or --csv is given.
+ */
+static mgr_report results;
+
+void mgr_measure(memgrind_func_t test,
+                 uint32_t min,
+                 uint32_t max,
+                 uint32_t interval,
+                 mgr_summary *out,
+                 mgr_samples *raw);
+
+void mgr_run_test(const mgr_test *t, const char *section, const char *label, FILE *dest);
+
+void mgr_run_sweep(const mgr_sweep *sw, FILE *dest);
+void mgr_run_scripts(FILE *dest);
+void mgr_run_matrix(FILE *dest);
+void mgr_run_threaded_tests(FILE *dest);
+int mgr_run_comparison(const char *specs, FILE *dest);
+
+static void mgr_char_ptr_array_run(uint32_t min, uint32_t max, bool scoped);
+static void mgr_vector_run(uint32_t min, uint32_t max, uint32_t initial, bool scoped);
+
+/*
+    Default test parameters; each can be overridden at run time,
+    e.g. --a.iter 1000 or --d.max 4096.
+ */
 #define MGR_A_ITER_MAX 150
 
 #define MGR_B_ITER_MAX 150
@@ -112,7 +199,180 @@ void mgr_vector(uint32_t min, uint32_t max, uint32_t initial);
 #define MGR_F_MAX 32
 #define MGR_F_INITIAL 5
 
-#define MGR_MAX_ITER 100
+#define MGR_G_SIZE 4096
+#define MGR_G_LIVE 64
+#define MGR_G_OPS 1000
+
+#define MGR_I_MAX (1 << 20)
+#define MGR_I_GROWTH 200
+#define MGR_I_STEP 0
+
+#define MGR_J_COUNT 16
+#define MGR_J_SIZE (1 << 20)
+
+#define MGR_K_COUNT 1024
+#define MGR_K_SIZE 64
+#define MGR_K_BATCH 32
+
+#define MGR_O_NODES 4096
+#define MGR_O_PASSES 8
+#define MGR_O_NOISE 1
+
+#define MGR_R_ALLOCS 50
+#define MGR_R_ALIGN 64
+#define MGR_R_ALLOC_MAX 4096
+
+/*
+    Tests a through r, in order; terminated by a NULL test.
+    --tests selects which of them run (by default, a through f).
+ */
+static mgr_test mgr_tests[] = {
+    { mgr_simple_alloc_free,       // test a
+      'a',                         // alloc 1 byte, free 1 byte
+      MGR_A_ITER_MAX,              // run 150 times
+      1,                           // allocation size: 1 byte
+      0,                           // (unused parameter)
+      { "iter", "size", NULL },
+      true },
+
+    { mgr_alloc_array_interval,    // test b
+      'b',                         // allocate to limit, then free
+      MGR_B_ITER_MAX,              // run 150 times
+      1,                           // allocation size: 1 byte
+      MGR_B_INTERVAL,              // limit: 50
+      { "iter", "size", "interval" },
+      true },
+
+    { mgr_alloc_array_range,       // test c
+      'c',                         // randomly alloc/free 1 byte
+      MGR_C_ITER_MAX,              // run 50 times
+      1,                           // allocation size min: 1 byte
+      1,                           // allocation size max: 1 byte
+      { "allocs", "min", "max" },
+      true },
+
+    { mgr_alloc_array_range,       // test d
+      'd',                         // randomly alloc/free
+      MGR_D_ITER_MAX,              // run 50 times
+      MGR_D_ALLOC_MIN,             // allocation size min: 1 byte
+      MGR_D_ALLOC_MAX,             // allocation size max: 64 bytes
+      { "allocs", "min", "max" },
+      true },
+
+    { mgr_char_ptr_array,          // test e
+      'e',                         // buffer of random-size buffers
+      MGR_E_MIN,                   // min buffer size: 29 bytes
+      MGR_E_MAX,                   // max buffer size: 59 bytes
+      0,                           // (unused parameter)
+      { "min", "max", NULL },
+      true },
+
+    { mgr_vector,                  // test f
+      'f',                         // "vector" of string test
+      MGR_F_MIN,                   // min string size: 8 bytes
+      MGR_F_MAX,                   // max string size: 32 bytes
+      MGR_F_INITIAL,               // initial vector size: 5 elems
+      { "min", "max", "initial" },
+      true },
+
+    { mgr_size_class_churn,        // test g
+      'g',                         // fixed-size churn (see --matrix)
+      MGR_G_SIZE,                  // block size: 4096 bytes
+      MGR_G_LIVE,                  // live set: 64 blocks
+      MGR_G_OPS,                   // replacements: 1000
+      { "size", "live", "ops" },
+      false },
+
+    { mgr_vector_realloc,          // test h
+      'h',                         // test f, grown by realloc
+      MGR_F_MIN,                   // min string size: 8 bytes
+      MGR_F_MAX,                   // max string size: 32 bytes
+      MGR_F_INITIAL,               // initial vector size: 5 elems
+      { "min", "max", "initial" },
+      false },
+
+    { mgr_realloc_growth,          // test i
+      'i',                         // realloc growth, shrink to fit
+      MGR_I_MAX,                   // final size: 1 MiB
+      MGR_I_GROWTH,                // growth: 200% (doubling)
+      MGR_I_STEP,                  // constant step: none
+      { "max", "growth", "step" },
+      false },
+
+    { mgr_calloc_blocks,           // test j
+      'j',                         // large zeroed blocks
+      MGR_J_COUNT,                 // blocks: 16
+      MGR_J_SIZE,                  // block size: 1 MiB
+      0,                           // calloc (1: malloc + memset)
+      { "count", "size", "memset" },
+      false },
+
+    { mgr_batch_alloc,             // test k
+      'k',                         // bursts of equal-size blocks
+      MGR_K_COUNT,                 // blocks: 1024
+      MGR_K_SIZE,                  // block size: 64 bytes
+      MGR_K_BATCH,                 // blocks per burst: 32 (1: one call each)
+      { "count", "size", "batch" },
+      false },
+
+    { mgr_vector_bulk,             // test l
+      'l',                         // test f, in bursts
+      MGR_F_MIN,                   // min string size: 8 bytes
+      MGR_F_MAX,                   // max string size: 32 bytes
+      MGR_F_INITIAL,               // initial vector size: 5 elems
+      { "min", "max", "initial" },
+      false },
+
+    { mgr_char_ptr_array_scoped,   // test m
+      'm',                         // test e, released all at once
+      MGR_E_MIN,                   // min buffer size: 29 bytes
+      MGR_E_MAX,                   // max buffer size: 59 bytes
+      0,                           // (unused parameter)
+      { "min", "max", NULL },
+      false },
+
+    { mgr_vector_scoped,           // test n
+      'n',                         // test f, released all at once
+      MGR_F_MIN,                   // min string size: 8 bytes
+      MGR_F_MAX,                   // max string size: 32 bytes
+      MGR_F_INITIAL,               // initial vector size: 5 elems
+      { "min", "max", "initial" },
+      false },
+
+    { mgr_list_traverse,           // test o
+      'o',                         // linked list, built then walked
+      MGR_O_NODES,                 // nodes: 4096
+      MGR_O_PASSES,                // walks: 8
+      MGR_O_NOISE,                 // noise blocks per node: 1
+      { "nodes", "passes", "noise" },
+      false },
+
+    { mgr_tree_traverse,           // test p
+      'p',                         // search tree, built then searched
+      MGR_O_NODES,                 // nodes: 4096
+      MGR_O_PASSES,                // lookups of every key: 8
+      MGR_O_NOISE,                 // noise blocks per node: 1
+      { "nodes", "passes", "noise" },
+      false },
+
+    { mgr_hash_chains,             // test q
+      'q',                         // hash chains, built then probed
+      MGR_O_NODES,                 // nodes: 4096
+      MGR_O_PASSES,                // lookups of every key: 8
+      MGR_O_NOISE,                 // noise blocks per node: 1
+      { "nodes", "passes", "noise" },
+      false },
+
+    { mgr_aligned_array_range,     // test r
+      'r',                         // test d, aligned
+      MGR_R_ALLOCS,                // run 50 times
+      MGR_R_ALIGN,                 // alignment: 64 bytes
+      MGR_R_ALLOC_MAX,             // allocation size max: 4096 bytes
+      { "allocs", "align", "max" },
+      false },
+
+    { NULL, '\0', 0, 0, 0, { NULL, NULL, NULL }, false }
+};
 
 /*!
     \brief      Program execution begins and ends here.
@@ -129,136 +389,818 @@ int main(int argc, const char *argv[]) {
      */
     FILE *stream = stdout;
 
+    mgr_config_init(&cfg);
+
+    const int parsed = mgr_config_parse(&cfg, mgr_tests, argc, argv);
+
+    if (parsed != 0) {
+        mgr_config_usage(parsed > 0 ? stdout : stderr, argv[0], mgr_tests);
+        mgr_config_deinit(&cfg);
+        return parsed > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (cfg.diff) {
+        /*
+            Compare two earlier reports, run nothing: exit status is 0
+            if nothing regressed, 1 if something did, 2 on error.
+         */
+        char *comma = strchr(cfg.diff, ',');
+        const mgr_diff_opts opts = { cfg.diff_alpha, cfg.diff_threshold };
+
+        *comma = '\0';
+        const int diff = mgr_report_diff(cfg.diff, comma + 1, &opts, stream);
+
+        mgr_config_deinit(&cfg);
+        return diff < 0 ? 2 : diff;
+    }
+
+    // Machine-readable results on stdout move the table to stderr.
+    if ((cfg.json && strcmp(cfg.json, "-") == 0) || (cfg.csv && strcmp(cfg.csv, "-") == 0)) {
+        stream = stderr;
+    }
+
     // Important for randomization.
-    srand(time(NULL));
+    mgr_rand_seed(cfg.seed_set ? cfg.seed : mgr_rand_seed_default());
+    mgr_rand_tape_enabled = cfg.rand_tape;
+
+    if (mgr_backend_select(cfg.backend) != 0) {
+        fprintf(stderr, "memgrind: cannot select backend '%s'\n", cfg.backend);
+        mgr_config_deinit(&cfg);
+        return EXIT_FAILURE;
+    }
+
+    if (cfg.op_latency) {
+        oplat_recorder = mgr_oplat_new();
+    }
+
+    if (cfg.perf) {
+        char reason[128];
+
+        perf_enabled = mgr_perf_open(&perf_counters, reason, sizeof reason) == 0;
+
+        if (perf_enabled == false) {
+            fprintf(stderr, "memgrind: hardware counters unavailable: %s; continuing without them\n", reason);
+        } else {
+            traversal_perf_enabled = mgr_perf_open(&traversal_counters, reason, sizeof reason) == 0;
+        }
+    }
+
+    if (cfg.calibrate) {
+        mgr_timer_info timer;
+
+        mgr_timer_calibrate(&timer);
+        mgr_timer_fprint(stream, &timer);
+    }
 
     fprintf(stream, "\n%s\n"
-                    "%s %lu %s\n\n"
+                    "%s %s\n"
+                    "%s %llu%s\n"
+                    "%s %lu %s %lu %s\n\n"
                     "%s (%s)\n\n"
                     "%s\n"
-                    "%s\t\t%s\t\t%s\t\t%s\n"
+                    "%s\t%s\t\t%s\t\t%s\t\t%s\t\t%s\t\t%s\t\t%s\t\t%s\n"
                     "%s\n",
                     KGRN_b"cgcs memory allocator stress tests"KNRM,
-                    "Each indvidual test is run", (long int)(MGR_MAX_ITER), "times and wall-clock time averaged.",
+                    "Allocator backend:", mgr_backend_current->name,
+                    "Seed:", (unsigned long long)(mgr_rand_seed_value()),
+                    mgr_rand_tape_enabled ? " (random values pre-generated)" : "",
+                    "Each indvidual test is warmed up", (long int)(cfg.warmup),
+                    "times, then run", (long int)(cfg.reps), "times on the monotonic clock.",
                     "All times are expressed in", MCS,
-                    "-------------------------------------------------------------",
-                    KWHT_b"test"KNRM, KWHT_b"mean"KNRM, KWHT_b"slowest"KNRM, KWHT_b"total"KNRM,
-                    "-------------------------------------------------------------"
+                    "-----------------------------------------------------------------------------------------------------------------------------------------",
+                    KWHT_b"test"KNRM, KWHT_b"mean"KNRM, KWHT_b"±ci95"KNRM,
+                    KWHT_b"min"KNRM, KWHT_b"median"KNRM, KWHT_b"p90"KNRM,
+                    KWHT_b"p99"KNRM, KWHT_b"max"KNRM, KWHT_b"stddev"KNRM,
+                    "-----------------------------------------------------------------------------------------------------------------------------------------"
     );
 
-    #ifdef MGR_ENABLE_TEST_A
-    mgr_run_test(mgr_simple_alloc_free,        // test a 
-                  'a',                         // alloc 1 byte, free 1 byte 
-                  MGR_A_ITER_MAX,              // run 150 times 
-                  1,                           // allocation size: 1 byte 
-                  0,                           // (unused parameter) 
-                  stream);                     // output to stdout 
-    #endif
-
-    #ifdef MGR_ENABLE_TEST_B
-    mgr_run_test(mgr_alloc_array_interval,     // test b 
-                  'b',                         // allocate to limit, then free 
-                  MGR_B_ITER_MAX,              // run 150 times 
-                  1,                           // allocation size: 1 byte 
-                  MGR_B_INTERVAL,              // limit: 50 
-                  stream);                     // output to stdout 
-    #endif
-
-    #ifdef MGR_ENABLE_TEST_C
-    mgr_run_test(mgr_alloc_array_range,        // test c 
-                  'c',                         // randomly alloc/free 1 byte 
-                  MGR_C_ITER_MAX,              // run 50 times 
-                  1,                           // allocation size min: 1 byte 
-                  1,                           // allocation size max: 1 byte 
-                  stream);                     // output to stdout 
-    #endif
-
-    #ifdef MGR_ENABLE_TEST_D
-    mgr_run_test(mgr_alloc_array_range,        // test d 
-                  'd',                         // randomly alloc/free 
-                  MGR_D_ITER_MAX,              // run 50 times 
-                  MGR_D_ALLOC_MIN,             // allocation size min: 1 byte 
-                  MGR_D_ALLOC_MAX,             // allocation size max: 64 bytes 
-                  stream);                     // output to stdout 
-    #endif
-
-    #ifdef MGR_ENABLE_TEST_E
-    mgr_run_test(mgr_char_ptr_array,           // test e 
-                  'e',                         // buffer of random-size buffers 
-                  MGR_E_MIN,                   // min buffer size: 29 bytes 
-                  MGR_E_MAX,                   // max buffer size: 59 bytes 
-                  0,                           // (unused parameter) 
-                  stream);                     // output to stdout 
-    #endif
-
-    #ifdef MGR_ENABLE_TEST_F
-    mgr_run_test(mgr_vector,                   // test f 
-                  'f',                         // "vector" of string test 
-                  MGR_F_MIN,                   // min string size: 8 bytes 
-                  MGR_F_MAX,                   // max string size: 32 bytes 
-                  MGR_F_INITIAL,               // initial vector size: 5 elems 
-                  stream);                     // output to stdout 
-    #endif
+    int status = EXIT_SUCCESS;
+
+    const mgr_run_info info = {
+        mgr_backend_current->name, mgr_rand_seed_value(),
+        cfg.warmup, cfg.reps, cfg.rand_tape, cfg.op_latency, perf_enabled,
+        cfg.memory, cfg.calibrate
+    };
+
+    if (mgr_report_open(&results, cfg.json, cfg.csv, &info) != 0) {
+        status = EXIT_FAILURE;
+        goto done;
+    }
+
+    if (cfg.heap_dump && (heap_dump = fopen(cfg.heap_dump, "w")) == NULL) {
+        fprintf(stderr, "memgrind: %s: cannot open heap dump\n", cfg.heap_dump);
+        status = EXIT_FAILURE;
+        goto done;
+    }
+
+    if (cfg.trace_record && mgr_trace_record_begin(cfg.trace_record, MGR_TRACE_F_THREAD | MGR_TRACE_F_TIME) != 0) {
+        status = EXIT_FAILURE;
+        goto done;
+    }
+
+    for (const mgr_test *t = mgr_tests; t->test; ++t) {
+        if (t->enabled) {
+            mgr_run_test(t, "tests", NULL, stream);
+        }
+    }
+
+    if (cfg.trace_record && mgr_trace_record_end() != 0) {
+        fprintf(stderr, "memgrind: %s: trace incomplete\n", cfg.trace_record);
+    }
+
+    if (cfg.trace_replay) {
+        if (mgr_trace_replay_load(cfg.trace_replay) != 0) {
+            status = EXIT_FAILURE;
+            goto done;
+        }
+
+        const mgr_test replay = { mgr_trace_replay, 't', 0, 0, 0, { NULL, NULL, NULL }, true };
+
+        mgr_run_test(&replay, "replay", NULL, stream);
+        mgr_trace_replay_unload();
+    }
+
+    if (cfg.workload) {
+        if (mgr_script_load(cfg.workload) != 0) {
+            status = EXIT_FAILURE;
+            goto done;
+        }
+
+        mgr_run_scripts(stream);
+        mgr_script_unload();
+    }
+
+    for (uint32_t i = 0; i < cfg.nsweeps; ++i) {
+        mgr_run_sweep(&cfg.sweeps[i], stream);
+    }
+
+    if (cfg.matrix) {
+        mgr_run_matrix(stream);
+    }
+
+    if (cfg.soak && mgr_run_soak(&cfg.soak_opts, stream) != 0) {
+        status = EXIT_FAILURE;
+    }
+
+    if (cfg.numa && mgr_run_numa(&cfg.numa_opts, stream) != 0) {
+        status = EXIT_FAILURE;
+    }
+
+    if (cfg.frag && mgr_run_frag(&cfg.frag_opts, stream) != 0) {
+        status = EXIT_FAILURE;
+    }
+
+    if (cfg.align && mgr_run_align(&cfg.align_opts, stream) != 0) {
+        status = EXIT_FAILURE;
+    }
+
+    if (cfg.threads > 0) {
+        mgr_run_threaded_tests(stream);
+    }
+
+    if (cfg.compare && mgr_run_comparison(cfg.compare, stream) != 0) {
+        status = EXIT_FAILURE;
+    }
+
+done:
+    if (mgr_report_close(&results) != 0) {
+        fprintf(stderr, "memgrind: results incomplete\n");
+        status = EXIT_FAILURE;
+    }
+
+    if (heap_dump && fclose(heap_dump) != 0) {
+        fprintf(stderr, "memgrind: %s: heap dump incomplete\n", cfg.heap_dump);
+        status = EXIT_FAILURE;
+    }
+
+    mgr_backend_release();
+    mgr_oplat_delete(oplat_recorder);
+    mgr_config_deinit(&cfg);
+
+    if (perf_enabled) {
+        mgr_perf_close(&perf_counters);
+    }
+
+    if (traversal_perf_enabled) {
+        mgr_perf_close(&traversal_counters);
+    }
 
     fprintf(stream, "\n");
-    return EXIT_SUCCESS;
+    return status;
 }
 
 /*!
-    \brief  function that conducts the stress test addressed by the
-            callback function pointer test, and output results to dest
-  
+    \brief  Times the workload addressed by test
+
+    \details    The test is first run cfg.warmup times untimed,
+                then cfg.reps times, each timed individually
+                on the monotonic clock and kept as one sample.
+
+                In tape mode, warmup also counts the random values one
+                repetition draws; a tape that size (plus slack) is
+                refilled before each timed repetition.
+
+                If op latency mode is enabled, every allocator call made
+                during the timed repetitions is also timed into
+                oplat_recorder. If hardware counters are open, they
+                count the timed repetitions only, into perf_totals.
+
+                With --memory, page faults of the timed repetitions are
+                counted, and the test is run once more, untimed, through
+                the footprint accounting backend (see mgr_footprint.h).
+
     \param[in]  test    pointer-to-function that represents a test case
-    \param[in]  tch     character that will print to dest, represents test case
     \param[in]  min     a nonnegative minimum value (differs between test cases)
     \param[in]  max     a nonnegative maximum value (differs between test cases)
     \param[in]  interval nonnegative interval value (differs between test cases)
-    \param[in]  dest    destination file stream
+    \param[out] out     summary of the timed repetitions (ns)
+    \param[out] raw     if not NULL, the timed repetitions in run order (ns)
  */
-void mgr_run_test( memgrind_func_t test,
-                   char tch,
-                   uint32_t min,
-                   uint32_t max,
-                   uint32_t interval,
-                   FILE *dest) {
-    struct timespec x = { 0.0, 0.0 };       // start time (secs, nsecs)
-    struct timespec y = { 0.0, 0.0 };       // end time (secs, nsecs)
-
-    double total_ns = 0.0;
-    double elapsed_ns_avg = 0.0;
-    double time_slowest = 0.0;
-    double time_this = 0.0;
-
-    for (uint32_t i = 0; i < 1; ++i) {
-        clock_gettime(CLOCK_REALTIME, &x);  // start clock
+void mgr_measure(memgrind_func_t test,
+                 uint32_t min,
+                 uint32_t max,
+                 uint32_t interval,
+                 mgr_summary *out,
+                 mgr_samples *raw) {
+    mgr_samples samples;
+
+    uint64_t draws = 0;
+
+    if (cfg.calibrate && calibrating == false) {
+        const mgr_backend *backend = mgr_backend_current;
+        uint64_t state[4];
+
+        // the measured run draws what it would have without --calibrate
+        memcpy(state, mgr_rand_tls.s, sizeof state);
+
+        calibrating = true;
+        mgr_backend_current = &mgr_backend_null;
+        mgr_measure(test, min, max, interval, &harness, NULL);
+        mgr_backend_null.teardown_fn();
+        mgr_backend_current = backend;
+        calibrating = false;
+
+        memcpy(mgr_rand_tls.s, state, sizeof state);
+    }
+
+    mgr_samples_init(&samples, cfg.reps);
+
+    for (uint32_t i = 0; i < cfg.warmup; ++i) {
+        mgr_rand_tls.draws = 0;
+        test(min, max, interval);           // run test, untimed
+        draws = mgr_rand_tls.draws > draws ? mgr_rand_tls.draws : draws;
+    }
+
+    if (mgr_rand_tape_enabled && cfg.warmup == 0) {
+        mgr_rand_tls.draws = 0;
+        test(min, max, interval);           // size the tape, untimed
+        draws = mgr_rand_tls.draws;
+    }
+
+    const bool tape = mgr_rand_tape_enabled && mgr_rand_tape_reserve(mgr_rand_tape_length(draws)) == 0;
+
+    if (oplat_recorder) {
+        mgr_oplat_reset(oplat_recorder);
+        mgr_oplat_active = oplat_recorder;
+    }
+
+    if (perf_enabled) {
+        mgr_perf_reset(&perf_counters);
+    }
+
+    if (traversal_perf_enabled) {
+        mgr_perf_reset(&traversal_counters);
+        mgr_traversal_perf = &traversal_counters;
+    }
+
+    const mgr_traversal traversal = mgr_traversal_tls;
+    const uint64_t ops = mgr_op_count;
+    const uint64_t reallocs = mgr_realloc_count;
+    const uint64_t in_place = mgr_realloc_in_place;
+
+    mgr_cache_stats_read(&cache_before);
+
+    uint64_t minflt = 0;
+    uint64_t majflt = 0;
+
+    if (cfg.memory && calibrating == false) {
+        mgr_page_faults(&minflt, &majflt);
+    }
+
+    for (uint32_t i = 0; i < cfg.reps; ++i) {
+        if (tape) {
+            mgr_rand_tape_fill();           // generate randomness, untimed
+        }
+
+        if (perf_enabled) {
+            mgr_perf_start(&perf_counters);
+        }
+
+        const uint64_t x = mgr_clock_ns();  // start clock
         test(min, max, interval);           // run test
-        clock_gettime(CLOCK_REALTIME, &y);  // stop clock
-        
-        time_this = elapsed_time_ns(&x, &y);
-        time_slowest = time_this > time_slowest ? time_this : time_slowest;
+        const uint64_t y = mgr_clock_ns();  // stop clock
 
-        total_ns += time_this;
+        if (perf_enabled) {
+            mgr_perf_stop(&perf_counters);
+        }
+
+        mgr_samples_push(&samples, (double)(y - x));
     }
 
-    elapsed_ns_avg = total_ns / MGR_MAX_ITER;
+    measured_ops = mgr_op_count - ops;
+    measured_reallocs = mgr_realloc_count - reallocs;
+    measured_in_place = mgr_realloc_in_place - in_place;
+    measured_traversal.ns = mgr_traversal_tls.ns - traversal.ns;
+    measured_traversal.nodes = mgr_traversal_tls.nodes - traversal.nodes;
+    measured_cache = mgr_cache_stats_read(&cache_after);
 
+    if (perf_enabled && mgr_perf_read(&perf_counters, &perf_totals) != 0) {
+        memset(&perf_totals, 0, sizeof perf_totals);
+    }
+
+    if (traversal_perf_enabled && mgr_perf_read(&traversal_counters, &traversal_totals) != 0) {
+        memset(&traversal_totals, 0, sizeof traversal_totals);
+    }
+
+    mgr_traversal_perf = NULL;
+
+    mgr_oplat_active = NULL;
+    mgr_rand_tape_release();
+
+    if (cfg.memory && calibrating == false) {
+        uint64_t minflt_end = 0;
+        uint64_t majflt_end = 0;
+        const double nreps = cfg.reps > 0 ? (double)(cfg.reps) : 1.0;
+
+        mgr_page_faults(&minflt_end, &majflt_end);
+        footprint.minor_faults_per_rep = (double)(minflt_end - minflt) / nreps;
+        footprint.major_faults_per_rep = (double)(majflt_end - majflt) / nreps;
+
+        mgr_footprint_begin();
+        test(min, max, interval);           // account, untimed
+        mgr_footprint_end(&footprint);
+    }
+
+    if (raw) {
+        mgr_samples_clear(raw);
+
+        for (size_t i = 0; i < samples.size; ++i) {
+            mgr_samples_push(raw, samples.data[i]);
+        }
+    }
+
+    mgr_summarize(&samples, out);
+    mgr_samples_deinit(&samples);
+}
+
+/*!
+    \brief  Outputs one row of the results table
+
+    \param[in]  label   row label (a test letter, or a sweep value)
+    \param[in]  summary summary of the timed repetitions (ns)
+    \param[in]  dest    destination file stream
+ */
+static void mgr_print_row(const char *label, const mgr_summary *summary, FILE *dest) {
     fprintf(dest,
-            "%s%c%s\t\t%.5lf %s%s%s\t%.5lf %s%s%s\t%.5lf %s%s%s\t\t\n",
+            "%s%s%s\t%.5lf\t%.5lf\t\t%.5lf\t\t%.5lf\t\t%.5lf\t\t%.5lf\t\t%.5lf\t\t%.5lf\n",
             KGRN_b,
-            tch,
-            KNRM,
-            convert_ns_to_mcs(elapsed_ns_avg),
-            KGRY,
-            MCS,
+            label,
             KNRM,
-            convert_ns_to_mcs(time_slowest),
-            KGRY,
-            MCS,
-            KNRM,
-            convert_ns_to_mcs(total_ns),
-            KGRY,
-            MCS,
-            KNRM);
+            convert_ns_to_mcs(summary->mean),
+            convert_ns_to_mcs(summary->ci95),
+            convert_ns_to_mcs(summary->min),
+            convert_ns_to_mcs(summary->median),
+            convert_ns_to_mcs(summary->p90),
+            convert_ns_to_mcs(summary->p99),
+            convert_ns_to_mcs(summary->max),
+            convert_ns_to_mcs(summary->stddev));
+
+    if (measured_reallocs > 0) {
+        fprintf(dest, "  %-18s\t%12.1lf\t%9.1lf%%\n", "realloc (per rep)",
+                (double)(measured_reallocs) / (double)(summary->count),
+                100.0 * (double)(measured_in_place) / (double)(measured_reallocs));
+    }
+
+    if (measured_traversal.nodes > 0) {
+        fprintf(dest, "  %-18s\t%12.5lf\t%9.2lf ns/node\n", "traversal (per rep)",
+                convert_ns_to_mcs((double)(measured_traversal.ns) / (double)(summary->count)),
+                (double)(measured_traversal.ns) / (double)(measured_traversal.nodes));
+    }
+
+    if (measured_cache) {
+        mgr_cache_stats_fprint(dest, &cache_before, &cache_after);
+    }
+
+    if (cfg.calibrate) {
+        const double allocator = summary->mean > harness.mean ? summary->mean - harness.mean : 0.0;
+        const double share = summary->mean > 0.0 ? 100.0 * allocator / summary->mean : 0.0;
+
+        fprintf(dest, "  %-18s\t%12.5lf\t%9.1lf%%\n", "harness (null)",
+                convert_ns_to_mcs(harness.mean), 100.0 - share);
+        fprintf(dest, "  %-18s\t%12.5lf\t%9.1lf%%\n", "allocator",
+                convert_ns_to_mcs(allocator), share);
+    }
+
+    if (oplat_recorder) {
+        mgr_oplat_fprint(dest, oplat_recorder);
+    }
+
+    if (perf_enabled) {
+        mgr_perf_fprint(dest, "perf counter", &perf_totals, summary->count, measured_ops, "op");
+    }
+
+    if (traversal_perf_enabled && measured_traversal.nodes > 0) {
+        mgr_perf_fprint(dest, "traversal counter", &traversal_totals, summary->count,
+                        measured_traversal.nodes, "node");
+    }
+
+    if (cfg.memory) {
+        mgr_footprint_fprint(dest, &footprint);
+    }
+
+    if (cfg.heap && heap_walked) {
+        mgr_heap_fprint(dest, &heap_summary);
+    } else if (cfg.heap) {
+        fprintf(dest, "  %-18s\t%s %s\n", "heap", mgr_backend_current->name,
+                mgr_backend_current->walk_fn ? "walk failed" : "has no heap walk");
+    }
+}
+
+/*!
+    \brief  function that conducts the stress test addressed by the
+            callback function pointer test, and output results to dest
+
+    \details    See mgr_measure. The report shows order statistics of
+                the samples, their standard deviation, and the
+                half-width of the 95% confidence interval of the mean.
+
+                If op latency mode is enabled, the tail percentiles of
+                individual allocator calls are printed below the row;
+                if hardware counters are open, so are the counts per
+                repetition and per allocator call; with --memory,
+                the test's footprint; with --heap, the shape of the
+                heap the test left behind.
+  
+                The result is also written to the JSON/CSV report,
+                if one is open.
+
+    \param[in]  t       test, with the parameters to run it with
+    \param[in]  section part of the run, for the JSON/CSV report
+    \param[in]  label   row label; NULL for the test's letter
+    \param[in]  dest    destination file stream
+ */
+void mgr_run_test(const mgr_test *t, const char *section, const char *label, FILE *dest) {
+    const char tch[2] = { t->tch, '\0' };
+    mgr_summary summary;
+    mgr_samples samples;
+
+    mgr_samples_init(&samples, cfg.reps);
+    mgr_measure(t->test, t->min, t->max, t->interval, &summary, &samples);
+
+    if (cfg.heap) {
+        heap_walked = mgr_heap_snapshot(heap_dump, label ? label : tch, &heap_summary) == 0;
+    }
+
+    mgr_print_row(label ? label : tch, &summary, dest);
+
+    const mgr_result res = {
+        section, label ? label : tch, t,
+        summary, &samples, measured_ops, measured_reallocs, measured_in_place,
+        oplat_recorder, perf_enabled ? &perf_totals : NULL,
+        cfg.memory ? &footprint : NULL,
+        cfg.calibrate ? &harness : NULL,
+        measured_traversal.nodes > 0 ? &measured_traversal : NULL,
+        traversal_perf_enabled && measured_traversal.nodes > 0 ? &traversal_totals : NULL,
+        cfg.heap && heap_walked ? &heap_summary : NULL
+    };
+
+    mgr_report_result(&results, &res);
+
+    mgr_samples_deinit(&samples);
+}
+
+/*!
+    \brief  Reruns one test over a range of values of one parameter,
+            one row per value
+
+    \details    Rows are labelled with the key and value, e.g. "d.max=64".
+                The other parameters keep their configured values.
+
+    \param[in]  sw      parameter sweep
+    \param[in]  dest    destination file stream
+ */
+void mgr_run_sweep(const mgr_sweep *sw, FILE *dest) {
+    mgr_test test = *mgr_test_find(mgr_tests, sw->tch);
+    uint32_t *param = mgr_test_param(&test, sw->param);
+
+    fprintf(dest, "\n%s %c.%s\n\n", KGRN_b"sweep of"KNRM, test.tch, test.params[sw->param]);
+
+    for (uint64_t value = sw->first; value <= sw->last;
+         value = sw->geometric ? value * sw->step : value + sw->step) {
+        char label[64];
+
+        *param = (uint32_t)(value);
+        snprintf(label, sizeof label, "%c.%s=%u", test.tch, test.params[sw->param], *param);
+
+        mgr_run_test(&test, "sweep", label, dest);
+    }
+}
+
+/*!
+    \brief  Runs every loaded workload script (see mgr_script.h),
+            one row each, labelled with its name; then, on its own
+            threads, every workload that names a thread count
+
+    \param[in]  dest    destination file stream
+ */
+void mgr_run_scripts(FILE *dest) {
+    const uint32_t count = mgr_script_count();
+
+    fprintf(dest, "\n%s %s\n\n", KGRN_b"workloads of"KNRM, cfg.workload);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const mgr_test test = { mgr_script_run, 'w', i, 0, 0, { NULL, NULL, NULL }, true };
+        mgr_run_test(&test, "workload", mgr_script_get(i)->name, dest);
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const mgr_script_program *p = mgr_script_get(i);
+        mgr_thread_report report;
+
+        if (p->threads == 0) {
+            continue;
+        }
+
+        fprintf(dest, "\n%s %s (%u %s)\n\n", KGRN_b"workload"KNRM, p->name,
+                      p->threads, p->threads == 1 ? "thread" : "threads");
+
+        if (mgr_run_threaded(mgr_script_run, i, 0, 0, p->threads, cfg.warmup, cfg.reps,
+                             oplat_recorder, &report) != 0) {
+            fprintf(dest, "%sthread creation failed%s\n", KRED_b, KNRM);
+        } else {
+            mgr_thread_report_fprint(dest, &report);
+        }
+
+        mgr_thread_report_deinit(&report);
+    }
+}
+
+/*!
+    \brief  Runs test g over every cell of the size class matrix,
+            and outputs the matrix to dest
+
+    \details    Every cell is measured as by mgr_measure, and written to
+                the JSON/CSV report as "g.size=S,live=L". The cell's cost
+                per allocator call is the median repetition over the
+                calls one repetition makes (the live set is filled and
+                drained in every repetition, as well as churned).
+
+    \param[in]  dest    destination file stream
+ */
+void mgr_run_matrix(FILE *dest) {
+    const mgr_matrix *m = &cfg.matrix_grid;
+    mgr_test test = *mgr_test_find(mgr_tests, 'g');
+    double ns_per_op[MGR_MATRIX_MAX * MGR_MATRIX_MAX];
+
+    fprintf(dest, "\n%s (%u %s)\n",
+                  KGRN_b"size class matrix"KNRM, test.interval, "replacements per repetition");
+
+    for (uint32_t j = 0; j < m->nlives; ++j) {
+        for (uint32_t i = 0; i < m->nsizes; ++i) {
+            double *cell = &ns_per_op[(j * m->nsizes) + i];
+
+            if (mgr_matrix_fits(m->sizes[i], m->lives[j]) == false) {
+                *cell = -1.0;
+                continue;
+            }
+
+            char label[64];
+            mgr_summary summary;
+            mgr_samples samples;
+
+            test.min = m->sizes[i];
+            test.max = m->lives[j];
+            snprintf(label, sizeof label, "g.size=%u,live=%u", test.min, test.max);
+
+            mgr_samples_init(&samples, cfg.reps);
+            mgr_measure(test.test, test.min, test.max, test.interval, &summary, &samples);
+
+            const double calls = (double)(measured_ops) / (double)(cfg.reps);
+            *cell = calls > 0.0 ? summary.median / calls : 0.0;
+
+            const mgr_result res = {
+                "matrix", label, &test,
+                summary, &samples, measured_ops, measured_reallocs, measured_in_place,
+                oplat_recorder, perf_enabled ? &perf_totals : NULL,
+                cfg.memory ? &footprint : NULL,
+                cfg.calibrate ? &harness : NULL,
+                measured_traversal.nodes > 0 ? &measured_traversal : NULL,
+                traversal_perf_enabled && measured_traversal.nodes > 0 ? &traversal_totals : NULL,
+                NULL
+            };
+
+            mgr_report_result(&results, &res);
+            mgr_samples_deinit(&samples);
+        }
+    }
+
+    mgr_matrix_fprint(dest, m, ns_per_op);
+}
+
+/*!
+    \brief  Runs tests a through f at increasing thread counts,
+            then the producer/consumer cross-thread free pattern,
+            and outputs results to dest
+
+    \param[in]  dest    destination file stream
+ */
+void mgr_run_threaded_tests(FILE *dest) {
+    const uint32_t max_threads = cfg.threads;
+
+    fprintf(dest, "\n%s %u %s\n\n"
+                  "%s\n"
+                  "%s\t%s\t%s\t\t%s\t\t%s\n"
+                  "%s\n",
+                  KGRN_b"threaded runs, 1 to"KNRM, max_threads, KGRN_b"threads"KNRM,
+                  "-------------------------------------------------------------",
+                  KWHT_b"test"KNRM, KWHT_b"threads"KNRM, KWHT_b"ops/s"KNRM,
+                  KWHT_b"mean"KNRM, KWHT_b"worst p99"KNRM,
+                  "-------------------------------------------------------------");
+
+    for (const mgr_test *t = mgr_tests; t->test; ++t) {
+        if (t->enabled) {
+            mgr_cache_stats_read(&cache_before);
+
+            mgr_run_scaling(t->test, t->tch, t->min, t->max, t->interval,
+                            max_threads, cfg.warmup, cfg.reps, dest);
+
+            // workers have exited: their counters are in the totals
+            if (mgr_cache_stats_read(&cache_after)) {
+                mgr_cache_stats_fprint(dest, &cache_before, &cache_after);
+            }
+        }
+    }
+
+    mgr_thread_report report;
+
+    fprintf(dest, "\n%s (%u %s, %u %s)\n\n",
+                  KGRN_b"cross-thread free"KNRM,
+                  cfg.xfree_pairs, "producer/consumer pairs",
+                  cfg.xfree_count, "blocks per pair");
+
+    mgr_cache_stats_read(&cache_before);
+
+    mgr_run_xfree(cfg.xfree_pairs, cfg.xfree_count,
+                  cfg.xfree_min, cfg.xfree_max,
+                  oplat_recorder, &report);
+    mgr_thread_report_fprint(dest, &report);
+
+    if (mgr_cache_stats_read(&cache_after)) {
+        mgr_cache_stats_fprint(dest, &cache_before, &cache_after);
+    }
+
+    mgr_thread_report_deinit(&report);
+
+    if (cfg.remote_producers == 0 || cfg.remote_consumers == 0) {
+        return;
+    }
+
+    mgr_hist *handoff = malloc(sizeof *handoff);
+
+    if (handoff == NULL) {
+        return;
+    }
+
+    fprintf(dest, "\n%s (%u %s to %u %s, %u %s)\n\n",
+                  KGRN_b"remote free"KNRM,
+                  cfg.remote_producers, cfg.remote_producers == 1 ? "producer" : "producers",
+                  cfg.remote_consumers, cfg.remote_consumers == 1 ? "consumer" : "consumers",
+                  cfg.remote_count, "blocks per producer");
+
+    mgr_cache_stats_read(&cache_before);
+
+    if (mgr_run_remote(cfg.remote_producers, cfg.remote_consumers, cfg.remote_count,
+                       cfg.xfree_min, cfg.xfree_max,
+                       oplat_recorder, handoff, &report) != 0) {
+        fprintf(dest, "%sthread creation failed%s\n", KRED_b, KNRM);
+    }
+
+    mgr_thread_report_fprint(dest, &report);
+    mgr_hist_fprint(dest, "push to free", handoff);
+
+    if (mgr_cache_stats_read(&cache_after)) {
+        mgr_cache_stats_fprint(dest, &cache_before, &cache_after);
+    }
+
+    mgr_thread_report_deinit(&report);
+    free(handoff);
+}
+
+/*!
+    \brief  Runs every test against each backend in specs and outputs
+            the mean time per test and throughput relative to the
+            first backend
+
+    \details    The current backend is torn down; the caller reselects it.
+                Every run goes to the JSON/CSV report, in section
+                "compare", labelled with its backend and test ("system/d").
+
+    \param[in]  specs   comma-separated backend specifications
+                        (see mgr_backend_select), e.g. "cgcs,system"
+    \param[in]  dest    destination file stream
+
+    \return     0 on success, -1 if a backend could not be selected
+ */
+int mgr_run_comparison(const char *specs, FILE *dest) {
+    enum { MGR_COMPARE_MAX = 8, MGR_TESTS_MAX = sizeof mgr_tests / sizeof *mgr_tests };
+
+    char buffer[4096];
+    char *names[MGR_COMPARE_MAX];
+    char labels[MGR_COMPARE_MAX][64];
+    double means[MGR_COMPARE_MAX][MGR_TESTS_MAX];
+    size_t nbackends = 0;
+
+    snprintf(buffer, sizeof buffer, "%s", specs);
+
+    for (char *tok = strtok(buffer, ","); tok && nbackends < MGR_COMPARE_MAX; tok = strtok(NULL, ",")) {
+        names[nbackends++] = tok;
+    }
+
+    for (size_t i = 0; i < nbackends; ++i) {
+        if (mgr_backend_select(names[i]) != 0) {
+            fprintf(stderr, "memgrind: cannot select backend '%s'\n", names[i]);
+            return -1;
+        }
+
+        size_t j = 0;
+
+        for (const mgr_test *t = mgr_tests; t->test; ++t, ++j) {
+            if (t->enabled == false) {
+                continue;
+            }
+
+            char label[96];
+            mgr_summary summary;
+            mgr_samples samples;
+
+            mgr_samples_init(&samples, cfg.reps);
+            mgr_measure(t->test, t->min, t->max, t->interval, &summary, &samples);
+            means[i][j] = summary.mean;
+
+            // e.g. "system/d", so that --diff tells the backends apart
+            snprintf(label, sizeof label, "%s/%c", mgr_backend_current->name, t->tch);
+
+            const mgr_result res = {
+                "compare", label, t,
+                summary, &samples, measured_ops, measured_reallocs, measured_in_place,
+                oplat_recorder, perf_enabled ? &perf_totals : NULL,
+                cfg.memory ? &footprint : NULL,
+                cfg.calibrate ? &harness : NULL,
+                measured_traversal.nodes > 0 ? &measured_traversal : NULL,
+                traversal_perf_enabled && measured_traversal.nodes > 0 ? &traversal_totals : NULL,
+                NULL
+            };
+
+            mgr_report_result(&results, &res);
+            mgr_samples_deinit(&samples);
+        }
+
+        // a dl: backend's name does not outlive its selection
+        snprintf(labels[i], sizeof labels[i], "%s", mgr_backend_current->name);
+    }
+
+    mgr_backend_release();
+
+    fprintf(dest, "\n%s (%s %s, %s)\n\n",
+                  KGRN_b"backend comparison"KNRM,
+                  "mean", MCS, "throughput relative to the first backend");
+
+    fprintf(dest, "%s", KWHT_b"test"KNRM);
+
+    for (size_t i = 0; i < nbackends; ++i) {
+        fprintf(dest, "\t%s%-16s%s", KWHT_b, labels[i], KNRM);
+    }
+
+    fprintf(dest, "\n");
+
+    size_t j = 0;
+
+    for (const mgr_test *t = mgr_tests; t->test; ++t, ++j) {
+        if (t->enabled == false) {
+            continue;
+        }
+
+        fprintf(dest, "%s%c%s", KGRN_b, t->tch, KNRM);
+
+        for (size_t i = 0; i < nbackends; ++i) {
+            const double relative = means[i][j] > 0.0 ? means[0][j] / means[i][j] : 0.0;
+            fprintf(dest, "\t%.5lf %s%.2lfx%s", convert_ns_to_mcs(means[i][j]), KGRY, relative, KNRM);
+        }
+
+        fprintf(dest, "\n");
+    }
+
+    return 0;
 }
 
 /*!
@@ -273,11 +1215,11 @@ void mgr_simple_alloc_free(uint32_t max_iter, uint32_t alloc_sz, uint32_t unused
     listlog();
 
     for (uint32_t i = 0; i < max_iter; ++i) {
-        char *ch = cgcs_malloc(alloc_sz);
+        char *ch = mgr_malloc(alloc_sz);
         listlog();
 
         if (ch) { 
-            cgcs_free(ch);
+            mgr_free(ch);
             listlog();
         }
     }
@@ -299,13 +1241,13 @@ void mgr_alloc_array_interval(uint32_t max_iter, uint32_t alloc_sz, uint32_t int
 
     // ptr to buffer of ptrs to char buffer
     // alloc memory for buffer of pointers and establish sentinel
-    char **ch_ptrarr = cgcs_malloc(sizeof *ch_ptrarr * max_iter);
+    char **ch_ptrarr = mgr_malloc(sizeof *ch_ptrarr * max_iter);
     char **sentinel = ch_ptrarr + interval;
 
     uint32_t i = 0;             // runs from [0, max_iter)
     
     while (i < max_iter) {
-        char *ch = cgcs_malloc(alloc_sz);  // allocate memory for ptr to char buffer
+        char *ch = mgr_malloc(alloc_sz);  // allocate memory for ptr to char buffer
 
         if (ch) {
             ch_ptrarr[i++] = ch;
@@ -321,14 +1263,14 @@ void mgr_alloc_array_interval(uint32_t max_iter, uint32_t alloc_sz, uint32_t int
                 /*
                     Retrieve the (i - j)th address from ch_ptrarr.
                     We allocate alloc_sz bytes interval times,
-                    then do interval cgcs_free() calls for each 
+                    then do interval mgr_free() calls for each 
                     alloc_sz byte allocations.
                 */
                 char **curr = ch_ptrarr + (i - j);
 
                 if ((*curr)) {
                     // Free the pointer to char buffer.
-                    cgcs_free((*curr));
+                    mgr_free((*curr));
                 }
 
                 --j;
@@ -348,7 +1290,7 @@ void mgr_alloc_array_interval(uint32_t max_iter, uint32_t alloc_sz, uint32_t int
         and max_iter deallocations, we free the
         pointer to the buffer of pointers to char buffers.
     */
-    cgcs_free(ch_ptrarr);
+    mgr_free(ch_ptrarr);
 
     listlog();
 }
@@ -370,7 +1312,7 @@ void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t
 
     bool hit_max_allocs = false;
 
-    char **ch_ptrarr = cgcs_malloc(sizeof *ch_ptrarr * max_allocs);
+    char **ch_ptrarr = mgr_malloc(sizeof *ch_ptrarr * max_allocs);
     memset(ch_ptrarr, 0, max_allocs);
 
     uint32_t k = 0;
@@ -398,7 +1340,7 @@ void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t
             nonnull = (*curr) != NULL;
 
             if (nonnull) {
-                cgcs_free((*curr));
+                mgr_free((*curr));
                 (*curr) = NULL;
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
@@ -424,7 +1366,7 @@ void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t
                     nonnull = (*curr) != NULL;
 
                     if (nonnull) {
-                        cgcs_free((*curr));
+                        mgr_free((*curr));
                         (*curr) = NULL;
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
@@ -448,7 +1390,7 @@ void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t
                            alloc_sz_min :
                            randrnge(alloc_sz_min, alloc_sz_max);
 
-                ch = cgcs_malloc(size);
+                ch = mgr_malloc(size);
 
                 if (ch) {
                     *(ch_ptrarr + count.allocs) = ch;
@@ -464,7 +1406,7 @@ void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t
         ++k;
     }
 
-    cgcs_free(ch_ptrarr);
+    mgr_free(ch_ptrarr);
     ch_ptrarr = NULL;
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
@@ -500,10 +1442,34 @@ void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t
     \param[in]  unused_value unused value - needed for function uniformity
  */
 void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value) { 
-    char **ch_ptrarr = cgcs_malloc(sizeof *ch_ptrarr * max);
+    mgr_char_ptr_array_run(min, max, false);
+    (void)(unused_value);
+}
+
+/*!
+    \brief  Test m:
+            test e, released all at once
+
+    \details    As test e, but the final frees are replaced by a single
+                mgr_free_all, as a request-scoped allocator would drop
+                a request's memory. Backends without a region reset
+                (see mgr_backend.reset_fn), and threaded runs, which
+                share the region, free every block instead.
+
+    \param[in]  min     minimum byte value to allocate
+    \param[in]  max     max iterations/max byte value to allocate
+    \param[in]  unused_value unused value - needed for function uniformity
+ */
+void mgr_char_ptr_array_scoped(uint32_t min, uint32_t max, uint32_t unused_value) {
+    mgr_char_ptr_array_run(min, max, true);
+    (void)(unused_value);
+}
+
+static void mgr_char_ptr_array_run(uint32_t min, uint32_t max, bool scoped) {
+    char **ch_ptrarr = mgr_malloc(sizeof *ch_ptrarr * max);
 
     for (uint32_t i = 0; i < max; ++i) {
-        ch_ptrarr[i] = cgcs_malloc(randrnge(1, max + 1));
+        ch_ptrarr[i] = mgr_malloc(randrnge(1, max + 1));
     }
 
     for (uint32_t i = 0; i < max; ++i) {
@@ -511,12 +1477,14 @@ void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value) {
 
         if (to_erase) {
             if (ch_ptrarr[i]) {
-                cgcs_free(ch_ptrarr[i]);
+                mgr_free(ch_ptrarr[i]);
                 ch_ptrarr[i] = NULL;
             }
         }
     }
 
+    mgr_footprint_mark();                   // holes left by the frees
+
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
     listlog();
 #endif
@@ -524,7 +1492,7 @@ void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value) {
     for (uint32_t i = 0; i < max; ++i) {
         if (ch_ptrarr[i] == NULL) {
             int num = randrnge(min, max + 1);
-            ch_ptrarr[i] = cgcs_malloc(num);
+            ch_ptrarr[i] = mgr_malloc(num);
         }
     }
 
@@ -532,13 +1500,21 @@ void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value) {
     listlog();
 #endif
 
+    // ch_ptrarr comes from the same region, so it is released last
+    if (scoped && mgr_free_all()) {
+#ifdef CGCS_MALLOC_ENABLE_LOGGING
+        listlog();
+#endif
+        return;
+    }
+
     for (uint32_t i = 0; i < max; ++i) {
         if (ch_ptrarr[i]) {
-            cgcs_free(ch_ptrarr[i]);
+            mgr_free(ch_ptrarr[i]);
         }
     }
 
-    cgcs_free(ch_ptrarr);
+    mgr_free(ch_ptrarr);
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
     listlog();
@@ -581,22 +1557,48 @@ void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value) {
     \param[in]  initial initial starting size of vector's buffer
  */
 void mgr_vector(uint32_t min, uint32_t max, uint32_t initial) {
+    mgr_vector_run(min, max, initial, false);
+}
+
+/*!
+    \brief  Test n:
+            test f, released all at once
+
+    \details    As test f, but the strings, the vector's buffer and the
+                vector itself are released by a single mgr_free_all.
+                Backends without a region reset, and threaded runs,
+                free them one by one.
+
+    \param[in]  min     minimum char count for string
+    \param[in]  max     maximum char count for string, maximum strings added to vector
+    \param[in]  initial initial starting size of vector's buffer
+ */
+void mgr_vector_scoped(uint32_t min, uint32_t max, uint32_t initial) {
+    mgr_vector_run(min, max, initial, true);
+}
+
+static void mgr_vector_run(uint32_t min, uint32_t max, uint32_t initial, bool scoped) {
+    // Temporary storage for a randomized string
+    // (max is set at run time, and may not fit the stack; from libc,
+    // not the backend under test)
+    char *buffer = malloc((size_t)(min > max ? min : max) + 1);
+
+    if (buffer == NULL) {
+        return;
+    }
+
     ///
     /// Begin allocation/construction of cgcs_vector
     ///   
 
-    // Create an instance of cgcs_vector on the heap using cgcs_malloc,
-    // and initialize its buffer with cgcs_malloc
-    cgcs_vector *v = cgcs_vnew_allocfn(initial, cgcs_malloc);
+    // Create an instance of cgcs_vector on the heap using mgr_malloc,
+    // and initialize its buffer with mgr_malloc
+    cgcs_vector *v = cgcs_vnew_allocfn(initial, mgr_malloc);
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
     listlog();
 #endif
 
-    // Create a local array of char as temporary storage
-    // for a randomized string
-    char buffer[MGR_F_MAX];
-
     // for i = [0...max + 1), randomly generate a string of size [1, max],
     // store it in buffer, then duplicate buffer in a heap-allocated
     // instance, where ptr is that duplicate buffer's base address.
@@ -605,10 +1607,10 @@ void mgr_vector(uint32_t min, uint32_t max, uint32_t initial) {
         int length = randrnge(1, max);
         char *str = randstr(buffer, length);
 
-        char *ptr = cgcs_malloc(length + 1);
+        char *ptr = mgr_malloc(length + 1);
         strcpy(ptr, str);
 
-        cgcs_vpushb_allocfreefn(v, &ptr, cgcs_malloc, cgcs_free);
+        cgcs_vpushb_allocfreefn(v, &ptr, mgr_malloc, mgr_free);
     }
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
@@ -625,7 +1627,7 @@ void mgr_vector(uint32_t min, uint32_t max, uint32_t initial) {
        if (randbool()) {
            // First, we must retrieve the (char *) in question
            // so we can release the memory at its address.
-           cgcs_free(*it);
+           mgr_free(*it);
 
            // Then, we can "erase the slot" where that (char *)
            // once resided.
@@ -637,6 +1639,8 @@ void mgr_vector(uint32_t min, uint32_t max, uint32_t initial) {
        }
    }
 
+   mgr_footprint_mark();                    // holes left by the frees
+
    // Add more randomized strings to v.
    // This time, each randomized string length can range from [min, max].
    size_t size = cgcs_vsize(v);
@@ -645,30 +1649,232 @@ void mgr_vector(uint32_t min, uint32_t max, uint32_t initial) {
        int length = randrnge(min, max);
        char *str = randstr(buffer, length);
 
-       char *ptr = cgcs_malloc(length + 1);
+       char *ptr = mgr_malloc(length + 1);
        strcpy(ptr, str);
 
-       cgcs_vpushb_allocfreefn(v, &ptr, cgcs_malloc, cgcs_free);
+       cgcs_vpushb_allocfreefn(v, &ptr, mgr_malloc, mgr_free);
    }
 
+   free(buffer);
+
    ///
    /// Begin destruction/delete of cgcs_vector.
    ///
+
+   if (scoped && mgr_free_all()) {
+#ifdef CGCS_MALLOC_ENABLE_LOGGING
+       listlog();
+#endif
+       return;
+   }
    
    // Iterate from back to front, free each (char *) in v's buffer.
    for (it = cgcs_vend(v) - 1; it >= cgcs_vbegin(v); it--) {
-       cgcs_free(*it);
+       mgr_free(*it);
    }
 
    // Destroy the heap-allocated instance of cgcs_vector's buffer,
    // then free the cgcs_vector instance itself
-   cgcs_vdelete_freefn(v, cgcs_free);
+   cgcs_vdelete_freefn(v, mgr_free);
 
 #ifdef CGCS_MALLOC_ENABLE_LOGGING
     listlog();
 #endif
 }
 
+/*
+    Minimal vector of strings for tests h and l: unlike cgcs_vector,
+    its buffer grows through mgr_realloc, and it can reserve capacity
+    and append many elements at once.
+ */
+typedef struct mgr_strvec {
+    void **start;
+    size_t size;
+    size_t capacity;
+} mgr_strvec;
+
+static mgr_strvec *mgr_strvec_new(size_t capacity) {
+    mgr_strvec *v = mgr_malloc(sizeof *v);
+
+    v->capacity = capacity > 0 ? capacity : 1;
+    v->size = 0;
+    v->start = mgr_malloc(sizeof *v->start * v->capacity);
+
+    return v;
+}
+
+static void mgr_strvec_reserve(mgr_strvec *v, size_t capacity) {
+    if (capacity > v->capacity) {
+        v->start = mgr_realloc(v->start, sizeof *v->start * v->capacity, sizeof *v->start * capacity);
+        v->capacity = capacity;
+    }
+}
+
+static void mgr_strvec_push(mgr_strvec *v, void *str) {
+    if (v->size == v->capacity) {
+        mgr_strvec_reserve(v, v->capacity * 2);
+    }
+
+    v->start[v->size++] = str;
+}
+
+// reserves once, then appends every element
+static void mgr_strvec_push_bulk(mgr_strvec *v, void *const *strs, size_t count) {
+    mgr_strvec_reserve(v, v->size + count);
+    memcpy(v->start + v->size, strs, sizeof *strs * count);
+    v->size += count;
+}
+
+static void mgr_strvec_erase(mgr_strvec *v, size_t i) {
+    memmove(v->start + i, v->start + i + 1, sizeof *v->start * (v->size - i - 1));
+    --v->size;
+}
+
+// frees the vector, not the strings
+static void mgr_strvec_delete(mgr_strvec *v) {
+    mgr_free(v->start);
+    mgr_free(v);
+}
+
+/*!
+    \brief  test h:
+            test f, with the vector's buffer grown by realloc
+
+    \details    Same steps and random draws as test f, but the vector's
+                buffer doubles through mgr_realloc, where cgcs_vector
+                allocates a new buffer, copies and frees the old one.
+                Running f and h side by side compares the two growth
+                strategies; how many of the reallocs kept the buffer in
+                place is shown under the row.
+
+    \param[in]  min     minimum char count for string
+    \param[in]  max     maximum char count for string, maximum strings added to vector
+    \param[in]  initial initial starting size of vector's buffer
+ */
+void mgr_vector_realloc(uint32_t min, uint32_t max, uint32_t initial) {
+    char *buffer = malloc((size_t)(min > max ? min : max) + 1);
+
+    if (buffer == NULL) {
+        return;
+    }
+
+    mgr_strvec *v = mgr_strvec_new(initial);
+
+    // push the first max strings, of sizes [1, max)
+    for (uint32_t i = 0; i < max; ++i) {
+        int length = randrnge(1, max);
+        char *str = randstr(buffer, length);
+
+        char *ptr = mgr_malloc(length + 1);
+        strcpy(ptr, str);
+
+        mgr_strvec_push(v, ptr);
+    }
+
+    // erase each string at random
+    size_t i = 0;
+
+    while (i < v->size) {
+        if (randbool()) {
+            mgr_free(v->start[i]);
+            mgr_strvec_erase(v, i);
+        } else {
+            ++i;
+        }
+    }
+
+    mgr_footprint_mark();                   // holes left by the frees
+
+    // push as many strings again, of sizes [min, max)
+    const size_t size = v->size;
+
+    for (size_t k = 0; k < size; ++k) {
+        int length = randrnge(min, max);
+        char *str = randstr(buffer, length);
+
+        char *ptr = mgr_malloc(length + 1);
+        strcpy(ptr, str);
+
+        mgr_strvec_push(v, ptr);
+    }
+
+    free(buffer);
+
+    for (size_t k = v->size; k-- > 0;) {
+        mgr_free(v->start[k]);
+    }
+
+    mgr_strvec_delete(v);
+}
+
+/*!
+    \brief  test l:
+            test f, in bursts: strings are allocated and freed in
+            batches, and pushed to the vector in bulk
+
+    \details    Every string gets a slot of max + 1 bytes, so that a
+                burst is one mgr_malloc_batch call. The first max
+                strings are allocated in one batch and appended with
+                one reservation; the strings erased at random are freed
+                in one batch; as many strings as were kept are then
+                allocated and appended the same way; finally every
+                string is freed in one batch.
+
+    \param[in]  min     minimum char count for string
+    \param[in]  max     maximum char count for string, maximum strings added to vector
+    \param[in]  initial initial starting size of vector's buffer
+ */
+void mgr_vector_bulk(uint32_t min, uint32_t max, uint32_t initial) {
+    const size_t slot = (size_t)(min > max ? min : max) + 1;
+    char *buffer = malloc(slot);
+
+    if (buffer == NULL) {
+        return;
+    }
+
+    mgr_strvec *v = mgr_strvec_new(initial);
+    void **burst = mgr_malloc(sizeof *burst * (max > 0 ? max : 1));
+
+    // allocate and push the first max strings, of sizes [1, max)
+    size_t n = mgr_malloc_batch(slot, burst, max);
+
+    for (size_t k = 0; k < n; ++k) {
+        strcpy(burst[k], randstr(buffer, randrnge(1, max)));
+    }
+
+    mgr_strvec_push_bulk(v, burst, n);
+
+    // erase each string at random, and free the erased ones together
+    size_t erased = 0;
+    size_t i = 0;
+
+    while (i < v->size) {
+        if (randbool()) {
+            burst[erased++] = v->start[i];
+            mgr_strvec_erase(v, i);
+        } else {
+            ++i;
+        }
+    }
+
+    mgr_free_batch(burst, erased);
+    mgr_footprint_mark();                   // holes left by the frees
+
+    // allocate and push as many strings again, of sizes [min, max)
+    n = mgr_malloc_batch(slot, burst, v->size);
+
+    for (size_t k = 0; k < n; ++k) {
+        strcpy(burst[k], randstr(buffer, randrnge(min, max)));
+    }
+
+    mgr_strvec_push_bulk(v, burst, n);
+    free(buffer);
+
+    mgr_free_batch(v->start, v->size);
+    mgr_free(burst);
+    mgr_strvec_delete(v);
+}
+
 /*!
     \brief      Randomly generate a string of size length
  
@@ -693,7 +1899,7 @@ char *randstr(char *buffer, size_t length) {
     }
 
     for (n = 0; n < length; n++) {
-        key = rand() % string_length;
+        key = mgr_rand_below((uint32_t)(string_length));
         random_string[n] = charset[key];
     }
 
@@ -16,6 +16,8 @@
 #include <string.h>
 #include <time.h>
 
+#include "mgr_rand.h"
+
 // Unit conversion functions from ns (s/ms/mcs)
 double convert_ns_to_s(double nanoseconds);
 double convert_ns_to_ms(double nanoseconds);
@@ -138,7 +140,7 @@ inline double elapsed_time_s(struct timespec *before,
     \return
  */
 inline int randrnge(int minimum, int maximum) {
-    return (rand() % (maximum - minimum)) + minimum;
+    return (int)(mgr_rand_range((uint32_t)(minimum), (uint32_t)(maximum)));
 }
 
 /*!
@@ -147,7 +149,7 @@ inline int randrnge(int minimum, int maximum) {
     \return
  */
 inline bool randbool() {
-    return (rand() % ((true + 1) - false)) + false;
+    return mgr_rand_bool();
 }
 
 inline int cstr_compare(const void *c0, const void *c1) {
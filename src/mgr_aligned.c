@@ -0,0 +1,343 @@
+/*!
+    \file       mgr_aligned.c
+    \brief      Source file for the memgrind_c aligned allocation workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_aligned.h"
+#include "mgr_alloc.h"
+#include "mgr_rand.h"
+#include "mgr_stats.h"
+#include "mgr_workload.h"
+
+#include "cgcs_ulog.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// largest alignment asked of an allocator
+#define MGR_ALIGN_LIMIT ((uint32_t)(1) << 30)
+
+static const uint32_t mgr_align_default_alignments[] = { 16, 64, 4096, 2097152 };
+static const uint32_t mgr_align_default_sizes[] = { 64, 1000, 4096, 65536, 1048576 };
+
+// set once a misaligned block has been reported
+static atomic_bool mgr_align_warned = false;
+
+// alignment rounded up to a power of two, no less than sizeof(void *)
+static size_t mgr_align_fit(uint32_t alignment) {
+    size_t a = sizeof(void *);
+
+    while (a < alignment && a < MGR_ALIGN_LIMIT) {
+        a <<= 1;
+    }
+
+    return a;
+}
+
+static void mgr_align_check(const void *ptr, size_t alignment) {
+    if (((uintptr_t)(ptr) & (alignment - 1)) != 0 && atomic_exchange(&mgr_align_warned, true) == false) {
+        fprintf(stderr, "memgrind: %s returned %p for alignment %zu\n",
+                mgr_backend_current->name, ptr, alignment);
+    }
+}
+
+/*!
+    \brief  Test r:
+            test d with aligned blocks
+
+    \details    As mgr_alloc_array_range: until max_allocs blocks have
+                been allocated, either allocate one, of 1 to
+                alloc_sz_max bytes, or free the most recent one; then
+                free the rest, last first. Every block comes from
+                mgr_aligned_alloc, and is checked; the first misaligned
+                block is reported on stderr.
+
+    \param[in]  max_allocs      max allocations for test
+    \param[in]  alignment       block alignment, rounded up to a power
+                                of two no less than sizeof(void *)
+    \param[in]  alloc_sz_max    maximum block size
+ */
+void mgr_aligned_array_range(uint32_t max_allocs, uint32_t alignment, uint32_t alloc_sz_max) {
+    const size_t align = mgr_align_fit(alignment);
+    char **blocks = mgr_malloc(sizeof *blocks * (max_allocs > 0 ? max_allocs : 1));
+    uint32_t allocs = 0;
+
+    if (blocks == NULL) {
+        return;
+    }
+
+    while (allocs < max_allocs) {
+        if (mgr_rand_bool()) {
+            if (allocs > 0 && blocks[allocs - 1]) {
+                mgr_aligned_free(blocks[allocs - 1]);
+                blocks[allocs - 1] = NULL;
+            }
+        } else {
+            const uint32_t size = mgr_rand_between(1, alloc_sz_max);
+            char *ptr = mgr_aligned_alloc(align, size);
+
+            if (ptr == NULL) {
+                break;
+            }
+
+            mgr_align_check(ptr, align);
+            ptr[0] = (char)(size);
+
+            blocks[allocs++] = ptr;
+        }
+    }
+
+    while (allocs > 0) {
+        if (blocks[--allocs]) {
+            mgr_aligned_free(blocks[allocs]);
+        }
+    }
+
+    mgr_free(blocks);
+}
+
+/*!
+    \brief  Sets the default grid: alignments of 16 and 64 bytes
+            (SIMD), 4 KiB (pages) and 2 MiB (huge pages), and sizes from
+            64 bytes to 1 MiB, 1024 blocks each
+
+    \param[out] opts    grid
+ */
+void mgr_align_defaults(mgr_align_opts *opts) {
+    opts->nalignments = sizeof mgr_align_default_alignments / sizeof *mgr_align_default_alignments;
+    opts->nsizes = sizeof mgr_align_default_sizes / sizeof *mgr_align_default_sizes;
+    opts->count = 1024;
+
+    memcpy(opts->alignments, mgr_align_default_alignments, sizeof mgr_align_default_alignments);
+    memcpy(opts->sizes, mgr_align_default_sizes, sizeof mgr_align_default_sizes);
+}
+
+/*!
+    \brief  Parses a list of alignments, as mgr_matrix_parse_axis
+
+    \param[in]  key     option key, for error messages
+    \param[in]  value   list, e.g. "64,4K,2M"
+    \param[out] opts    grid whose alignments are set
+
+    \return     0 on success, -1 if the list is invalid or not every
+                value is a power of two, from sizeof(void *) to 1 GiB
+                (reported on stderr)
+ */
+int mgr_align_parse_alignments(const char *key, const char *value, mgr_align_opts *opts) {
+    uint32_t values[MGR_ALIGN_MAX];
+    uint32_t n = 0;
+
+    if (mgr_matrix_parse_axis(key, value, values, &n) != 0) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        if ((values[i] & (values[i] - 1)) != 0 || values[i] < sizeof(void *) || values[i] > MGR_ALIGN_LIMIT) {
+            fprintf(stderr, "memgrind: %s: %u is not a power of two from %zu to %u\n",
+                    key, values[i], sizeof(void *), MGR_ALIGN_LIMIT);
+            return -1;
+        }
+    }
+
+    memcpy(opts->alignments, values, sizeof *values * n);
+    opts->nalignments = n;
+    return 0;
+}
+
+static int mgr_align_by_address(const void *a, const void *b) {
+    const uintptr_t x = *(const uintptr_t *)(a);
+    const uintptr_t y = *(const uintptr_t *)(b);
+
+    return (x > y) - (x < y);
+}
+
+/*
+    Median distance between neighbouring blocks, in address order;
+    0 if there are fewer than two. Sorts addrs.
+ */
+static uint64_t mgr_align_stride(uintptr_t *addrs, size_t n) {
+    if (n < 2) {
+        return 0;
+    }
+
+    qsort(addrs, n, sizeof *addrs, mgr_align_by_address);
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        addrs[i] = addrs[i + 1] - addrs[i];
+    }
+
+    qsort(addrs, n - 1, sizeof *addrs, mgr_align_by_address);
+    return (uint64_t)(addrs[(n - 1) / 2]);
+}
+
+typedef struct mgr_align_cell {
+    double alloc_ns;            // per call, best pass
+    double free_ns;
+    uint64_t stride;            // of the last pass
+    uint64_t misaligned;
+    size_t blocks;              // fewer than asked if the allocator ran out
+} mgr_align_cell;
+
+/*
+    Allocates n blocks of size bytes, aligned if alignment is nonzero,
+    writes their first byte and frees them, MGR_ALIGN_PASSES times.
+ */
+static void mgr_align_run_cell(void **blocks, uintptr_t *addrs, size_t n,
+                               size_t alignment, size_t size, mgr_align_cell *out) {
+    memset(out, 0, sizeof *out);
+
+    out->alloc_ns = -1.0;
+    out->free_ns = -1.0;
+
+    for (uint32_t pass = 0; pass < MGR_ALIGN_PASSES; ++pass) {
+        size_t got = 0;
+        const uint64_t x = mgr_clock_ns();
+
+        for (; got < n; ++got) {
+            char *ptr = alignment > 0 ? mgr_aligned_alloc(alignment, size) : mgr_malloc(size);
+
+            if (ptr == NULL) {
+                break;
+            }
+
+            ptr[0] = (char)(got);
+            blocks[got] = ptr;
+        }
+
+        const uint64_t y = mgr_clock_ns();
+
+        out->misaligned = 0;
+
+        for (size_t i = 0; i < got; ++i) {
+            addrs[i] = (uintptr_t)(blocks[i]);
+            out->misaligned += alignment > 0 && (addrs[i] & (alignment - 1)) != 0;
+        }
+
+        const uint64_t z = mgr_clock_ns();
+
+        for (size_t i = 0; i < got; ++i) {
+            if (alignment > 0) {
+                mgr_aligned_free(blocks[i]);
+            } else {
+                mgr_free(blocks[i]);
+            }
+        }
+
+        const uint64_t w = mgr_clock_ns();
+
+        if (got > 0) {
+            const double alloc_ns = (double)(y - x) / (double)(got);
+            const double free_ns = (double)(w - z) / (double)(got);
+
+            out->alloc_ns = out->alloc_ns < 0.0 || alloc_ns < out->alloc_ns ? alloc_ns : out->alloc_ns;
+            out->free_ns = out->free_ns < 0.0 || free_ns < out->free_ns ? free_ns : out->free_ns;
+        }
+
+        out->blocks = got;
+        out->stride = mgr_align_stride(addrs, got);
+
+        if (got < n) {
+            break;
+        }
+    }
+}
+
+/*!
+    \brief  Runs the aligned allocation grid (see mgr_aligned.h)
+            on the current backend, and outputs one table per
+            alignment to dest
+
+    \param[in]  opts    grid
+    \param[in]  dest    destination file stream
+
+    \return     0 on success, -1 if the blocks cannot be tracked,
+                the allocator runs out of memory or returns a
+                misaligned block
+ */
+int mgr_run_align(const mgr_align_opts *opts, FILE *dest) {
+    const size_t count = opts->count > 0 ? opts->count : 1;
+    void **blocks = malloc(sizeof *blocks * count);
+    uintptr_t *addrs = malloc(sizeof *addrs * count);
+    int status = 0;
+
+    if (blocks == NULL || addrs == NULL) {
+        fprintf(stderr, "memgrind: align: cannot track %zu blocks\n", count);
+        free(blocks);
+        free(addrs);
+        return -1;
+    }
+
+    fprintf(dest, "\n%s (%s, %s, %zu %s)\n",
+                  KGRN_b"aligned allocation"KNRM, mgr_backend_current->name,
+                  mgr_backend_current->aligned_malloc_fn ? "native" : "emulated",
+                  count, count == 1 ? "block" : "blocks");
+
+    for (uint32_t i = 0; i < opts->nalignments; ++i) {
+        const size_t alignment = opts->alignments[i];
+
+        fprintf(dest, "\n%s%s %zu%s\n\n", KGRN_b, "align", alignment, KNRM);
+        fprintf(dest, "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+                KWHT_b"size"KNRM"      ", KWHT_b"  blocks"KNRM, KWHT_b"alloc ns"KNRM,
+                KWHT_b" free ns"KNRM, KWHT_b"malloc ns"KNRM, KWHT_b"    stride"KNRM,
+                KWHT_b"     waste"KNRM, KWHT_b"misaligned"KNRM);
+
+        for (uint32_t j = 0; j < opts->nsizes; ++j) {
+            const size_t size = opts->sizes[j];
+            const uint64_t cap = MGR_ALIGN_BYTES_MAX / ((uint64_t)(size) + alignment);
+            const size_t n = cap < count ? (size_t)(cap > 0 ? cap : 1) : count;
+
+            mgr_align_cell aligned;
+            mgr_align_cell plain;
+
+            mgr_align_run_cell(blocks, addrs, n, alignment, size, &aligned);
+            mgr_align_run_cell(blocks, addrs, n, 0, size, &plain);
+
+            fprintf(dest, "%s%-10zu%s\t%8zu", KGRN_b, size, KNRM, aligned.blocks);
+
+            if (aligned.blocks > 0) {
+                fprintf(dest, "\t%8.1lf\t%8.1lf", aligned.alloc_ns, aligned.free_ns);
+            } else {
+                fprintf(dest, "\t%8s\t%8s", "-", "-");
+            }
+
+            if (plain.blocks > 0) {
+                fprintf(dest, "\t%9.1lf", plain.alloc_ns);
+            } else {
+                fprintf(dest, "\t%9s", "-");
+            }
+
+            if (aligned.stride > 0 && plain.stride > 0) {
+                fprintf(dest, "\t%10llu\t%10lld",
+                        (unsigned long long)(aligned.stride),
+                        (long long)(aligned.stride) - (long long)(plain.stride));
+            } else {
+                fprintf(dest, "\t%10s\t%10s", "-", "-");
+            }
+
+            fprintf(dest, "\t%s%10llu%s\n", aligned.misaligned > 0 ? KRED_b : "",
+                    (unsigned long long)(aligned.misaligned), aligned.misaligned > 0 ? KNRM : "");
+
+            if (aligned.blocks < n || plain.blocks < n || aligned.misaligned > 0) {
+                status = -1;
+            }
+        }
+    }
+
+    fprintf(dest, "\n%s\n", "stride: median distance between neighbouring blocks (bytes); "
+                            "waste: stride over malloc's, for the same size");
+
+    if (status != 0) {
+        fprintf(stderr, "memgrind: align: out of memory, or misaligned blocks\n");
+    }
+
+    free(addrs);
+    free(blocks);
+    return status;
+}
@@ -0,0 +1,54 @@
+/*!
+    \file       mgr_aligned.h
+    \brief      Header file for the memgrind_c aligned allocation workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Test r is test d with aligned blocks (see mgr_aligned_array_range).
+
+    --align runs a grid of alignments and block sizes. For every cell,
+    count blocks are allocated with mgr_aligned_alloc, checked for
+    alignment and freed, then allocated with mgr_malloc and freed, for
+    comparison; the best of MGR_ALIGN_PASSES passes is kept. Cells are
+    capped at MGR_ALIGN_BYTES_MAX bytes of blocks and padding.
+
+    What a block costs in space is its stride: the median distance
+    between neighbouring blocks, in address order, so headers, size
+    class rounding and padding all count, for any backend. The stride
+    of aligned blocks minus that of malloc'ed ones is the waste
+    alignment adds to every block.
+ */
+
+#ifndef MGR_ALIGNED_H
+#define MGR_ALIGNED_H
+
+#include "mgr_matrix.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+// most alignments (or sizes) in a grid; lists are parsed as matrix axes
+#define MGR_ALIGN_MAX MGR_MATRIX_MAX
+
+// largest cell, count * (size + alignment), in bytes
+#define MGR_ALIGN_BYTES_MAX ((uint64_t)(256) << 20)
+
+// passes over every cell
+#define MGR_ALIGN_PASSES 3
+
+typedef struct mgr_align_opts {
+    uint32_t alignments[MGR_ALIGN_MAX];
+    uint32_t nalignments;
+    uint32_t sizes[MGR_ALIGN_MAX];
+    uint32_t nsizes;
+    uint32_t count;                     // blocks per cell
+} mgr_align_opts;
+
+void mgr_align_defaults(mgr_align_opts *opts);
+int mgr_align_parse_alignments(const char *key, const char *value, mgr_align_opts *opts);
+
+int mgr_run_align(const mgr_align_opts *opts, FILE *dest);
+
+#endif /* MGR_ALIGNED_H */
@@ -0,0 +1,232 @@
+/*!
+    \file       mgr_alloc.c
+    \brief      Source file for the allocator entry points used by memgrind_c workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_alloc.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+_Thread_local mgr_oplat *mgr_oplat_active = NULL;
+_Thread_local uint64_t mgr_op_count = 0;
+_Thread_local uint64_t mgr_realloc_count = 0;
+_Thread_local uint64_t mgr_realloc_in_place = 0;
+
+bool mgr_alloc_serialized = false;
+bool mgr_alloc_shared = false;
+pthread_mutex_t mgr_alloc_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+const mgr_backend *mgr_backend_current = &mgr_backend_cgcs;
+
+// backends selectable by name
+static const mgr_backend *const mgr_backends_builtin[] = {
+    &mgr_backend_cgcs,
+    &mgr_backend_system,
+    &mgr_backend_arena,
+    &mgr_backend_pool,
+    &mgr_backend_pool_tc,
+    &mgr_backend_cgcs_tc,
+    &mgr_backend_null
+};
+
+/*!
+    \brief  Makes a backend current, tearing down the previous one
+
+    \details    spec is either the name of a built-in backend
+                ("cgcs", "system", "arena", "pool", "pool-tc",
+                "cgcs-tc", "null"),
+                or "dl:PATH[:PREFIX]" to load PREFIXmalloc, PREFIXfree,
+                PREFIXrealloc and PREFIXcalloc from the shared library
+                at PATH.
+                A NULL or empty spec selects cgcs.
+
+    \param[in]  spec    backend specification
+
+    \return     0 on success, -1 if spec names no backend or its
+                initialization failed (the current backend is then cgcs)
+ */
+int mgr_backend_select(const char *spec) {
+    const mgr_backend *backend = NULL;
+
+    mgr_backend_release();
+
+    if (spec == NULL || *spec == '\0') {
+        backend = &mgr_backend_cgcs;
+    } else if (strncmp(spec, "dl:", 3) == 0) {
+        char path[4096];
+        const char *prefix = "";
+
+        snprintf(path, sizeof path, "%s", spec + 3);
+
+        char *colon = strrchr(path, ':');
+
+        if (colon) {
+            *colon = '\0';
+            prefix = colon + 1;
+        }
+
+        backend = mgr_backend_dl_open(path, prefix);
+    } else {
+        const size_t n = sizeof mgr_backends_builtin / sizeof *mgr_backends_builtin;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (strcmp(spec, mgr_backends_builtin[i]->name) == 0) {
+                backend = mgr_backends_builtin[i];
+                break;
+            }
+        }
+    }
+
+    if (backend && backend->init_fn && backend->init_fn() != 0) {
+        backend = NULL;
+    }
+
+    mgr_backend_current = backend ? backend : &mgr_backend_cgcs;
+    return backend ? 0 : -1;
+}
+
+/*!
+    \brief  Tears down the current backend and falls back to cgcs
+ */
+void mgr_backend_release(void) {
+    if (mgr_backend_current->teardown_fn) {
+        mgr_backend_current->teardown_fn();
+    }
+
+    mgr_backend_current = &mgr_backend_cgcs;
+    mgr_backend_dl_close();
+}
+
+/*!
+    \brief  realloc for backends without one: allocate, copy, free
+
+    \param[in]  ptr         block to resize, or NULL
+    \param[in]  old_size    current size of ptr
+    \param[in]  new_size    requested size
+
+    \return     address of the new block, NULL on failure
+ */
+void *mgr_realloc_emulated(void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return mgr_malloc_raw(new_size);
+    }
+
+    if (new_size == 0) {
+        mgr_free_raw(ptr);
+        return NULL;
+    }
+
+    void *res = mgr_malloc_raw(new_size);
+
+    if (res) {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+        mgr_free_raw(ptr);
+    }
+
+    return res;
+}
+
+/*!
+    \brief  calloc for backends without one: allocate, then zero
+
+    \param[in]  count   number of elements
+    \param[in]  size    size of one element
+
+    \return     address of the zeroed block, NULL on failure or overflow
+ */
+void *mgr_calloc_emulated(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void *ptr = mgr_malloc_raw(count * size);
+
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+
+    return ptr;
+}
+
+/*!
+    \brief  Aligned allocation for backends without one
+
+    \details    Allocates alignment - 1 bytes more than asked, plus room
+                for the address of the whole block, which is kept just
+                before the aligned address handed out; so the padding
+                costs up to alignment - 1 + sizeof(void *) bytes a
+                block, on top of the backend's own overhead.
+
+    \param[in]  alignment   a power of two, at least sizeof(void *)
+    \param[in]  size        number of bytes to allocate
+
+    \return     address of the aligned block, NULL on failure or overflow
+ */
+void *mgr_aligned_alloc_emulated(size_t alignment, size_t size) {
+    const size_t pad = alignment - 1 + sizeof(void *);
+
+    if (size > SIZE_MAX - pad) {
+        return NULL;
+    }
+
+    unsigned char *raw = mgr_malloc_raw(size + pad);
+
+    if (raw == NULL) {
+        return NULL;
+    }
+
+    const uintptr_t aligned = ((uintptr_t)(raw) + pad) & ~(uintptr_t)(alignment - 1);
+    void **ptr = (void **)(raw + (aligned - (uintptr_t)(raw)));
+
+    ptr[-1] = raw;
+    return ptr;
+}
+
+/*!
+    \brief  Frees a block from mgr_aligned_alloc_emulated
+
+    \param[in]  ptr     aligned address, or NULL
+ */
+void mgr_aligned_free_emulated(void *ptr) {
+    if (ptr) {
+        mgr_free_raw(((void **)(ptr))[-1]);
+    }
+}
+
+/*!
+    \brief  Reads the thread cache counters of the current backend
+
+    \param[out] out     counter totals
+
+    \return     true if the backend caches blocks per thread
+ */
+bool mgr_cache_stats_read(mgr_cache_stats *out) {
+    memset(out, 0, sizeof *out);
+
+    return mgr_backend_current->cache_stats_fn && mgr_backend_current->cache_stats_fn(out) == 0;
+}
+
+/*!
+    \brief  Prints the thread cache counters between two readings
+
+    \param[in]  dest    destination file stream
+    \param[in]  before  first reading
+    \param[in]  after   second reading
+ */
+void mgr_cache_stats_fprint(FILE *dest, const mgr_cache_stats *before, const mgr_cache_stats *after) {
+    const uint64_t hits = after->hits - before->hits;
+    const uint64_t allocs = hits + (after->misses - before->misses);
+
+    fprintf(dest, "  %-18s\t%11.1lf%%\t%s %llu\t%s %llu\t%s %llu\n", "thread cache hits",
+            allocs > 0 ? 100.0 * (double)(hits) / (double)(allocs) : 0.0,
+            "refills", (unsigned long long)(after->refills - before->refills),
+            "returns", (unsigned long long)(after->returns - before->returns),
+            "remote frees", (unsigned long long)(after->remote_frees - before->remote_frees));
+}
@@ -0,0 +1,455 @@
+/*!
+    \file       mgr_alloc.h
+    \brief      Header file for the allocator entry points used by memgrind_c workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Workloads never call an allocator directly; they call mgr_malloc,
+    mgr_free, mgr_realloc and mgr_calloc (and mgr_aligned_alloc and
+    mgr_aligned_free), which dispatch through the currently selected
+    backend table (cgcs_malloc by default).
+ */
+
+#ifndef MGR_ALLOC_H
+#define MGR_ALLOC_H
+
+#include "mgr_heap.h"
+#include "mgr_hist.h"
+#include "mgr_stats.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*!
+    \brief  Heap usage reported by a backend's stats hook, in bytes
+ */
+typedef struct mgr_backend_stats {
+    size_t in_use;      // bytes handed out to the application
+    size_t mapped;      // bytes obtained from the operating system
+} mgr_backend_stats;
+
+/*!
+    \brief  Counters of a caching backend, totals since it was selected
+
+    \details    Counts of threads still running, other than the calling
+                thread, are not included.
+ */
+typedef struct mgr_cache_stats {
+    uint64_t hits;          // allocations served from a thread's cache
+    uint64_t misses;        // allocations that refilled it first, or bypassed it
+    uint64_t refills;       // batches taken from the allocator behind the cache
+    uint64_t returns;       // batches given back to it
+    uint64_t remote_frees;  // frees of blocks another thread allocated
+} mgr_cache_stats;
+
+/*!
+    \brief  Allocator backend table
+
+    \details    malloc_fn and free_fn are required.
+                realloc_fn receives the block's old size, since some
+                allocators (cgcs_malloc) have no realloc of their own;
+                if realloc_fn or calloc_fn are NULL, they are emulated
+                with malloc_fn/free_fn.
+                init_fn, teardown_fn, stats_fn and usable_size_fn
+                (bytes actually reserved for a block) are optional.
+                batch_malloc_fn (which may return fewer blocks than
+                asked) and batch_free_fn are optional too; without them,
+                batches are a loop of malloc_fn/free_fn calls.
+                aligned_malloc_fn, optional, returns a block aligned to
+                a power of two no less than sizeof(void *), which
+                free_fn releases; without it, aligned blocks are carved
+                out of larger malloc_fn blocks (see
+                mgr_aligned_alloc_emulated).
+                reset_fn, also optional, frees every block at once.
+                cache_stats_fn is for backends that cache blocks per
+                thread, and walk_fn for backends whose heap can be
+                walked (see mgr_heap.h).
+ */
+typedef struct mgr_backend {
+    const char *name;
+    bool thread_safe;
+
+    int (*init_fn)(void);
+    void (*teardown_fn)(void);
+
+    void *(*malloc_fn)(size_t size);
+    void (*free_fn)(void *ptr);
+    void *(*realloc_fn)(void *ptr, size_t old_size, size_t new_size);
+    void *(*calloc_fn)(size_t count, size_t size);
+    void *(*aligned_malloc_fn)(size_t alignment, size_t size);
+
+    int (*stats_fn)(mgr_backend_stats *out);
+    size_t (*usable_size_fn)(void *ptr);
+
+    size_t (*batch_malloc_fn)(size_t size, void **ptrs, size_t count);
+    void (*batch_free_fn)(void **ptrs, size_t count);
+
+    void (*reset_fn)(void);
+
+    int (*cache_stats_fn)(mgr_cache_stats *out);
+
+    int (*walk_fn)(mgr_heap_walk *walk);
+} mgr_backend;
+
+// built-in backends
+extern const mgr_backend mgr_backend_cgcs;
+extern const mgr_backend mgr_backend_system;
+extern const mgr_backend mgr_backend_arena;
+extern const mgr_backend mgr_backend_pool;
+extern const mgr_backend mgr_backend_pool_tc;
+extern const mgr_backend mgr_backend_cgcs_tc;
+extern const mgr_backend mgr_backend_null;
+
+// backend all mgr_* allocator calls dispatch to
+extern const mgr_backend *mgr_backend_current;
+
+int mgr_backend_select(const char *spec);
+void mgr_backend_release(void);
+const mgr_backend *mgr_backend_dl_open(const char *path, const char *prefix);
+void mgr_backend_dl_close(void);
+
+void *mgr_realloc_emulated(void *ptr, size_t old_size, size_t new_size);
+void *mgr_calloc_emulated(size_t count, size_t size);
+void *mgr_aligned_alloc_emulated(size_t alignment, size_t size);
+void mgr_aligned_free_emulated(void *ptr);
+
+bool mgr_cache_stats_read(mgr_cache_stats *out);
+void mgr_cache_stats_fprint(FILE *dest, const mgr_cache_stats *before, const mgr_cache_stats *after);
+
+/*
+    Latency recorder of the calling thread;
+    NULL unless op latency mode is on and a timed region is running.
+ */
+extern _Thread_local mgr_oplat *mgr_oplat_active;
+
+// Allocator calls made by the calling thread since it last reset this
+extern _Thread_local uint64_t mgr_op_count;
+
+// mgr_realloc calls made by the calling thread, and those that kept the block in place
+extern _Thread_local uint64_t mgr_realloc_count;
+extern _Thread_local uint64_t mgr_realloc_in_place;
+
+/*
+    When true, every allocator call is serialized through mgr_alloc_mutex.
+    The threaded runner turns this on whenever more than one thread runs
+    on a backend that is not thread-safe (cgcs_malloc keeps its heap in
+    unguarded global state).
+ */
+extern bool mgr_alloc_serialized;
+extern pthread_mutex_t mgr_alloc_mutex;
+
+/*
+    True while more than one thread runs a workload on the current
+    backend: a reset would free blocks the other threads still hold.
+ */
+extern bool mgr_alloc_shared;
+
+static inline void *mgr_malloc_raw(size_t size) {
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+        void *ptr = mgr_backend_current->malloc_fn(size);
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+        return ptr;
+    }
+
+    return mgr_backend_current->malloc_fn(size);
+}
+
+static inline void mgr_free_raw(void *ptr) {
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+        mgr_backend_current->free_fn(ptr);
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+        return;
+    }
+
+    mgr_backend_current->free_fn(ptr);
+}
+
+/*!
+    \brief  Allocates through the current backend, timed into the
+            active latency recorder (if any)
+
+    \param[in]  size    number of bytes to allocate
+
+    \return     the address returned by the backend
+ */
+static inline void *mgr_malloc(size_t size) {
+    ++mgr_op_count;
+
+    if (mgr_oplat_active == NULL) {
+        return mgr_malloc_raw(size);
+    }
+
+    const uint64_t x = mgr_clock_ns();
+    void *ptr = mgr_malloc_raw(size);
+    const uint64_t y = mgr_clock_ns();
+
+    mgr_hist_record(&mgr_oplat_active->malloc_all, y - x);
+    mgr_hist_record(&mgr_oplat_active->malloc_class[mgr_size_class(size)], y - x);
+
+    return ptr;
+}
+
+/*!
+    \brief  Frees through the current backend, timed into the
+            active latency recorder (if any)
+
+    \param[in]  ptr     address previously returned by mgr_malloc
+ */
+static inline void mgr_free(void *ptr) {
+    ++mgr_op_count;
+
+    if (mgr_oplat_active == NULL) {
+        mgr_free_raw(ptr);
+        return;
+    }
+
+    const uint64_t x = mgr_clock_ns();
+    mgr_free_raw(ptr);
+    const uint64_t y = mgr_clock_ns();
+
+    mgr_hist_record(&mgr_oplat_active->free_all, y - x);
+}
+
+/*!
+    \brief  Resizes a block through the current backend
+
+    \details    Calls that return ptr itself count as in place
+                (an emulated realloc never is).
+
+    \param[in]  ptr         address previously returned by mgr_malloc, or NULL
+    \param[in]  old_size    size ptr was allocated (or last resized) with
+    \param[in]  new_size    requested size
+
+    \return     address of the resized block, NULL on failure
+                (ptr is left untouched on failure)
+ */
+static inline void *mgr_realloc(void *ptr, size_t old_size, size_t new_size) {
+    const uintptr_t old = (uintptr_t)(ptr);    // compared once ptr may be gone
+    void *res = NULL;
+
+    ++mgr_op_count;
+    ++mgr_realloc_count;
+
+    if (mgr_backend_current->realloc_fn == NULL) {
+        return mgr_realloc_emulated(ptr, old_size, new_size);
+    }
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+        res = mgr_backend_current->realloc_fn(ptr, old_size, new_size);
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+    } else {
+        res = mgr_backend_current->realloc_fn(ptr, old_size, new_size);
+    }
+
+    if (res && (uintptr_t)(res) == old) {
+        ++mgr_realloc_in_place;
+    }
+
+    return res;
+}
+
+/*!
+    \brief  Allocates count * size zeroed bytes through the current backend
+
+    \param[in]  count   number of elements
+    \param[in]  size    size of one element
+
+    \return     address of the zeroed block, NULL on failure or overflow
+ */
+static inline void *mgr_calloc(size_t count, size_t size) {
+    ++mgr_op_count;
+
+    if (mgr_backend_current->calloc_fn == NULL) {
+        return mgr_calloc_emulated(count, size);
+    }
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+        void *ptr = mgr_backend_current->calloc_fn(count, size);
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+        return ptr;
+    }
+
+    return mgr_backend_current->calloc_fn(count, size);
+}
+
+static inline void *mgr_aligned_alloc_raw(size_t alignment, size_t size) {
+    if (mgr_backend_current->aligned_malloc_fn == NULL) {
+        return mgr_aligned_alloc_emulated(alignment, size);
+    }
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+        void *ptr = mgr_backend_current->aligned_malloc_fn(alignment, size);
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+        return ptr;
+    }
+
+    return mgr_backend_current->aligned_malloc_fn(alignment, size);
+}
+
+/*!
+    \brief  Allocates an aligned block through the current backend,
+            timed into the active latency recorder (if any)
+
+    \details    The block must be freed with mgr_aligned_free, while
+                the same backend is current.
+
+    \param[in]  alignment   a power of two, at least sizeof(void *)
+    \param[in]  size        number of bytes to allocate
+
+    \return     address of the block, a multiple of alignment unless
+                the backend is broken; NULL on failure
+ */
+static inline void *mgr_aligned_alloc(size_t alignment, size_t size) {
+    ++mgr_op_count;
+
+    if (mgr_oplat_active == NULL) {
+        return mgr_aligned_alloc_raw(alignment, size);
+    }
+
+    const uint64_t x = mgr_clock_ns();
+    void *ptr = mgr_aligned_alloc_raw(alignment, size);
+    const uint64_t y = mgr_clock_ns();
+
+    mgr_hist_record(&mgr_oplat_active->malloc_all, y - x);
+    mgr_hist_record(&mgr_oplat_active->malloc_class[mgr_size_class(size)], y - x);
+
+    return ptr;
+}
+
+/*!
+    \brief  Frees a block from mgr_aligned_alloc, timed into the
+            active latency recorder (if any)
+
+    \param[in]  ptr     address previously returned by mgr_aligned_alloc
+ */
+static inline void mgr_aligned_free(void *ptr) {
+    const uint64_t x = mgr_oplat_active ? mgr_clock_ns() : 0;
+
+    ++mgr_op_count;
+
+    if (mgr_backend_current->aligned_malloc_fn == NULL) {
+        mgr_aligned_free_emulated(ptr);
+    } else {
+        mgr_free_raw(ptr);
+    }
+
+    if (mgr_oplat_active) {
+        mgr_hist_record(&mgr_oplat_active->free_all, mgr_clock_ns() - x);
+    }
+}
+
+/*!
+    \brief  Allocates count blocks of size bytes through the current
+            backend, in one call
+
+    \details    Uses the backend's batch interface if it has one, and
+                a loop of malloc_fn calls for whatever it did not hand
+                out. When allocator calls are serialized, the lock is
+                taken once for the whole batch. Every block counts as
+                one allocator call; batches are not timed into the
+                active latency recorder.
+
+    \param[in]  size    size of every block
+    \param[out] ptrs    the blocks
+    \param[in]  count   number of blocks
+
+    \return     number of blocks allocated, from ptrs[0]
+                (fewer than count only if the backend ran out of memory)
+ */
+static inline size_t mgr_malloc_batch(size_t size, void **ptrs, size_t count) {
+    const mgr_backend *backend = mgr_backend_current;
+    size_t n = 0;
+
+    mgr_op_count += count;
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+    }
+
+    if (backend->batch_malloc_fn) {
+        n = backend->batch_malloc_fn(size, ptrs, count);
+    }
+
+    for (; n < count; ++n) {
+        if ((ptrs[n] = backend->malloc_fn(size)) == NULL) {
+            break;
+        }
+    }
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+    }
+
+    return n;
+}
+
+/*!
+    \brief  Frees count blocks through the current backend, in one call
+
+    \details    See mgr_malloc_batch.
+
+    \param[in]  ptrs    blocks previously returned by mgr_malloc or
+                        mgr_malloc_batch (not NULL)
+    \param[in]  count   number of blocks
+ */
+static inline void mgr_free_batch(void **ptrs, size_t count) {
+    const mgr_backend *backend = mgr_backend_current;
+
+    mgr_op_count += count;
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+    }
+
+    if (backend->batch_free_fn) {
+        backend->batch_free_fn(ptrs, count);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            backend->free_fn(ptrs[i]);
+        }
+    }
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+    }
+}
+
+/*!
+    \brief  Frees every block of the current backend at once, if it can
+
+    \details    For request-scoped workloads: if the backend has no
+                reset_fn, or other threads share it (mgr_alloc_shared),
+                nothing is freed and the caller frees its blocks one by
+                one. A reset counts as one allocator call.
+
+    \return     true if every block was freed
+ */
+static inline bool mgr_free_all(void) {
+    if (mgr_backend_current->reset_fn == NULL || mgr_alloc_shared) {
+        return false;
+    }
+
+    ++mgr_op_count;
+
+    if (mgr_alloc_serialized) {
+        pthread_mutex_lock(&mgr_alloc_mutex);
+        mgr_backend_current->reset_fn();
+        pthread_mutex_unlock(&mgr_alloc_mutex);
+        return true;
+    }
+
+    mgr_backend_current->reset_fn();
+    return true;
+}
+
+#endif /* MGR_ALLOC_H */
@@ -0,0 +1,185 @@
+/*!
+    \file       mgr_backend_arena.c
+    \brief      Source file for the arena (bump pointer) allocator backend
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Blocks are carved from MGR_ARENA_CHUNK byte chunks (larger for
+    larger requests) by bumping a pointer (see mgr_bump.h); free does not reclaim a
+    block, except the most recent one, but counts it. When every block
+    has been freed, or reset_fn is called, the arena rewinds to its first
+    chunk in O(1). Chunks are kept for reuse and returned to the C
+    library at teardown.
+
+    This suits request-scoped workloads: everything a request allocates
+    is dropped at once. A workload that never frees everything (such as
+    the soak) only grows.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_alloc.h"
+#include "mgr_bump.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// default chunk size
+#define MGR_ARENA_CHUNK ((size_t)(1) << 20)
+
+static struct {
+    mgr_bump region;
+    unsigned char *last;                // most recent block, or NULL
+    size_t live;                        // blocks not yet freed
+} arena = { { .chunk_size = MGR_ARENA_CHUNK } };
+
+static void mgr_arena_rewind(void) {
+    mgr_bump_rewind(&arena.region);
+    arena.last = NULL;
+    arena.live = 0;
+}
+
+/*
+    For a larger alignment, the bytes skipped to reach it count as
+    in use until the arena rewinds.
+ */
+static void *mgr_arena_aligned_malloc(size_t alignment, size_t size) {
+    unsigned char *ptr = mgr_bump_alloc(&arena.region, alignment, size);
+
+    if (ptr) {
+        arena.last = ptr;
+        ++arena.live;
+    }
+
+    return ptr;
+}
+
+static void *mgr_arena_malloc(size_t size) {
+    return mgr_arena_aligned_malloc(MGR_BUMP_ALIGN, size);
+}
+
+static void mgr_arena_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if (ptr == arena.last) {
+        arena.region.in_use -= (size_t)(arena.region.bump - arena.last);
+        arena.region.bump = arena.last; // pop the most recent block
+        arena.last = NULL;
+    }
+
+    if (--arena.live == 0) {
+        mgr_arena_rewind();
+    }
+}
+
+static void *mgr_arena_realloc(void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return mgr_arena_malloc(new_size);
+    }
+
+    if (new_size == 0) {
+        mgr_arena_free(ptr);
+        return NULL;
+    }
+
+    // the most recent block grows or shrinks in place while its chunk has room
+    if (ptr == arena.last) {
+        mgr_bump *r = &arena.region;
+        const size_t bytes = (new_size + MGR_BUMP_ALIGN - 1) & ~(MGR_BUMP_ALIGN - 1);
+
+        if (bytes >= new_size && (size_t)(r->end - arena.last) >= bytes) {
+            r->in_use -= (size_t)(r->bump - arena.last);
+            r->in_use += bytes;
+            r->bump = arena.last + bytes;
+            return ptr;
+        }
+    }
+
+    void *res = mgr_arena_malloc(new_size);
+
+    if (res) {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+        mgr_arena_free(ptr);
+    }
+
+    return res;
+}
+
+static void *mgr_arena_calloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void *ptr = mgr_arena_malloc(count * size);
+
+    if (ptr) {
+        memset(ptr, 0, count * size);   // rewound chunks hold old data
+    }
+
+    return ptr;
+}
+
+static int mgr_arena_stats(mgr_backend_stats *out) {
+    out->in_use = arena.region.in_use;
+    out->mapped = arena.region.mapped;
+    return 0;
+}
+
+/*
+    Spans, not blocks: chunks before the current one are used up to
+    their end (what they could not fit is lost until the arena rewinds),
+    the current chunk is used up to the bump pointer, and the rest is free.
+ */
+static int mgr_arena_walk(mgr_heap_walk *walk) {
+    const mgr_bump *r = &arena.region;
+    bool before = r->current != NULL;
+
+    for (const mgr_bump_chunk *chunk = r->head; chunk; chunk = chunk->next) {
+        if (chunk == r->current) {
+            const size_t used = (size_t)(r->bump - chunk->data);
+
+            if (used > 0) {
+                mgr_heap_block(walk, chunk->data, used, false, MGR_HEAP_NO_CLASS);
+            }
+
+            if (used < chunk->size) {
+                mgr_heap_block(walk, r->bump, chunk->size - used, true, MGR_HEAP_NO_CLASS);
+            }
+
+            before = false;
+        } else {
+            mgr_heap_block(walk, chunk->data, chunk->size, before == false, MGR_HEAP_NO_CLASS);
+        }
+    }
+
+    return 0;
+}
+
+static void mgr_arena_teardown(void) {
+    mgr_bump_release(&arena.region);
+    arena.last = NULL;
+    arena.live = 0;
+}
+
+const mgr_backend mgr_backend_arena = {
+    .name = "arena",
+    .thread_safe = false,
+    .init_fn = NULL,
+    .teardown_fn = mgr_arena_teardown,
+    .malloc_fn = mgr_arena_malloc,
+    .free_fn = mgr_arena_free,
+    .realloc_fn = mgr_arena_realloc,
+    .calloc_fn = mgr_arena_calloc,
+    .aligned_malloc_fn = mgr_arena_aligned_malloc,
+    .stats_fn = mgr_arena_stats,
+    .usable_size_fn = NULL,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = mgr_arena_rewind,
+    .cache_stats_fn = NULL,
+    .walk_fn = mgr_arena_walk
+};
@@ -0,0 +1,44 @@
+/*!
+    \file       mgr_backend_cgcs.c
+    \brief      Source file for the cgcs_malloc allocator backend
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_alloc.h"
+
+#include "cgcs_malloc.h"
+
+static void *mgr_cgcs_malloc(size_t size) {
+    return cgcs_malloc(size);
+}
+
+static void mgr_cgcs_free(void *ptr) {
+    cgcs_free(ptr);
+}
+
+/*
+    cgcs_malloc has no realloc/calloc and no thread safety of its own;
+    the former are emulated, the latter is provided by serializing calls.
+ */
+const mgr_backend mgr_backend_cgcs = {
+    .name = "cgcs",
+    .thread_safe = false,
+    .init_fn = NULL,
+    .teardown_fn = NULL,
+    .malloc_fn = mgr_cgcs_malloc,
+    .free_fn = mgr_cgcs_free,
+    .realloc_fn = NULL,
+    .calloc_fn = NULL,
+    .aligned_malloc_fn = NULL,
+    .stats_fn = NULL,
+    .usable_size_fn = NULL,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+    .walk_fn = NULL
+};
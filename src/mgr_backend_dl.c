@@ -0,0 +1,139 @@
+/*!
+    \file       mgr_backend_dl.c
+    \brief      Source file for the dlopen-loaded shared library allocator backend
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Loads malloc/free (and, if present, realloc/calloc/usable_size and
+    aligned_alloc) from any shared library, e.g. libjemalloc.so or
+    libmimalloc.so with prefix "mi_".
+    The library is opened RTLD_LOCAL, so it does not interpose the
+    process's own malloc; only memgrind workloads reach it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_alloc.h"
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <string.h>
+
+static void *dl_handle = NULL;
+static char dl_name[256];
+
+static void *(*dl_malloc)(size_t) = NULL;
+static void (*dl_free)(void *) = NULL;
+static void *(*dl_realloc)(void *, size_t) = NULL;
+static void *(*dl_calloc)(size_t, size_t) = NULL;
+static size_t (*dl_usable_size)(void *) = NULL;
+static void *(*dl_aligned_alloc)(size_t, size_t) = NULL;
+
+static void *mgr_dl_realloc(void *ptr, size_t old_size, size_t new_size) {
+    (void)(old_size);
+    return dl_realloc(ptr, new_size);
+}
+
+static mgr_backend mgr_backend_dl = {
+    .name = dl_name,
+    .thread_safe = true,
+    .init_fn = NULL,
+    .teardown_fn = NULL,
+    .malloc_fn = NULL,
+    .free_fn = NULL,
+    .realloc_fn = NULL,
+    .calloc_fn = NULL,
+    .aligned_malloc_fn = NULL,
+    .stats_fn = NULL,
+    .usable_size_fn = NULL,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+    .walk_fn = NULL
+};
+
+static void *mgr_dl_sym(const char *prefix, const char *name) {
+    char symbol[128];
+    snprintf(symbol, sizeof symbol, "%s%s", prefix, name);
+    return dlsym(dl_handle, symbol);
+}
+
+/*!
+    \brief  Loads an allocator from a shared library
+
+    \param[in]  path    path to the shared library
+    \param[in]  prefix  prefix of the allocator's symbols ("" for none)
+
+    \return     the loaded backend, or NULL if the library or its
+                malloc/free could not be loaded (reported on stderr)
+ */
+const mgr_backend *mgr_backend_dl_open(const char *path, const char *prefix) {
+    mgr_backend_dl_close();
+
+    dl_handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+
+    if (dl_handle == NULL) {
+        fprintf(stderr, "memgrind: %s\n", dlerror());
+        return NULL;
+    }
+
+    void *sym_malloc = mgr_dl_sym(prefix, "malloc");
+    void *sym_free = mgr_dl_sym(prefix, "free");
+    void *sym_realloc = mgr_dl_sym(prefix, "realloc");
+    void *sym_calloc = mgr_dl_sym(prefix, "calloc");
+    void *sym_usable_size = mgr_dl_sym(prefix, "malloc_usable_size");
+    void *sym_aligned_alloc = mgr_dl_sym(prefix, "aligned_alloc");
+
+    if (sym_usable_size == NULL) {
+        sym_usable_size = mgr_dl_sym(prefix, "usable_size");     // mimalloc
+    }
+
+    if (sym_malloc == NULL || sym_free == NULL) {
+        fprintf(stderr, "memgrind: %s: no %smalloc/%sfree\n", path, prefix, prefix);
+        mgr_backend_dl_close();
+        return NULL;
+    }
+
+    /*
+        ISO C has no conversion from void * to a function pointer;
+        copying the bits is the POSIX-sanctioned way around it.
+     */
+    memcpy(&dl_malloc, &sym_malloc, sizeof dl_malloc);
+    memcpy(&dl_free, &sym_free, sizeof dl_free);
+    memcpy(&dl_realloc, &sym_realloc, sizeof dl_realloc);
+    memcpy(&dl_calloc, &sym_calloc, sizeof dl_calloc);
+    memcpy(&dl_usable_size, &sym_usable_size, sizeof dl_usable_size);
+    memcpy(&dl_aligned_alloc, &sym_aligned_alloc, sizeof dl_aligned_alloc);
+
+    const char *base = strrchr(path, '/');
+    snprintf(dl_name, sizeof dl_name, "dl:%s", base ? base + 1 : path);
+
+    mgr_backend_dl.malloc_fn = dl_malloc;
+    mgr_backend_dl.free_fn = dl_free;
+    mgr_backend_dl.realloc_fn = dl_realloc ? mgr_dl_realloc : NULL;
+    mgr_backend_dl.calloc_fn = dl_calloc;
+    mgr_backend_dl.usable_size_fn = dl_usable_size;
+    mgr_backend_dl.aligned_malloc_fn = dl_aligned_alloc;
+
+    return &mgr_backend_dl;
+}
+
+/*!
+    \brief  Unloads the shared library opened by mgr_backend_dl_open, if any
+ */
+void mgr_backend_dl_close(void) {
+    if (dl_handle) {
+        dlclose(dl_handle);
+        dl_handle = NULL;
+    }
+
+    mgr_backend_dl.malloc_fn = NULL;
+    mgr_backend_dl.free_fn = NULL;
+    mgr_backend_dl.realloc_fn = NULL;
+    mgr_backend_dl.calloc_fn = NULL;
+    mgr_backend_dl.usable_size_fn = NULL;
+    mgr_backend_dl.aligned_malloc_fn = NULL;
+}
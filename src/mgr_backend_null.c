@@ -0,0 +1,99 @@
+/*!
+    \file       mgr_backend_null.c
+    \brief      Source file for the null allocator backend
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    The cheapest allocator that still hands out distinct, writable
+    blocks: malloc bumps a pointer through MGR_NULL_CHUNK byte chunks
+    (see mgr_bump.h) and free only counts. Once every block has been freed, or reset_fn
+    is called, it rewinds to the first chunk. Time a workload spends on
+    this backend is time spent outside any real allocator, which is
+    what --calibrate subtracts (see mgr_calib.h).
+
+    Unlike the arena, free never gives memory back, not even the most
+    recent block, and realloc always moves the block.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_alloc.h"
+#include "mgr_bump.h"
+
+#include <string.h>
+
+// default chunk size
+#define MGR_NULL_CHUNK ((size_t)(4) << 20)
+
+static struct {
+    mgr_bump region;
+    size_t live;                        // blocks not yet freed
+} null_heap = { { .chunk_size = MGR_NULL_CHUNK } };
+
+static void mgr_null_rewind(void) {
+    mgr_bump_rewind(&null_heap.region);
+    null_heap.live = 0;
+}
+
+static void *mgr_null_aligned_malloc(size_t alignment, size_t size) {
+    void *ptr = mgr_bump_alloc(&null_heap.region, alignment, size);
+
+    null_heap.live += ptr != NULL;
+    return ptr;
+}
+
+static void *mgr_null_malloc(size_t size) {
+    return mgr_null_aligned_malloc(MGR_BUMP_ALIGN, size);
+}
+
+static void mgr_null_free(void *ptr) {
+    if (ptr && --null_heap.live == 0) {
+        mgr_null_rewind();
+    }
+}
+
+static void *mgr_null_realloc(void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return mgr_null_malloc(new_size);
+    }
+
+    if (new_size == 0) {
+        mgr_null_free(ptr);
+        return NULL;
+    }
+
+    void *res = mgr_null_malloc(new_size);
+
+    if (res) {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+        mgr_null_free(ptr);
+    }
+
+    return res;
+}
+
+static void mgr_null_teardown(void) {
+    mgr_bump_release(&null_heap.region);
+    null_heap.live = 0;
+}
+
+const mgr_backend mgr_backend_null = {
+    .name = "null",
+    .thread_safe = false,
+    .init_fn = NULL,
+    .teardown_fn = mgr_null_teardown,
+    .malloc_fn = mgr_null_malloc,
+    .free_fn = mgr_null_free,
+    .realloc_fn = mgr_null_realloc,
+    .calloc_fn = NULL,
+    .aligned_malloc_fn = mgr_null_aligned_malloc,
+    .stats_fn = NULL,
+    .usable_size_fn = NULL,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = mgr_null_rewind,
+    .cache_stats_fn = NULL,
+    .walk_fn = NULL
+};
@@ -0,0 +1,601 @@
+/*!
+    \file       mgr_backend_pool.c
+    \brief      Source file for the pool (segregated-fit slab) allocator backends
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Requests of up to MGR_CLASS_MAX bytes are rounded up to one of
+    MGR_CLASSES size classes (see mgr_classes.h) and served from a free
+    list of that class. Empty lists are refilled by carving a slab: a
+    MGR_POOL_SLAB byte, MGR_POOL_SLAB aligned block of one class, whose
+    header (found by masking a block's address) names the class, so
+    blocks carry no header of their own. Slabs are cut from
+    MGR_POOL_REGION byte regions and never returned before teardown.
+
+    Larger requests get a slab of their own, of as many MGR_POOL_SLAB
+    bytes as they need, from the C library; these are kept on a list,
+    for the heap walk and teardown.
+
+    "pool" is single-threaded; the threaded runner serializes it.
+    "pool-tc" puts a per-thread cache of up to 2 * MGR_POOL_TC_BATCH
+    blocks per class in front of the same lists, which are then locked,
+    and moves blocks between the two MGR_POOL_TC_BATCH at a time. A
+    block may be freed by any thread; it joins that thread's cache.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_alloc.h"
+#include "mgr_classes.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// slab size and alignment
+#define MGR_POOL_SLAB ((size_t)(1) << 16)
+
+// slabs are cut from regions of this many bytes
+#define MGR_POOL_REGION (MGR_POOL_SLAB * 16)
+
+// class of slabs holding a single large block
+#define MGR_POOL_LARGE UINT32_MAX
+
+// blocks moved between a thread cache and the shared lists at once
+#define MGR_POOL_TC_BATCH 32
+
+typedef struct mgr_pool_slab {
+    uint32_t cls;                       // size class, or MGR_POOL_LARGE
+    uint32_t unused;
+    size_t size;                        // block size (bytes)
+} mgr_pool_slab;
+
+// first block of a slab
+#define MGR_POOL_HEADER ((sizeof(mgr_pool_slab) + MGR_CLASS_QUANTUM - 1) & ~(MGR_CLASS_QUANTUM - 1))
+
+// slab of a large block, linked to the others
+typedef struct mgr_pool_large {
+    mgr_pool_slab slab;
+    struct mgr_pool_large *prev;
+    struct mgr_pool_large *next;
+} mgr_pool_large;
+
+// the large block itself
+#define MGR_POOL_LARGE_HEADER ((sizeof(mgr_pool_large) + MGR_CLASS_QUANTUM - 1) & ~(MGR_CLASS_QUANTUM - 1))
+
+typedef struct mgr_pool_block {
+    struct mgr_pool_block *next;
+} mgr_pool_block;
+
+static struct {
+    mgr_pool_block *head[MGR_CLASSES];  // free blocks
+    unsigned char *bump[MGR_CLASSES];   // uncarved part of the class' slab
+    unsigned char *end[MGR_CLASSES];
+
+    unsigned char *spare;               // uncut part of the current region
+    unsigned char *spare_end;
+
+    void **regions;                     // from the C library, freed at teardown
+    size_t region_count;
+    size_t region_capacity;
+
+    mgr_pool_large *large;              // live large blocks, most recent first
+
+    size_t in_use;
+    size_t mapped;
+
+    uint64_t epoch;                     // bumped at teardown, voids thread caches
+} pool;
+
+// guards pool for pool-tc
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Thread_local struct {
+    mgr_pool_block *head[MGR_CLASSES];
+    uint32_t count[MGR_CLASSES];
+    uint64_t epoch;
+    bool registered;
+} tcache;
+
+static pthread_key_t tcache_key;
+static bool tcache_key_created = false;
+
+static inline mgr_pool_slab *mgr_pool_slab_of(void *ptr) {
+    return (mgr_pool_slab *)((uintptr_t)(ptr) & ~(uintptr_t)(MGR_POOL_SLAB - 1));
+}
+
+static unsigned char *mgr_pool_new_slab(void) {
+    if (pool.spare == pool.spare_end) {
+        if (pool.region_count == pool.region_capacity) {
+            const size_t capacity = pool.region_capacity ? pool.region_capacity * 2 : 16;
+            void **regions = realloc(pool.regions, sizeof *regions * capacity);
+
+            if (regions == NULL) {
+                return NULL;
+            }
+
+            pool.regions = regions;
+            pool.region_capacity = capacity;
+        }
+
+        unsigned char *region = aligned_alloc(MGR_POOL_SLAB, MGR_POOL_REGION);
+
+        if (region == NULL) {
+            return NULL;
+        }
+
+        pool.regions[pool.region_count++] = region;
+        pool.mapped += MGR_POOL_REGION;
+        pool.spare = region;
+        pool.spare_end = region + MGR_POOL_REGION;
+    }
+
+    unsigned char *slab = pool.spare;
+    pool.spare += MGR_POOL_SLAB;
+    return slab;
+}
+
+// a free block of class cls, from its list or carved from a slab
+static void *mgr_pool_take(uint32_t cls) {
+    mgr_pool_block *block = pool.head[cls];
+
+    if (block) {
+        pool.head[cls] = block->next;
+        return block;
+    }
+
+    const size_t size = mgr_class_size(cls);
+
+    if ((size_t)(pool.end[cls] - pool.bump[cls]) < size) {
+        unsigned char *slab = mgr_pool_new_slab();
+
+        if (slab == NULL) {
+            return NULL;
+        }
+
+        ((mgr_pool_slab *)(slab))->cls = cls;
+        ((mgr_pool_slab *)(slab))->size = size;
+        pool.bump[cls] = slab + MGR_POOL_HEADER;
+        pool.end[cls] = slab + MGR_POOL_SLAB;
+    }
+
+    void *ptr = pool.bump[cls];
+    pool.bump[cls] += size;
+    return ptr;
+}
+
+static inline void mgr_pool_give(void *ptr, uint32_t cls) {
+    mgr_pool_block *block = ptr;
+
+    block->next = pool.head[cls];
+    pool.head[cls] = block;
+}
+
+static void *mgr_pool_large_malloc(size_t size) {
+    const size_t bytes = (MGR_POOL_LARGE_HEADER + size + MGR_POOL_SLAB - 1) & ~(MGR_POOL_SLAB - 1);
+
+    if (bytes < size) {
+        return NULL;                    // overflow
+    }
+
+    mgr_pool_large *large = aligned_alloc(MGR_POOL_SLAB, bytes);
+
+    if (large == NULL) {
+        return NULL;
+    }
+
+    large->slab.cls = MGR_POOL_LARGE;
+    large->slab.size = bytes - MGR_POOL_LARGE_HEADER;
+
+    large->prev = NULL;
+    large->next = pool.large;
+
+    if (pool.large) {
+        pool.large->prev = large;
+    }
+
+    pool.large = large;
+    return (unsigned char *)(large) + MGR_POOL_LARGE_HEADER;
+}
+
+static void mgr_pool_large_free(mgr_pool_large *large) {
+    if (large->prev) {
+        large->prev->next = large->next;
+    } else {
+        pool.large = large->next;
+    }
+
+    if (large->next) {
+        large->next->prev = large->prev;
+    }
+
+    free(large);
+}
+
+static void *mgr_pool_malloc(size_t size) {
+    if (size > MGR_CLASS_MAX) {
+        void *ptr = mgr_pool_large_malloc(size);
+
+        if (ptr) {
+            pool.in_use += mgr_pool_slab_of(ptr)->size;
+            pool.mapped += mgr_pool_slab_of(ptr)->size + MGR_POOL_LARGE_HEADER;
+        }
+
+        return ptr;
+    }
+
+    const uint32_t cls = mgr_class_of(size);
+    void *ptr = mgr_pool_take(cls);
+
+    if (ptr) {
+        pool.in_use += mgr_class_size(cls);
+    }
+
+    return ptr;
+}
+
+static void mgr_pool_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    mgr_pool_slab *slab = mgr_pool_slab_of(ptr);
+
+    pool.in_use -= slab->size;
+
+    if (slab->cls == MGR_POOL_LARGE) {
+        pool.mapped -= slab->size + MGR_POOL_LARGE_HEADER;
+        mgr_pool_large_free((mgr_pool_large *)(slab));
+    } else {
+        mgr_pool_give(ptr, slab->cls);
+    }
+}
+
+static size_t mgr_pool_usable_size(void *ptr) {
+    return ptr ? mgr_pool_slab_of(ptr)->size : 0;
+}
+
+// shared by both variants: a block whose slab fits new_size stays in place
+static void *mgr_pool_resize(void *ptr, size_t old_size, size_t new_size,
+                             void *(*malloc_fn)(size_t), void (*free_fn)(void *)) {
+    if (ptr == NULL) {
+        return malloc_fn(new_size);
+    }
+
+    if (new_size == 0) {
+        free_fn(ptr);
+        return NULL;
+    }
+
+    const mgr_pool_slab *slab = mgr_pool_slab_of(ptr);
+
+    if (new_size <= slab->size && (slab->cls == MGR_POOL_LARGE || mgr_class_of(new_size) == slab->cls)) {
+        return ptr;
+    }
+
+    void *res = malloc_fn(new_size);
+
+    if (res) {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+        free_fn(ptr);
+    }
+
+    return res;
+}
+
+static void *mgr_pool_realloc(void *ptr, size_t old_size, size_t new_size) {
+    return mgr_pool_resize(ptr, old_size, new_size, mgr_pool_malloc, mgr_pool_free);
+}
+
+static int mgr_pool_stats(mgr_backend_stats *out) {
+    pthread_mutex_lock(&pool_lock);
+    out->in_use = pool.in_use;
+    out->mapped = pool.mapped;
+    pthread_mutex_unlock(&pool_lock);
+    return 0;
+}
+
+static void mgr_pool_teardown(void) {
+    for (size_t i = 0; i < pool.region_count; ++i) {
+        free(pool.regions[i]);
+    }
+
+    free(pool.regions);
+
+    while (pool.large) {
+        mgr_pool_large *next = pool.large->next;
+
+        free(pool.large);
+        pool.large = next;
+    }
+
+    const uint64_t epoch = pool.epoch + 1;
+
+    memset(&pool, 0, sizeof pool);
+    pool.epoch = epoch;
+}
+
+/*
+    pool-tc: the thread cache in front of the pool
+ */
+
+// moves the n most recent blocks of the calling thread's cache of class cls to the pool
+static void mgr_pool_tc_flush(uint32_t cls, uint32_t n) {
+    pthread_mutex_lock(&pool_lock);
+
+    for (uint32_t i = 0; i < n; ++i) {
+        mgr_pool_block *block = tcache.head[cls];
+
+        tcache.head[cls] = block->next;
+        mgr_pool_give(block, cls);
+    }
+
+    pool.in_use -= n * mgr_class_size(cls);
+    pthread_mutex_unlock(&pool_lock);
+
+    tcache.count[cls] -= n;
+}
+
+static void mgr_pool_tc_release(void *unused) {
+    for (uint32_t cls = 0; cls < MGR_CLASSES; ++cls) {
+        if (tcache.epoch == pool.epoch && tcache.count[cls] > 0) {
+            mgr_pool_tc_flush(cls, tcache.count[cls]);
+        }
+    }
+
+    (void)(unused);
+}
+
+// empties a cache left over from before the last teardown
+static void mgr_pool_tc_check(void) {
+    if (tcache.epoch != pool.epoch) {
+        memset(tcache.head, 0, sizeof tcache.head);
+        memset(tcache.count, 0, sizeof tcache.count);
+        tcache.epoch = pool.epoch;
+    }
+
+    if (tcache.registered == false && tcache_key_created) {
+        // so that the cache goes back to the pool when the thread exits
+        pthread_setspecific(tcache_key, &tcache);
+        tcache.registered = true;
+    }
+}
+
+static void *mgr_pool_tc_malloc(size_t size) {
+    if (size > MGR_CLASS_MAX) {
+        pthread_mutex_lock(&pool_lock);
+        void *ptr = mgr_pool_malloc(size);
+        pthread_mutex_unlock(&pool_lock);
+        return ptr;
+    }
+
+    const uint32_t cls = mgr_class_of(size);
+
+    mgr_pool_tc_check();
+
+    if (tcache.count[cls] == 0) {
+        uint32_t n = 0;
+
+        pthread_mutex_lock(&pool_lock);
+
+        for (; n < MGR_POOL_TC_BATCH; ++n) {
+            mgr_pool_block *block = mgr_pool_take(cls);
+
+            if (block == NULL) {
+                break;
+            }
+
+            block->next = tcache.head[cls];
+            tcache.head[cls] = block;
+        }
+
+        pool.in_use += n * mgr_class_size(cls);     // cached blocks count as in use
+        pthread_mutex_unlock(&pool_lock);
+
+        if (n == 0) {
+            return NULL;
+        }
+
+        tcache.count[cls] = n;
+    }
+
+    mgr_pool_block *block = tcache.head[cls];
+
+    tcache.head[cls] = block->next;
+    --tcache.count[cls];
+    return block;
+}
+
+static void mgr_pool_tc_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    const mgr_pool_slab *slab = mgr_pool_slab_of(ptr);
+
+    if (slab->cls == MGR_POOL_LARGE) {
+        pthread_mutex_lock(&pool_lock);
+        mgr_pool_free(ptr);
+        pthread_mutex_unlock(&pool_lock);
+        return;
+    }
+
+    const uint32_t cls = slab->cls;
+    mgr_pool_block *block = ptr;
+
+    mgr_pool_tc_check();
+
+    block->next = tcache.head[cls];
+    tcache.head[cls] = block;
+
+    if (++tcache.count[cls] > 2 * MGR_POOL_TC_BATCH) {
+        mgr_pool_tc_flush(cls, MGR_POOL_TC_BATCH);
+    }
+}
+
+static void *mgr_pool_tc_realloc(void *ptr, size_t old_size, size_t new_size) {
+    return mgr_pool_resize(ptr, old_size, new_size, mgr_pool_tc_malloc, mgr_pool_tc_free);
+}
+
+static int mgr_pool_tc_init(void) {
+    if (tcache_key_created == false) {
+        if (pthread_key_create(&tcache_key, mgr_pool_tc_release) != 0) {
+            return -1;
+        }
+
+        tcache_key_created = true;
+    }
+
+    return 0;
+}
+
+static void mgr_pool_tc_teardown(void) {
+    mgr_pool_teardown();
+
+    // the calling thread's cache is voided by the new epoch
+    tcache.registered = false;
+    pthread_setspecific(tcache_key, NULL);
+}
+
+/*
+    Heap walk, shared by both variants
+ */
+
+static int mgr_pool_by_address(const void *a, const void *b) {
+    const uintptr_t x = *(const uintptr_t *)(a);
+    const uintptr_t y = *(const uintptr_t *)(b);
+
+    return (x > y) - (x < y);
+}
+
+// addresses of the free blocks: the class lists and the calling thread's cache
+static uintptr_t *mgr_pool_free_blocks(size_t *count) {
+    const bool cached = tcache.epoch == pool.epoch;
+    size_t n = 0;
+
+    for (uint32_t cls = 0; cls < MGR_CLASSES; ++cls) {
+        for (mgr_pool_block *b = pool.head[cls]; b; b = b->next) {
+            ++n;
+        }
+
+        n += cached ? tcache.count[cls] : 0;
+    }
+
+    uintptr_t *addrs = malloc(sizeof *addrs * (n > 0 ? n : 1));
+
+    if (addrs == NULL) {
+        return NULL;
+    }
+
+    n = 0;
+
+    for (uint32_t cls = 0; cls < MGR_CLASSES; ++cls) {
+        for (mgr_pool_block *b = pool.head[cls]; b; b = b->next) {
+            addrs[n++] = (uintptr_t)(b);
+        }
+
+        for (mgr_pool_block *b = cached ? tcache.head[cls] : NULL; b; b = b->next) {
+            addrs[n++] = (uintptr_t)(b);
+        }
+    }
+
+    qsort(addrs, n, sizeof *addrs, mgr_pool_by_address);
+    *count = n;
+    return addrs;
+}
+
+/*
+    Every block of every slab, in address order, free if it is on a
+    free list or in the calling thread's cache; the uncarved part of a
+    class' current slab and the uncut part of the current region are
+    free spans. Large blocks, each in use, follow the regions.
+ */
+static int mgr_pool_walk(mgr_heap_walk *walk) {
+    size_t nfree = 0;
+
+    pthread_mutex_lock(&pool_lock);
+
+    uintptr_t *free_blocks = mgr_pool_free_blocks(&nfree);
+
+    if (free_blocks == NULL) {
+        pthread_mutex_unlock(&pool_lock);
+        return -1;
+    }
+
+    for (size_t r = 0; r < pool.region_count; ++r) {
+        unsigned char *region = pool.regions[r];
+        const bool current = pool.spare_end == region + MGR_POOL_REGION;
+        unsigned char *cut = current ? pool.spare : region + MGR_POOL_REGION;
+
+        for (unsigned char *slab = region; slab < cut; slab += MGR_POOL_SLAB) {
+            const mgr_pool_slab *header = (const mgr_pool_slab *)(slab);
+            const uint32_t cls = header->cls;
+            unsigned char *carved = pool.end[cls] == slab + MGR_POOL_SLAB ? pool.bump[cls] : slab + MGR_POOL_SLAB;
+
+            for (unsigned char *b = slab + MGR_POOL_HEADER; b + header->size <= carved; b += header->size) {
+                const uintptr_t key = (uintptr_t)(b);
+                const bool is_free = bsearch(&key, free_blocks, nfree, sizeof *free_blocks, mgr_pool_by_address) != NULL;
+
+                mgr_heap_block(walk, b, header->size, is_free, cls);
+            }
+
+            if (carved < slab + MGR_POOL_SLAB) {
+                mgr_heap_block(walk, carved, (size_t)(slab + MGR_POOL_SLAB - carved), true, MGR_HEAP_NO_CLASS);
+            }
+        }
+
+        if (current && pool.spare < pool.spare_end) {
+            mgr_heap_block(walk, pool.spare, (size_t)(pool.spare_end - pool.spare), true, MGR_HEAP_NO_CLASS);
+        }
+    }
+
+    for (mgr_pool_large *large = pool.large; large; large = large->next) {
+        mgr_heap_block(walk, (unsigned char *)(large) + MGR_POOL_LARGE_HEADER, large->slab.size, false, MGR_HEAP_NO_CLASS);
+    }
+
+    pthread_mutex_unlock(&pool_lock);
+
+    free(free_blocks);
+    return 0;
+}
+
+const mgr_backend mgr_backend_pool = {
+    .name = "pool",
+    .thread_safe = false,
+    .init_fn = NULL,
+    .teardown_fn = mgr_pool_teardown,
+    .malloc_fn = mgr_pool_malloc,
+    .free_fn = mgr_pool_free,
+    .realloc_fn = mgr_pool_realloc,
+    .calloc_fn = NULL,
+    .aligned_malloc_fn = NULL,
+    .stats_fn = mgr_pool_stats,
+    .usable_size_fn = mgr_pool_usable_size,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+    .walk_fn = mgr_pool_walk
+};
+
+const mgr_backend mgr_backend_pool_tc = {
+    .name = "pool-tc",
+    .thread_safe = true,
+    .init_fn = mgr_pool_tc_init,
+    .teardown_fn = mgr_pool_tc_teardown,
+    .malloc_fn = mgr_pool_tc_malloc,
+    .free_fn = mgr_pool_tc_free,
+    .realloc_fn = mgr_pool_tc_realloc,
+    .calloc_fn = NULL,
+    .aligned_malloc_fn = NULL,
+    .stats_fn = mgr_pool_stats,
+    .usable_size_fn = mgr_pool_usable_size,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+    .walk_fn = mgr_pool_walk
+};
@@ -0,0 +1,119 @@
+/*!
+    \file       mgr_backend_system.c
+    \brief      Source file for the system (libc) malloc allocator backend
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "mgr_alloc.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define MGR_HAVE_MALLINFO2
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define MGR_HAVE_USABLE_SIZE
+#define mgr_system_usable_size malloc_usable_size
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define MGR_HAVE_USABLE_SIZE
+
+static size_t mgr_system_usable_size(void *ptr) {
+    return malloc_size(ptr);
+}
+#endif
+
+static void *mgr_system_realloc(void *ptr, size_t old_size, size_t new_size) {
+    (void)(old_size);
+    return realloc(ptr, new_size);
+}
+
+static void *mgr_system_aligned_malloc(size_t alignment, size_t size) {
+    void *ptr = NULL;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : NULL;
+}
+
+#ifdef __APPLE__
+// the default zone's batch interface; it may hand out fewer blocks than asked
+static size_t mgr_system_batch_malloc(size_t size, void **ptrs, size_t count) {
+    const unsigned n = count < UINT_MAX ? (unsigned)(count) : UINT_MAX;
+    return malloc_zone_batch_malloc(malloc_default_zone(), size, ptrs, n);
+}
+
+static void mgr_system_batch_free(void **ptrs, size_t count) {
+    const unsigned n = count < UINT_MAX ? (unsigned)(count) : UINT_MAX;
+
+    malloc_zone_batch_free(malloc_default_zone(), ptrs, n);
+
+    for (size_t i = n; i < count; ++i) {
+        free(ptrs[i]);
+    }
+}
+#endif
+
+#ifdef MGR_HAVE_MALLINFO2
+static int mgr_system_stats(mgr_backend_stats *out) {
+    const struct mallinfo2 mi = mallinfo2();
+
+    out->in_use = mi.uordblks + mi.hblkhd;
+    out->mapped = mi.arena + mi.hblkhd;
+    return 0;
+}
+
+// glibc cannot be walked block by block: its totals, and its own account of its bins
+static int mgr_system_walk(mgr_heap_walk *walk) {
+    const struct mallinfo2 mi = mallinfo2();
+
+    mgr_heap_totals(walk, mi.uordblks + mi.hblkhd, mi.ordblks + mi.smblks, mi.fordblks + mi.fsmblks);
+
+    if (walk->dest && malloc_info(0, walk->dest) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+#endif
+
+const mgr_backend mgr_backend_system = {
+    .name = "system",
+    .thread_safe = true,
+    .init_fn = NULL,
+    .teardown_fn = NULL,
+    .malloc_fn = malloc,
+    .free_fn = free,
+    .realloc_fn = mgr_system_realloc,
+    .calloc_fn = calloc,
+    .aligned_malloc_fn = mgr_system_aligned_malloc,
+#ifdef MGR_HAVE_MALLINFO2
+    .stats_fn = mgr_system_stats,
+#else
+    .stats_fn = NULL,
+#endif
+#ifdef MGR_HAVE_USABLE_SIZE
+    .usable_size_fn = mgr_system_usable_size,
+#else
+    .usable_size_fn = NULL,
+#endif
+#ifdef __APPLE__
+    .batch_malloc_fn = mgr_system_batch_malloc,
+    .batch_free_fn = mgr_system_batch_free,
+#else
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+#endif
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+#ifdef MGR_HAVE_MALLINFO2
+    .walk_fn = mgr_system_walk
+#else
+    .walk_fn = NULL
+#endif
+};
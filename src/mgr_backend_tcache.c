@@ -0,0 +1,287 @@
+/*!
+    \file       mgr_backend_tcache.c
+    \brief      Source file for the thread-caching front end to cgcs_malloc
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    "cgcs-tc" keeps, per thread and per size class (see mgr_classes.h),
+    a magazine of up to MGR_TCACHE_SLOTS free blocks. Allocations are
+    served from the calling thread's magazine; an empty magazine is
+    refilled with MGR_TCACHE_BATCH blocks from cgcs_malloc, and a full
+    one gives MGR_TCACHE_BATCH back, so cgcs_malloc, which is not
+    thread-safe, is only entered (under a lock) once per batch.
+
+    Every block carries a header with its class and the thread that
+    allocated it. A block freed by another thread joins that thread's
+    magazine, and counts as a remote free. Requests above MGR_CLASS_MAX
+    bypass the magazines.
+
+    A thread's magazines go back to cgcs_malloc when it exits, or, for
+    the thread tearing the backend down, at teardown.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_alloc.h"
+#include "mgr_classes.h"
+
+#include "cgcs_malloc.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+// magazine capacity, per thread and class
+#define MGR_TCACHE_SLOTS 64
+
+// blocks moved between a magazine and cgcs_malloc at once
+#define MGR_TCACHE_BATCH 32
+
+// class of blocks that bypass the magazines
+#define MGR_TCACHE_LARGE UINT32_MAX
+
+typedef struct tc_header {
+    uint32_t cls;           // size class, or MGR_TCACHE_LARGE
+    uint32_t owner;         // thread that allocated the block
+    uint64_t size;          // usable size (bytes)
+} tc_header;
+
+#define MGR_TCACHE_HEADER ((sizeof(tc_header) + MGR_CLASS_QUANTUM - 1) & ~(MGR_CLASS_QUANTUM - 1))
+
+static _Thread_local struct {
+    void *slots[MGR_CLASSES][MGR_TCACHE_SLOTS];     // blocks, past their headers
+    uint32_t count[MGR_CLASSES];
+    uint32_t id;                                    // 0 until the first call
+    bool registered;
+    mgr_cache_stats stats;
+} tc;
+
+// guards cgcs_malloc, the thread ids and the counters of exited threads
+static pthread_mutex_t tc_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t tc_threads = 0;
+static mgr_cache_stats tc_exited;
+
+static pthread_key_t tc_key;
+static bool tc_key_created = false;
+
+static inline tc_header *tc_header_of(void *ptr) {
+    return (tc_header *)((unsigned char *)(ptr) - MGR_TCACHE_HEADER);
+}
+
+// cgcs_malloc for a block of size usable bytes; called with tc_lock held
+static void *tc_cgcs_malloc(uint32_t cls, size_t size) {
+    tc_header *h = cgcs_malloc(MGR_TCACHE_HEADER + size);
+
+    if (h == NULL) {
+        return NULL;
+    }
+
+    h->cls = cls;
+    h->owner = tc.id;
+    h->size = size;
+    return (unsigned char *)(h) + MGR_TCACHE_HEADER;
+}
+
+static void tc_stats_add(mgr_cache_stats *dest, const mgr_cache_stats *src) {
+    dest->hits += src->hits;
+    dest->misses += src->misses;
+    dest->refills += src->refills;
+    dest->returns += src->returns;
+    dest->remote_frees += src->remote_frees;
+}
+
+// gives the n most recently cached blocks of class cls back to cgcs_malloc
+static void tc_return(uint32_t cls, uint32_t n) {
+    pthread_mutex_lock(&tc_lock);
+
+    for (uint32_t i = 0; i < n; ++i) {
+        cgcs_free(tc_header_of(tc.slots[cls][--tc.count[cls]]));
+    }
+
+    pthread_mutex_unlock(&tc_lock);
+    ++tc.stats.returns;
+}
+
+// empties the calling thread's magazines and folds its counters in
+static void tc_release(void *unused) {
+    for (uint32_t cls = 0; cls < MGR_CLASSES; ++cls) {
+        if (tc.count[cls] > 0) {
+            tc_return(cls, tc.count[cls]);
+        }
+    }
+
+    pthread_mutex_lock(&tc_lock);
+    tc_stats_add(&tc_exited, &tc.stats);
+    pthread_mutex_unlock(&tc_lock);
+
+    memset(&tc.stats, 0, sizeof tc.stats);
+    tc.registered = false;
+    (void)(unused);
+}
+
+static void tc_register(void) {
+    pthread_mutex_lock(&tc_lock);
+    tc.id = ++tc_threads;
+    pthread_mutex_unlock(&tc_lock);
+
+    // so that the magazines go back to cgcs_malloc when the thread exits
+    pthread_setspecific(tc_key, &tc);
+    tc.registered = true;
+}
+
+static void *mgr_tcache_malloc(size_t size) {
+    if (tc.registered == false) {
+        tc_register();
+    }
+
+    if (size > MGR_CLASS_MAX) {
+        pthread_mutex_lock(&tc_lock);
+        void *ptr = tc_cgcs_malloc(MGR_TCACHE_LARGE, size);
+        pthread_mutex_unlock(&tc_lock);
+
+        ++tc.stats.misses;
+        return ptr;
+    }
+
+    const uint32_t cls = mgr_class_of(size);
+
+    if (tc.count[cls] > 0) {
+        ++tc.stats.hits;
+        return tc.slots[cls][--tc.count[cls]];
+    }
+
+    const size_t class_size = mgr_class_size(cls);
+
+    pthread_mutex_lock(&tc_lock);
+
+    for (uint32_t i = 0; i < MGR_TCACHE_BATCH; ++i) {
+        void *ptr = tc_cgcs_malloc(cls, class_size);
+
+        if (ptr == NULL) {
+            break;
+        }
+
+        tc.slots[cls][tc.count[cls]++] = ptr;
+    }
+
+    pthread_mutex_unlock(&tc_lock);
+
+    ++tc.stats.misses;
+    ++tc.stats.refills;
+
+    return tc.count[cls] > 0 ? tc.slots[cls][--tc.count[cls]] : NULL;
+}
+
+static void mgr_tcache_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    if (tc.registered == false) {
+        tc_register();
+    }
+
+    tc_header *h = tc_header_of(ptr);
+
+    if (h->owner != tc.id) {
+        h->owner = tc.id;               // it is this thread's to hand out now
+        ++tc.stats.remote_frees;
+    }
+
+    if (h->cls == MGR_TCACHE_LARGE) {
+        pthread_mutex_lock(&tc_lock);
+        cgcs_free(h);
+        pthread_mutex_unlock(&tc_lock);
+        return;
+    }
+
+    if (tc.count[h->cls] == MGR_TCACHE_SLOTS) {
+        tc_return(h->cls, MGR_TCACHE_BATCH);
+    }
+
+    tc.slots[h->cls][tc.count[h->cls]++] = ptr;
+}
+
+static void *mgr_tcache_realloc(void *ptr, size_t old_size, size_t new_size) {
+    if (ptr && new_size > 0 && new_size <= tc_header_of(ptr)->size) {
+        const tc_header *h = tc_header_of(ptr);
+
+        // stays in place unless a smaller class would fit
+        if (h->cls == MGR_TCACHE_LARGE ? new_size > MGR_CLASS_MAX : mgr_class_of(new_size) == h->cls) {
+            return ptr;
+        }
+    }
+
+    if (ptr == NULL) {
+        return mgr_tcache_malloc(new_size);
+    }
+
+    if (new_size == 0) {
+        mgr_tcache_free(ptr);
+        return NULL;
+    }
+
+    void *res = mgr_tcache_malloc(new_size);
+
+    if (res) {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+        mgr_tcache_free(ptr);
+    }
+
+    return res;
+}
+
+static size_t mgr_tcache_usable_size(void *ptr) {
+    return ptr ? tc_header_of(ptr)->size : 0;
+}
+
+static int mgr_tcache_cache_stats(mgr_cache_stats *out) {
+    pthread_mutex_lock(&tc_lock);
+    *out = tc_exited;
+    pthread_mutex_unlock(&tc_lock);
+
+    tc_stats_add(out, &tc.stats);
+    return 0;
+}
+
+static int mgr_tcache_init(void) {
+    if (tc_key_created == false) {
+        if (pthread_key_create(&tc_key, tc_release) != 0) {
+            return -1;
+        }
+
+        tc_key_created = true;
+    }
+
+    memset(&tc_exited, 0, sizeof tc_exited);
+    memset(&tc.stats, 0, sizeof tc.stats);
+    return 0;
+}
+
+static void mgr_tcache_teardown(void) {
+    if (tc.registered) {
+        tc_release(NULL);
+        pthread_setspecific(tc_key, NULL);
+    }
+}
+
+const mgr_backend mgr_backend_cgcs_tc = {
+    .name = "cgcs-tc",
+    .thread_safe = true,
+    .init_fn = mgr_tcache_init,
+    .teardown_fn = mgr_tcache_teardown,
+    .malloc_fn = mgr_tcache_malloc,
+    .free_fn = mgr_tcache_free,
+    .realloc_fn = mgr_tcache_realloc,
+    .calloc_fn = NULL,
+    .aligned_malloc_fn = NULL,
+    .stats_fn = NULL,
+    .usable_size_fn = mgr_tcache_usable_size,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = mgr_tcache_cache_stats,
+    .walk_fn = NULL
+};
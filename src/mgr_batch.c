@@ -0,0 +1,72 @@
+/*!
+    \file       mgr_batch.c
+    \brief      Source file for the memgrind_c batch allocation workload
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_alloc.h"
+#include "mgr_workload.h"
+
+/*!
+    \brief  Test k:
+            allocate blocks in bursts, then free them in bursts
+
+    \details    count blocks of size bytes are allocated batch at a
+                time and written to, then freed batch at a time.
+                With batch 1, every block is its own mgr_malloc and
+                mgr_free call; above that, every burst is one
+                mgr_malloc_batch and one mgr_free_batch call, so
+                sweeping k.batch shows what batching saves.
+
+    \param[in]  count   blocks
+    \param[in]  size    block size (bytes)
+    \param[in]  batch   blocks per burst (0 counts as 1)
+ */
+void mgr_batch_alloc(uint32_t count, uint32_t size, uint32_t batch) {
+    void **blocks = mgr_malloc(sizeof *blocks * (count > 0 ? count : 1));
+    uint32_t allocated = 0;
+
+    if (blocks == NULL) {
+        return;
+    }
+
+    batch = batch > 0 ? batch : 1;
+
+    while (allocated < count) {
+        const uint32_t n = count - allocated < batch ? count - allocated : batch;
+        uint32_t got = 0;
+
+        if (batch == 1) {
+            blocks[allocated] = mgr_malloc(size);
+            got = blocks[allocated] ? 1 : 0;
+        } else {
+            got = (uint32_t)(mgr_malloc_batch(size, blocks + allocated, n));
+        }
+
+        for (uint32_t i = 0; size > 0 && i < got; ++i) {
+            *(char *)(blocks[allocated + i]) = (char)(i);
+        }
+
+        allocated += got;
+
+        if (got < n) {
+            break;          // out of memory
+        }
+    }
+
+    for (uint32_t freed = 0; freed < allocated; freed += batch) {
+        const uint32_t n = allocated - freed < batch ? allocated - freed : batch;
+
+        if (batch == 1) {
+            mgr_free(blocks[freed]);
+        } else {
+            mgr_free_batch(blocks + freed, n);
+        }
+    }
+
+    mgr_free(blocks);
+}
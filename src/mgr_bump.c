@@ -0,0 +1,122 @@
+/*!
+    \file       mgr_bump.c
+    \brief      Source file for the bump pointer regions of the arena
+                and null backends
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_bump.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// moves to the next chunk that fits size bytes, linking in a new one if none does
+static int mgr_bump_grow(mgr_bump *b, size_t size) {
+    mgr_bump_chunk *chunk = b->current ? b->current->next : b->head;
+
+    while (chunk && chunk->size < size) {
+        chunk = chunk->next;            // skipped until the next rewind
+    }
+
+    if (chunk == NULL) {
+        const size_t bytes = size > b->chunk_size ? size : b->chunk_size;
+
+        chunk = malloc(sizeof *chunk + bytes);
+
+        if (chunk == NULL) {
+            return -1;
+        }
+
+        chunk->size = bytes;
+        b->mapped += bytes;
+
+        if (b->current) {
+            chunk->next = b->current->next;
+            b->current->next = chunk;
+        } else {
+            chunk->next = b->head;
+            b->head = chunk;
+        }
+    }
+
+    b->current = chunk;
+    b->bump = chunk->data;
+    b->end = chunk->data + chunk->size;
+    return 0;
+}
+
+/*!
+    \brief  Carves a block out of a region
+
+    \details    The block is rounded up to MGR_BUMP_ALIGN bytes, so
+                the bump pointer stays aligned. For a larger alignment,
+                the bump pointer skips ahead to the next multiple of
+                it; the bytes skipped count as in use until the region
+                rewinds.
+
+    \param[in]  b           region
+    \param[in]  alignment   a power of two
+    \param[in]  size        block size (bytes)
+
+    \return     the block, which ends at b->bump, or NULL if
+                out of memory
+ */
+void *mgr_bump_alloc(mgr_bump *b, size_t alignment, size_t size) {
+    const size_t align = alignment > MGR_BUMP_ALIGN ? alignment : MGR_BUMP_ALIGN;
+    const size_t bytes = size > 0 ? (size + MGR_BUMP_ALIGN - 1) & ~(MGR_BUMP_ALIGN - 1) : MGR_BUMP_ALIGN;
+
+    if (bytes < size || bytes > SIZE_MAX - align) {
+        return NULL;                    // overflow
+    }
+
+    size_t pad = b->bump ? (size_t)(-(uintptr_t)(b->bump) & (align - 1)) : 0;
+
+    if (b->bump == NULL || (size_t)(b->end - b->bump) < pad + bytes) {
+        // chunks are MGR_BUMP_ALIGN-byte aligned: room for the worst padding too
+        if (mgr_bump_grow(b, bytes + align - MGR_BUMP_ALIGN) != 0) {
+            return NULL;
+        }
+
+        pad = (size_t)(-(uintptr_t)(b->bump) & (align - 1));
+    }
+
+    unsigned char *ptr = b->bump + pad;
+
+    b->bump = ptr + bytes;
+    b->in_use += pad + bytes;
+
+    return ptr;
+}
+
+/*!
+    \brief  Moves a region back to its first chunk, in O(1)
+
+    \param[in]  b   region
+ */
+void mgr_bump_rewind(mgr_bump *b) {
+    b->current = b->head;
+    b->bump = b->head ? b->head->data : NULL;
+    b->end = b->head ? b->head->data + b->head->size : NULL;
+    b->in_use = 0;
+}
+
+/*!
+    \brief  Returns every chunk of a region to the C library
+
+    \param[in]  b   region
+ */
+void mgr_bump_release(mgr_bump *b) {
+    while (b->head) {
+        mgr_bump_chunk *next = b->head->next;
+        free(b->head);
+        b->head = next;
+    }
+
+    b->current = NULL;
+    b->mapped = 0;
+    mgr_bump_rewind(b);
+}
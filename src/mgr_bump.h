@@ -0,0 +1,46 @@
+/*!
+    \file       mgr_bump.h
+    \brief      Header file for the bump pointer regions of the arena
+                and null backends
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Blocks are carved from a list of chunks by bumping a pointer; a
+    chunk is chunk_size bytes, or larger for larger requests. Rewinding
+    moves back to the first chunk in O(1); chunks are kept for reuse
+    and returned to the C library by mgr_bump_release.
+ */
+
+#ifndef MGR_BUMP_H
+#define MGR_BUMP_H
+
+#include <stddef.h>
+
+// block alignment, as malloc's
+#define MGR_BUMP_ALIGN ((size_t)(16))
+
+typedef struct mgr_bump_chunk {
+    struct mgr_bump_chunk *next;
+    size_t size;                        // bytes after the header
+    _Alignas(16) unsigned char data[];
+} mgr_bump_chunk;
+
+typedef struct mgr_bump {
+    size_t chunk_size;                  // default chunk size
+
+    mgr_bump_chunk *head;
+    mgr_bump_chunk *current;
+    unsigned char *bump;
+    unsigned char *end;
+
+    size_t in_use;                      // bytes bumped since the last rewind
+    size_t mapped;                      // bytes in chunks
+} mgr_bump;
+
+void *mgr_bump_alloc(mgr_bump *b, size_t alignment, size_t size);
+void mgr_bump_rewind(mgr_bump *b);
+void mgr_bump_release(mgr_bump *b);
+
+#endif /* MGR_BUMP_H */
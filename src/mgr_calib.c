@@ -0,0 +1,134 @@
+/*!
+    \file       mgr_calib.c
+    \brief      Source file for memgrind_c harness overhead calibration
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_calib.h"
+#include "mgr_stats.h"
+
+#include "cgcs_ulog.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MGR_HAVE_TSC 1
+#else
+#define MGR_HAVE_TSC 0
+#endif
+
+// back-to-back timer reads per cost estimate
+#define MGR_CALIB_READS (1u << 16)
+
+// time the tsc is counted against the monotonic clock (ns)
+#define MGR_CALIB_TSC_NS UINT64_C(20000000)
+
+#if MGR_HAVE_TSC
+// CPUID.80000007H:EDX[8]: the tsc rate does not change with P-, C- or T-states
+static bool mgr_tsc_invariant(void) {
+    unsigned a = 0, b = 0, c = 0, d = 0;
+
+    if (__get_cpuid_max(0x80000000u, NULL) < 0x80000007u) {
+        return false;
+    }
+
+    __get_cpuid(0x80000007u, &a, &b, &c, &d);
+    return (d & (1u << 8)) != 0;
+}
+#endif
+
+/*!
+    \brief  Measures the cost and resolution of the monotonic clock,
+            and the rate and cost of the time stamp counter
+
+    \details    Takes about MGR_CALIB_TSC_NS where there is a tsc.
+
+    \param[out] out     timer figures
+ */
+void mgr_timer_calibrate(mgr_timer_info *out) {
+    struct timespec res = { 0, 0 };
+    uint64_t step = UINT64_MAX;
+
+    clock_getres(CLOCK_MONOTONIC, &res);
+    out->clock_res_ns = (double)(res.tv_sec) * 1e9 + (double)(res.tv_nsec);
+
+    const uint64_t first = mgr_clock_ns();
+    uint64_t last = first;
+
+    for (uint32_t i = 0; i < MGR_CALIB_READS; ++i) {
+        const uint64_t now = mgr_clock_ns();
+
+        if (now > last && now - last < step) {
+            step = now - last;
+        }
+
+        last = now;
+    }
+
+    out->clock_cost_ns = (double)(last - first) / MGR_CALIB_READS;
+    out->clock_step_ns = step == UINT64_MAX ? 0.0 : (double)(step);
+
+    out->tsc = false;
+    out->tsc_invariant = false;
+    out->tsc_ghz = 0.0;
+    out->tsc_cost_ns = 0.0;
+
+#if MGR_HAVE_TSC
+    const uint64_t t0 = mgr_clock_ns();
+    const uint64_t c0 = __rdtsc();
+    uint64_t t1 = t0;
+
+    while (t1 - t0 < MGR_CALIB_TSC_NS) {
+        t1 = mgr_clock_ns();
+    }
+
+    const uint64_t c1 = __rdtsc();
+
+    out->tsc = c1 > c0;
+    out->tsc_invariant = mgr_tsc_invariant();
+    out->tsc_ghz = (double)(c1 - c0) / (double)(t1 - t0);
+
+    uint64_t sink = 0;
+    const uint64_t x = __rdtsc();
+
+    for (uint32_t i = 0; i < MGR_CALIB_READS; ++i) {
+        sink ^= __rdtsc();
+    }
+
+    const uint64_t y = __rdtsc();
+
+    if (out->tsc && out->tsc_ghz > 0.0) {
+        out->tsc_cost_ns = (double)(y - x) / MGR_CALIB_READS / out->tsc_ghz;
+    }
+
+    (void)(sink);
+#endif
+}
+
+/*!
+    \brief  Outputs the timer figures
+
+    \param[in]  dest    destination file stream
+    \param[in]  t       timer figures
+ */
+void mgr_timer_fprint(FILE *dest, const mgr_timer_info *t) {
+    fprintf(dest, "\n%s\n\n", KGRN_b"timer calibration"KNRM);
+
+    fprintf(dest, "  %-18s\t%s %.1lf ns\t%s %.0lf ns\t%s %.0lf ns\n", "monotonic clock",
+            "cost", t->clock_cost_ns, "resolution", t->clock_res_ns, "smallest step", t->clock_step_ns);
+
+    if (t->tsc) {
+        fprintf(dest, "  %-18s\t%s %.1lf ns\t%s %.3lf GHz\t%s\n", "rdtsc",
+                "cost", t->tsc_cost_ns, "rate", t->tsc_ghz,
+                t->tsc_invariant ? "invariant" : "not invariant");
+    } else {
+        fprintf(dest, "  %-18s\t%s\n", "rdtsc", "unavailable");
+    }
+}
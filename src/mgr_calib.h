@@ -0,0 +1,43 @@
+/*!
+    \file       mgr_calib.h
+    \brief      Header file for memgrind_c harness overhead calibration
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    A timed repetition also counts the clock reads around it and the
+    workload's own work (random draws, string fills, vector
+    bookkeeping). With --calibrate, every test is first measured on the
+    null backend (see mgr_backend_null.c), whose calls cost next to
+    nothing; its mean is the harness time, and the mean on the real
+    backend minus it the time attributable to the allocator.
+
+    The cost and resolution of the clock, and of the time stamp counter
+    where there is one, are measured once and printed with the run.
+ */
+
+#ifndef MGR_CALIB_H
+#define MGR_CALIB_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/*!
+    \brief  Cost and resolution of the timers a run could use
+ */
+typedef struct mgr_timer_info {
+    double clock_cost_ns;       // one mgr_clock_ns call
+    double clock_res_ns;        // as clock_getres reports it
+    double clock_step_ns;       // smallest nonzero step between two calls
+
+    bool tsc;                   // rdtsc is available (x86)
+    bool tsc_invariant;         // ticks at a constant rate, in every power state
+    double tsc_ghz;             // ticks per ns, against the monotonic clock
+    double tsc_cost_ns;         // one rdtsc
+} mgr_timer_info;
+
+void mgr_timer_calibrate(mgr_timer_info *out);
+void mgr_timer_fprint(FILE *dest, const mgr_timer_info *t);
+
+#endif /* MGR_CALIB_H */
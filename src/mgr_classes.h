@@ -0,0 +1,60 @@
+/*!
+    \file       mgr_classes.h
+    \brief      Header file for the size classes of the memgrind_c caching backends
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Requests of up to MGR_CLASS_MAX bytes are rounded up to one of
+    MGR_CLASSES size classes: MGR_CLASS_QUANTUM bytes apart up to
+    MGR_CLASS_LINEAR_MAX bytes, then four per doubling, so a block
+    wastes at most a quarter of its size above that.
+ */
+
+#ifndef MGR_CLASSES_H
+#define MGR_CLASSES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MGR_CLASS_QUANTUM ((size_t)(16))
+#define MGR_CLASS_LINEAR_MAX ((size_t)(256))
+#define MGR_CLASS_MAX ((size_t)(16384))
+#define MGR_CLASSES 40
+
+/*!
+    \brief  Size class of a request
+
+    \param[in]  size    request, at most MGR_CLASS_MAX bytes
+
+    \return     class, in [0, MGR_CLASSES)
+ */
+static inline uint32_t mgr_class_of(size_t size) {
+    if (size <= MGR_CLASS_LINEAR_MAX) {
+        return size > 0 ? (uint32_t)((size - 1) / MGR_CLASS_QUANTUM) : 0;
+    }
+
+    const unsigned msb = 63u - (unsigned)(__builtin_clzll((unsigned long long)(size - 1)));
+
+    return (uint32_t)(16 + ((msb - 8) * 4) + ((size - 1) >> (msb - 2)) - 4);
+}
+
+/*!
+    \brief  Block size of a size class
+
+    \param[in]  cls     class, in [0, MGR_CLASSES)
+
+    \return     largest request of the class (bytes)
+ */
+static inline size_t mgr_class_size(uint32_t cls) {
+    if (cls < 16) {
+        return (cls + 1) * MGR_CLASS_QUANTUM;
+    }
+
+    const unsigned msb = 8 + ((cls - 16) / 4);
+
+    return ((size_t)(1) << msb) + ((((cls - 16) % 4) + 1) * ((size_t)(1) << (msb - 2)));
+}
+
+#endif /* MGR_CLASSES_H */
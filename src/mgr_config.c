@@ -0,0 +1,847 @@
+/*!
+    \file       mgr_config.c
+    \brief      Source file for memgrind_c command-line and config file options
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_config.h"
+#include "mgr_thread.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// timed repetitions per test (every repetition is one sample)
+#define MGR_MAX_ITER 100
+
+// untimed repetitions per test, run first to warm caches and the heap
+#define MGR_WARMUP_ITER 10
+
+// producer/consumer pairs, blocks handed over per pair, block sizes
+#define MGR_XFREE_PAIRS 1
+#define MGR_XFREE_COUNT 100000
+#define MGR_XFREE_ALLOC_MIN 16
+#define MGR_XFREE_ALLOC_MAX 256
+
+// remote free: producer and consumer threads, blocks per producer
+#define MGR_REMOTE_PRODUCERS 4
+#define MGR_REMOTE_CONSUMERS 1
+#define MGR_REMOTE_COUNT 100000
+
+// soak: live bytes, object sizes, run time (s) and reporting window (ms)
+#define MGR_SOAK_BYTES ((uint64_t)(256) << 20)
+#define MGR_SOAK_ALLOC_MIN 16
+#define MGR_SOAK_ALLOC_MAX 1024
+#define MGR_SOAK_SECONDS 10.0
+#define MGR_SOAK_WINDOW_MS 1000
+#define MGR_SOAK_LIFETIME MGR_LIFETIME_PARETO
+
+// numa: blocks per pair of nodes, block size, chases over the blocks
+#define MGR_NUMA_COUNT (1 << 20)
+#define MGR_NUMA_SIZE 64
+#define MGR_NUMA_PASSES 2
+
+// frag: live byte budget and rounds per pattern
+#define MGR_FRAG_BYTES ((uint64_t)(32) << 20)
+#define MGR_FRAG_ROUNDS 8
+
+// significance level and smallest median change (%) that --diff reports
+#define MGR_DIFF_ALPHA 0.01
+#define MGR_DIFF_THRESHOLD 5.0
+
+// most config files open at once, through "config" lines
+#define MGR_CONFIG_DEPTH_MAX 8
+
+/*
+    Options that take no value on the command line
+    (in a config file they take 0/1, true/false, on/off).
+ */
+static const char *const mgr_flags[] = { "align", "calibrate", "frag", "heap", "matrix", "memory", "numa", "op-latency", "perf", "rand-tape", "soak", NULL };
+
+/*
+    Short options, and the key each stands for.
+ */
+static const struct {
+    char opt;
+    const char *key;
+} mgr_short_opts[] = {
+    { 'b', "backend" },
+    { 'c', "config" },
+    { 'n', "reps" },
+    { 's', "seed" },
+    { 't', "tests" },
+    { 'w', "warmup" },
+    { '\0', NULL }
+};
+
+/*!
+    \brief  Initializes a configuration to the built-in defaults
+
+    \param[out] cfg configuration
+ */
+void mgr_config_init(mgr_config *cfg) {
+    memset(cfg, 0, sizeof *cfg);
+
+    cfg->warmup = MGR_WARMUP_ITER;
+    cfg->reps = MGR_MAX_ITER;
+
+    cfg->xfree_pairs = MGR_XFREE_PAIRS;
+    cfg->xfree_count = MGR_XFREE_COUNT;
+    cfg->xfree_min = MGR_XFREE_ALLOC_MIN;
+    cfg->xfree_max = MGR_XFREE_ALLOC_MAX;
+
+    cfg->remote_producers = MGR_REMOTE_PRODUCERS;
+    cfg->remote_consumers = MGR_REMOTE_CONSUMERS;
+    cfg->remote_count = MGR_REMOTE_COUNT;
+
+    cfg->diff_alpha = MGR_DIFF_ALPHA;
+    cfg->diff_threshold = MGR_DIFF_THRESHOLD / 100.0;
+
+    mgr_matrix_defaults(&cfg->matrix_grid);
+
+    cfg->frag_opts.bytes = MGR_FRAG_BYTES;
+    cfg->frag_opts.rounds = MGR_FRAG_ROUNDS;
+    cfg->frag_opts.patterns = MGR_FRAG_ALL;
+
+    mgr_align_defaults(&cfg->align_opts);
+
+    cfg->soak_opts.bytes = MGR_SOAK_BYTES;
+    cfg->soak_opts.min = MGR_SOAK_ALLOC_MIN;
+    cfg->soak_opts.max = MGR_SOAK_ALLOC_MAX;
+    cfg->soak_opts.seconds = MGR_SOAK_SECONDS;
+    cfg->soak_opts.window_ms = MGR_SOAK_WINDOW_MS;
+    cfg->soak_opts.lifetime = MGR_SOAK_LIFETIME;
+
+    cfg->numa_opts.count = MGR_NUMA_COUNT;
+    cfg->numa_opts.size = MGR_NUMA_SIZE;
+    cfg->numa_opts.passes = MGR_NUMA_PASSES;
+}
+
+/*!
+    \brief  Releases the strings held by a configuration
+
+    \param[in]  cfg configuration
+ */
+void mgr_config_deinit(mgr_config *cfg) {
+    free(cfg->backend);
+    free(cfg->compare);
+    free(cfg->trace_record);
+    free(cfg->trace_replay);
+    free(cfg->workload);
+    free(cfg->heap_dump);
+    free(cfg->json);
+    free(cfg->csv);
+    free(cfg->diff);
+
+    cfg->backend = NULL;
+    cfg->compare = NULL;
+    cfg->trace_record = NULL;
+    cfg->trace_replay = NULL;
+    cfg->workload = NULL;
+    cfg->heap_dump = NULL;
+    cfg->json = NULL;
+    cfg->csv = NULL;
+    cfg->diff = NULL;
+}
+
+/*!
+    \brief  Looks up a test by its letter
+
+    \param[in]  tests   test table, terminated by a NULL test
+    \param[in]  tch     test letter
+
+    \return     the test, or NULL if there is none
+ */
+mgr_test *mgr_test_find(mgr_test *tests, char tch) {
+    for (mgr_test *t = tests; t->test; ++t) {
+        if (t->tch == tch) {
+            return t;
+        }
+    }
+
+    return NULL;
+}
+
+static int parse_u64(const char *key, const char *value, uint64_t *out) {
+    char *end = NULL;
+
+    errno = 0;
+    const unsigned long long n = strtoull(value, &end, 0);
+
+    if (errno != 0 || end == value || *end != '\0' || *value == '-') {
+        fprintf(stderr, "memgrind: %s: '%s' is not a nonnegative integer\n", key, value);
+        return -1;
+    }
+
+    *out = (uint64_t)(n);
+    return 0;
+}
+
+static int parse_u32(const char *key, const char *value, uint32_t *out) {
+    uint64_t n = 0;
+
+    if (parse_u64(key, value, &n) != 0) {
+        return -1;
+    }
+
+    if (n > UINT32_MAX) {
+        fprintf(stderr, "memgrind: %s: '%s' is out of range\n", key, value);
+        return -1;
+    }
+
+    *out = (uint32_t)(n);
+    return 0;
+}
+
+static int parse_double(const char *key, const char *value, double *out) {
+    char *end = NULL;
+
+    errno = 0;
+    const double d = strtod(value, &end);
+
+    if (errno != 0 || end == value || *end != '\0' || d < 0.0) {
+        fprintf(stderr, "memgrind: %s: '%s' is not a nonnegative number\n", key, value);
+        return -1;
+    }
+
+    *out = d;
+    return 0;
+}
+
+// a byte count, optionally suffixed K, M or G (binary)
+static int parse_bytes(const char *key, const char *value, uint64_t *out) {
+    char *end = NULL;
+
+    errno = 0;
+    const unsigned long long n = strtoull(value, &end, 10);
+    const char *units = "KMG";
+    const char *unit = *end ? strchr(units, *end) : NULL;
+
+    if (errno != 0 || end == value || *value == '-' ||
+        (*end != '\0' && (unit == NULL || end[1] != '\0'))) {
+        fprintf(stderr, "memgrind: %s: '%s' is not a byte count (e.g. 512M)\n", key, value);
+        return -1;
+    }
+
+    const int shift = unit ? 10 * (int)(unit - units + 1) : 0;
+
+    if (n > (UINT64_MAX >> shift)) {
+        fprintf(stderr, "memgrind: %s: '%s' is out of range\n", key, value);
+        return -1;
+    }
+
+    *out = (uint64_t)(n) << shift;
+    return 0;
+}
+
+static int parse_bool(const char *key, const char *value, bool *out) {
+    if (strcmp(value, "1") == 0 || strcmp(value, "true") == 0 || strcmp(value, "on") == 0) {
+        *out = true;
+    } else if (strcmp(value, "0") == 0 || strcmp(value, "false") == 0 || strcmp(value, "off") == 0) {
+        *out = false;
+    } else {
+        fprintf(stderr, "memgrind: %s: '%s' is not a boolean\n", key, value);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int set_string(char **dst, const char *value) {
+    char *copy = strdup(value);
+
+    if (copy == NULL) {
+        return -1;
+    }
+
+    free(*dst);
+    *dst = copy;
+    return 0;
+}
+
+/*
+    Resolves "d.max" to test d and the index of its parameter named max.
+ */
+static int parse_test_param(mgr_test *tests, const char *key, mgr_test **test, int *param) {
+    if (key[0] == '\0' || key[1] != '.') {
+        return -1;
+    }
+
+    mgr_test *t = mgr_test_find(tests, key[0]);
+
+    if (t == NULL) {
+        return -1;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        if (t->params[i] && strcmp(t->params[i], key + 2) == 0) {
+            *test = t;
+            *param = i;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/*
+    "KEY=FIRST:LAST[:STEP]", where STEP is "*N" (geometric) or "+N"
+    (arithmetic); the default step is *2.
+ */
+static int parse_sweep(mgr_config *cfg, mgr_test *tests, const char *value) {
+    char buffer[128];
+    mgr_test *t = NULL;
+    mgr_sweep sw = { '\0', 0, 0, 0, 2, true };
+
+    snprintf(buffer, sizeof buffer, "%s", value);
+
+    char *range = strchr(buffer, '=');
+    char *last = range ? strchr(range + 1, ':') : NULL;
+    char *step = last ? strchr(last + 1, ':') : NULL;
+
+    if (range == NULL || last == NULL) {
+        fprintf(stderr, "memgrind: sweep: '%s' is not KEY=FIRST:LAST[:STEP]\n", value);
+        return -1;
+    }
+
+    *range++ = '\0';
+    *last++ = '\0';
+
+    if (step) {
+        *step++ = '\0';
+    }
+
+    if (parse_test_param(tests, buffer, &t, &sw.param) != 0) {
+        fprintf(stderr, "memgrind: sweep: unknown test parameter '%s'\n", buffer);
+        return -1;
+    }
+
+    if (parse_u32("sweep", range, &sw.first) != 0 || parse_u32("sweep", last, &sw.last) != 0) {
+        return -1;
+    }
+
+    if (step) {
+        if (*step != '*' && *step != '+') {
+            fprintf(stderr, "memgrind: sweep: step '%s' is not *N or +N\n", step);
+            return -1;
+        }
+
+        sw.geometric = *step == '*';
+
+        if (parse_u32("sweep", step + 1, &sw.step) != 0) {
+            return -1;
+        }
+    }
+
+    if (sw.first > sw.last || (sw.geometric ? (sw.step < 2 || sw.first == 0) : sw.step == 0)) {
+        fprintf(stderr, "memgrind: sweep: '%s' never reaches its last value\n", value);
+        return -1;
+    }
+
+    if (cfg->nsweeps == MGR_SWEEP_MAX) {
+        fprintf(stderr, "memgrind: sweep: at most %d sweeps\n", MGR_SWEEP_MAX);
+        return -1;
+    }
+
+    sw.tch = t->tch;
+    cfg->sweeps[cfg->nsweeps++] = sw;
+    return 0;
+}
+
+/*!
+    \brief  Applies one option
+
+    \param[in]  cfg     configuration
+    \param[in]  tests   test table, terminated by a NULL test
+    \param[in]  key     option key, e.g. "reps" or "d.max"
+    \param[in]  value   option value
+
+    \return     0 on success, -1 if the key or value is invalid
+                (reported on stderr)
+ */
+int mgr_config_set(mgr_config *cfg, mgr_test *tests, const char *key, const char *value) {
+    mgr_test *t = NULL;
+    int param = 0;
+
+    if (strcmp(key, "config") == 0) {
+        return mgr_config_load(cfg, tests, value);
+    } else if (strcmp(key, "tests") == 0) {
+        for (const char *c = value; *c; ++c) {
+            if (mgr_test_find(tests, *c) == NULL) {
+                fprintf(stderr, "memgrind: tests: no test '%c'\n", *c);
+                return -1;
+            }
+        }
+
+        for (t = tests; t->test; ++t) {
+            t->enabled = strchr(value, t->tch) != NULL;
+        }
+
+        return 0;
+    } else if (strcmp(key, "reps") == 0) {
+        const int status = parse_u32(key, value, &cfg->reps);
+
+        if (status == 0 && cfg->reps == 0) {
+            fprintf(stderr, "memgrind: reps: must be at least 1\n");
+            return -1;
+        }
+
+        return status;
+    } else if (strcmp(key, "warmup") == 0) {
+        return parse_u32(key, value, &cfg->warmup);
+    } else if (strcmp(key, "seed") == 0) {
+        cfg->seed_set = true;
+        return parse_u64(key, value, &cfg->seed);
+    } else if (strcmp(key, "rand-tape") == 0) {
+        return parse_bool(key, value, &cfg->rand_tape);
+    } else if (strcmp(key, "op-latency") == 0) {
+        return parse_bool(key, value, &cfg->op_latency);
+    } else if (strcmp(key, "perf") == 0) {
+        return parse_bool(key, value, &cfg->perf);
+    } else if (strcmp(key, "memory") == 0) {
+        return parse_bool(key, value, &cfg->memory);
+    } else if (strcmp(key, "calibrate") == 0) {
+        return parse_bool(key, value, &cfg->calibrate);
+    } else if (strcmp(key, "heap") == 0) {
+        return parse_bool(key, value, &cfg->heap);
+    } else if (strcmp(key, "heap-dump") == 0) {
+        cfg->heap = true;
+        return set_string(&cfg->heap_dump, value);
+    } else if (strcmp(key, "threads") == 0) {
+        if (strcmp(value, "all") == 0) {
+            cfg->threads = mgr_cpu_count();
+            return 0;
+        }
+
+        return parse_u32(key, value, &cfg->threads);
+    } else if (strcmp(key, "xfree.pairs") == 0) {
+        return parse_u32(key, value, &cfg->xfree_pairs);
+    } else if (strcmp(key, "xfree.count") == 0) {
+        return parse_u32(key, value, &cfg->xfree_count);
+    } else if (strcmp(key, "xfree.min") == 0) {
+        return parse_u32(key, value, &cfg->xfree_min);
+    } else if (strcmp(key, "xfree.max") == 0) {
+        return parse_u32(key, value, &cfg->xfree_max);
+    } else if (strcmp(key, "remote.producers") == 0) {
+        return parse_u32(key, value, &cfg->remote_producers);
+    } else if (strcmp(key, "remote.consumers") == 0) {
+        return parse_u32(key, value, &cfg->remote_consumers);
+    } else if (strcmp(key, "remote.count") == 0) {
+        return parse_u32(key, value, &cfg->remote_count);
+    } else if (strcmp(key, "backend") == 0) {
+        return set_string(&cfg->backend, value);
+    } else if (strcmp(key, "compare") == 0) {
+        return set_string(&cfg->compare, value);
+    } else if (strcmp(key, "trace-record") == 0) {
+        return set_string(&cfg->trace_record, value);
+    } else if (strcmp(key, "trace-replay") == 0) {
+        return set_string(&cfg->trace_replay, value);
+    } else if (strcmp(key, "workload") == 0) {
+        return set_string(&cfg->workload, value);
+    } else if (strcmp(key, "json") == 0) {
+        return set_string(&cfg->json, value);
+    } else if (strcmp(key, "csv") == 0) {
+        return set_string(&cfg->csv, value);
+    } else if (strcmp(key, "diff") == 0) {
+        if (strchr(value, ',') == NULL) {
+            fprintf(stderr, "memgrind: diff: '%s' is not OLD,NEW\n", value);
+            return -1;
+        }
+
+        return set_string(&cfg->diff, value);
+    } else if (strcmp(key, "diff.alpha") == 0) {
+        return parse_double(key, value, &cfg->diff_alpha);
+    } else if (strcmp(key, "diff.threshold") == 0) {
+        const int status = parse_double(key, value, &cfg->diff_threshold);
+        cfg->diff_threshold /= 100.0;
+        return status;
+    } else if (strcmp(key, "sweep") == 0) {
+        return parse_sweep(cfg, tests, value);
+    } else if (strcmp(key, "frag") == 0) {
+        return parse_bool(key, value, &cfg->frag);
+    } else if (strcmp(key, "frag.bytes") == 0) {
+        cfg->frag = true;
+        return parse_bytes(key, value, &cfg->frag_opts.bytes);
+    } else if (strcmp(key, "frag.rounds") == 0) {
+        cfg->frag = true;
+        return parse_u32(key, value, &cfg->frag_opts.rounds);
+    } else if (strcmp(key, "frag.patterns") == 0) {
+        cfg->frag = true;
+
+        if (mgr_frag_patterns_parse(value, &cfg->frag_opts.patterns) != 0) {
+            fprintf(stderr, "memgrind: frag.patterns: '%s' is not a list of sawtooth, interleave,\n"
+                            "lifo, fifo, random, robson, growshrink or all\n", value);
+            return -1;
+        }
+
+        return 0;
+    } else if (strcmp(key, "align") == 0) {
+        return parse_bool(key, value, &cfg->align);
+    } else if (strcmp(key, "align.alignments") == 0) {
+        cfg->align = true;
+        return mgr_align_parse_alignments(key, value, &cfg->align_opts);
+    } else if (strcmp(key, "align.sizes") == 0) {
+        cfg->align = true;
+        return mgr_matrix_parse_axis(key, value, cfg->align_opts.sizes, &cfg->align_opts.nsizes);
+    } else if (strcmp(key, "align.count") == 0) {
+        cfg->align = true;
+        return parse_u32(key, value, &cfg->align_opts.count);
+    } else if (strcmp(key, "soak") == 0) {
+        return parse_bool(key, value, &cfg->soak);
+    } else if (strcmp(key, "soak.bytes") == 0) {
+        cfg->soak = true;
+        return parse_bytes(key, value, &cfg->soak_opts.bytes);
+    } else if (strcmp(key, "soak.min") == 0) {
+        cfg->soak = true;
+        return parse_u32(key, value, &cfg->soak_opts.min);
+    } else if (strcmp(key, "soak.max") == 0) {
+        cfg->soak = true;
+        return parse_u32(key, value, &cfg->soak_opts.max);
+    } else if (strcmp(key, "soak.seconds") == 0) {
+        cfg->soak = true;
+        return parse_double(key, value, &cfg->soak_opts.seconds);
+    } else if (strcmp(key, "soak.window") == 0) {
+        cfg->soak = true;
+        return parse_u32(key, value, &cfg->soak_opts.window_ms);
+    } else if (strcmp(key, "soak.lifetime") == 0) {
+        cfg->soak = true;
+
+        if (mgr_lifetime_parse(value, &cfg->soak_opts.lifetime) != 0) {
+            fprintf(stderr, "memgrind: soak.lifetime: '%s' is not exp, fifo or pareto\n", value);
+            return -1;
+        }
+
+        return 0;
+    } else if (strcmp(key, "numa") == 0) {
+        return parse_bool(key, value, &cfg->numa);
+    } else if (strcmp(key, "numa.count") == 0) {
+        cfg->numa = true;
+        return parse_u32(key, value, &cfg->numa_opts.count);
+    } else if (strcmp(key, "numa.size") == 0) {
+        cfg->numa = true;
+        return parse_u32(key, value, &cfg->numa_opts.size);
+    } else if (strcmp(key, "numa.passes") == 0) {
+        cfg->numa = true;
+        return parse_u32(key, value, &cfg->numa_opts.passes);
+    } else if (strcmp(key, "matrix") == 0) {
+        return parse_bool(key, value, &cfg->matrix);
+    } else if (strcmp(key, "matrix.sizes") == 0) {
+        cfg->matrix = true;
+        return mgr_matrix_parse_axis(key, value, cfg->matrix_grid.sizes, &cfg->matrix_grid.nsizes);
+    } else if (strcmp(key, "matrix.live") == 0) {
+        cfg->matrix = true;
+        return mgr_matrix_parse_axis(key, value, cfg->matrix_grid.lives, &cfg->matrix_grid.nlives);
+    } else if (parse_test_param(tests, key, &t, &param) == 0) {
+        return parse_u32(key, value, mgr_test_param(t, param));
+    }
+
+    fprintf(stderr, "memgrind: unknown option '%s'\n", key);
+    return -1;
+}
+
+static char *trim(char *s) {
+    while (*s == ' ' || *s == '\t') {
+        ++s;
+    }
+
+    char *end = s + strlen(s);
+
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) {
+        *--end = '\0';
+    }
+
+    return s;
+}
+
+/*!
+    \brief  Applies every "key = value" line of a config file
+
+    \param[in]  cfg     configuration
+    \param[in]  tests   test table, terminated by a NULL test
+    \param[in]  path    config file
+
+    \return     0 on success, -1 on the first invalid line
+                (reported on stderr with its line number), or if
+                files load each other more than MGR_CONFIG_DEPTH_MAX deep
+ */
+int mgr_config_load(mgr_config *cfg, mgr_test *tests, const char *path) {
+    // a "config" line loads its file from here: stop a file that loads itself
+    static int depth = 0;
+
+    if (depth == MGR_CONFIG_DEPTH_MAX) {
+        fprintf(stderr, "memgrind: %s: config files nested more than %d deep\n", path, MGR_CONFIG_DEPTH_MAX);
+        return -1;
+    }
+
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    char line[1024];
+    int lineno = 0;
+    int status = 0;
+
+    ++depth;
+
+    while (status == 0 && fgets(line, sizeof line, file)) {
+        ++lineno;
+
+        char *hash = strchr(line, '#');
+
+        if (hash) {
+            *hash = '\0';
+        }
+
+        char *key = trim(line);
+
+        if (*key == '\0') {
+            continue;
+        }
+
+        char *eq = strchr(key, '=');
+
+        if (eq == NULL) {
+            fprintf(stderr, "memgrind: %s:%d: expected 'key = value'\n", path, lineno);
+            status = -1;
+            break;
+        }
+
+        *eq = '\0';
+
+        if (mgr_config_set(cfg, tests, trim(key), trim(eq + 1)) != 0) {
+            fprintf(stderr, "memgrind: %s:%d: invalid line\n", path, lineno);
+            status = -1;
+        }
+    }
+
+    --depth;
+
+    fclose(file);
+    return status;
+}
+
+// ranges are checked once every option is in, as either end may come first
+static int check_range(const char *name, uint32_t min, uint32_t max) {
+    if (min > max) {
+        fprintf(stderr, "memgrind: %s: min (%u) is greater than max (%u)\n", name, min, max);
+        return -1;
+    }
+
+    return 0;
+}
+
+static bool is_flag(const char *key) {
+    for (const char *const *f = mgr_flags; *f; ++f) {
+        if (strcmp(*f, key) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+    \brief  Applies the command line, in order
+
+    \details    Accepts "--key value", "--key=value", "-x value" for the
+                short options, and bare "--flag" for boolean options.
+
+    \param[in]  cfg     configuration
+    \param[in]  tests   test table, terminated by a NULL test
+    \param[in]  argc    command line argument count
+    \param[in]  argv    command line arguments
+
+    \return     0 on success, 1 if help was requested,
+                -1 on an invalid option or a min above its max
+                (reported on stderr)
+ */
+int mgr_config_parse(mgr_config *cfg, mgr_test *tests, int argc, const char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *key = NULL;
+        const char *value = NULL;
+        char buffer[128];
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            return 1;
+        }
+
+        if (strncmp(arg, "--", 2) == 0) {
+            const char *eq = strchr(arg + 2, '=');
+
+            if (eq) {
+                snprintf(buffer, sizeof buffer, "%.*s", (int)(eq - (arg + 2)), arg + 2);
+                key = buffer;
+                value = eq + 1;
+            } else {
+                key = arg + 2;
+            }
+        } else if (arg[0] == '-' && arg[1] != '\0' && arg[2] == '\0') {
+            for (int j = 0; mgr_short_opts[j].key; ++j) {
+                if (mgr_short_opts[j].opt == arg[1]) {
+                    key = mgr_short_opts[j].key;
+                }
+            }
+        }
+
+        if (key == NULL) {
+            fprintf(stderr, "memgrind: unexpected argument '%s'\n", arg);
+            return -1;
+        }
+
+        if (value == NULL) {
+            if (is_flag(key)) {
+                value = "1";
+            } else if (i + 1 < argc) {
+                value = argv[++i];
+            } else {
+                fprintf(stderr, "memgrind: %s: missing value\n", arg);
+                return -1;
+            }
+        }
+
+        if (mgr_config_set(cfg, tests, key, value) != 0) {
+            return -1;
+        }
+    }
+
+    if (check_range("xfree", cfg->xfree_min, cfg->xfree_max) != 0 ||
+        check_range("soak", cfg->soak_opts.min, cfg->soak_opts.max) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*!
+    \brief  Prints the option summary, including every test parameter key
+
+    \param[in]  dest    destination file stream
+    \param[in]  prog    program name
+    \param[in]  tests   test table, terminated by a NULL test
+ */
+void mgr_config_usage(FILE *dest, const char *prog, const mgr_test *tests) {
+    fprintf(dest,
+            "usage: %s [options]\n"
+            "\n"
+            "  -t, --tests LETTERS         tests to run, e.g. abf (default: the enabled tests)\n"
+            "  -n, --reps N                timed repetitions per test (default %d)\n"
+            "  -w, --warmup N              untimed repetitions per test (default %d)\n"
+            "  -s, --seed N                random seed (default: from the clock)\n"
+            "      --rand-tape             pre-generate random values outside the timed window\n"
+            "      --op-latency            time every allocator call (per-op histograms)\n"
+            "      --perf                  count cycles, instructions, cache/TLB/branch misses\n"
+            "                              (Linux perf_event_open; skipped if not permitted)\n"
+            "      --memory                peak footprint, fragmentation and page faults\n"
+            "                              (measured in one extra, untimed repetition)\n"
+            "      --calibrate             also run each test on the null backend, and show\n"
+            "                              the time left to the allocator; time the timers\n"
+            "      --heap                  walk the heap after each test: used/free blocks,\n"
+            "                              largest free block, free lists (if the backend can)\n"
+            "      --heap-dump FILE        also write every block to FILE (implies --heap)\n"
+            "  -b, --backend SPEC          cgcs, system, arena, pool, pool-tc,\n"
+            "                              cgcs-tc, null, or dl:PATH[:PREFIX] (default cgcs)\n"
+            "      --compare SPEC,SPEC...  rerun the tests on each backend and compare\n"
+            "      --threads N|all         also run the tests on 1, 2, 4... N threads\n"
+            "      --xfree.pairs N         cross-thread free producer/consumer pairs (default %d)\n"
+            "      --xfree.count N         blocks per pair (default %d)\n"
+            "      --xfree.min N           smallest block (default %d)\n"
+            "      --xfree.max N           largest block (default %d)\n"
+            "      --remote.producers N    remote free producers (default %d)\n"
+            "      --remote.consumers N    remote free consumers, one queue each (default %d)\n"
+            "      --remote.count N        blocks per producer (default %d)\n"
+            "                              (block sizes as for xfree)\n"
+            "      --trace-record FILE     record the tests' allocator calls into FILE\n"
+            "      --trace-replay FILE     replay FILE as test t\n"
+            "      --workload FILE         run the workloads scripted in FILE, one row each\n"
+            "      --json FILE             also write results as JSON (- for stdout)\n"
+            "      --csv FILE              also write results as CSV (- for stdout)\n"
+            "                              (not soak, numa, frag, align or thread runs)\n"
+            "      --diff OLD,NEW          compare two JSON reports instead of running;\n"
+            "                              exits 1 on a significant regression\n"
+            "      --diff.alpha P          significance level (default %g)\n"
+            "      --diff.threshold PCT    smallest median change reported (default %g)\n"
+            "      --sweep KEY=FIRST:LAST[:*N|:+N]\n"
+            "                              rerun a test over a range of one parameter\n"
+            "                              (default step *2), e.g. d.max=64:65536\n"
+            "      --matrix                run test g over a grid of block and live set sizes\n"
+            "      --matrix.sizes LIST     block sizes, e.g. 16,4K,1M (implies --matrix)\n"
+            "      --matrix.live LIST      live set sizes, e.g. 1,64,4096 (implies --matrix)\n"
+            "      --soak                  hold a live set steady for a while, churning it\n"
+            "      --soak.bytes N[K|M|G]   live set (default %lluM)\n"
+            "      --soak.min N            smallest object (default %d)\n"
+            "      --soak.max N            largest object (default %d)\n"
+            "      --soak.seconds S        run time, after filling the live set (default %g)\n"
+            "      --soak.window MS        reporting window (default %d)\n"
+            "      --soak.lifetime DIST    exp, fifo or pareto (default %s)\n"
+            "                              (any soak.* option implies --soak)\n"
+            "      --numa                  local vs. remote access and free cost, per pair\n"
+            "                              of NUMA nodes (pinned threads, first-touch pages)\n"
+            "      --numa.count N          blocks per pair (default %d)\n"
+            "      --numa.size N           block size (default %d)\n"
+            "      --numa.passes N         chases over the blocks (default %d)\n"
+            "                              (any numa.* option implies --numa)\n",
+            prog,
+            MGR_MAX_ITER,
+            MGR_WARMUP_ITER,
+            MGR_XFREE_PAIRS,
+            MGR_XFREE_COUNT,
+            MGR_XFREE_ALLOC_MIN,
+            MGR_XFREE_ALLOC_MAX,
+            MGR_REMOTE_PRODUCERS,
+            MGR_REMOTE_CONSUMERS,
+            MGR_REMOTE_COUNT,
+            MGR_DIFF_ALPHA,
+            MGR_DIFF_THRESHOLD,
+            (unsigned long long)(MGR_SOAK_BYTES >> 20),
+            MGR_SOAK_ALLOC_MIN,
+            MGR_SOAK_ALLOC_MAX,
+            MGR_SOAK_SECONDS,
+            MGR_SOAK_WINDOW_MS,
+            mgr_lifetime_name(MGR_SOAK_LIFETIME),
+            MGR_NUMA_COUNT,
+            MGR_NUMA_SIZE,
+            MGR_NUMA_PASSES);
+
+    // in two parts: C compilers need not take longer string literals
+    fprintf(dest,
+            "      --frag                  allocator-hostile patterns: peak live vs. heap extent\n"
+            "      --frag.bytes N[K|M|G]   live byte budget (default %lluM)\n"
+            "      --frag.rounds N         rounds per pattern (default %d)\n"
+            "      --frag.patterns LIST    sawtooth, interleave, lifo, fifo, random, robson,\n"
+            "                              growshrink (default all)\n"
+            "                              (any frag.* option implies --frag)\n"
+            "      --align                 time and check aligned allocations, and their waste\n"
+            "      --align.alignments LIST powers of two (default 16,64,4K,2M)\n"
+            "      --align.sizes LIST      block sizes (default 64,1000,4K,64K,1M)\n"
+            "      --align.count N         blocks per alignment and size (default 1024)\n"
+            "                              (any align.* option implies --align)\n"
+            "  -c, --config FILE           read 'key = value' lines (keys as above)\n"
+            "  -h, --help                  print this message\n"
+            "\n"
+            "test parameters (--KEY N, e.g. --d.max 4096):\n",
+            (unsigned long long)(MGR_FRAG_BYTES >> 20),
+            MGR_FRAG_ROUNDS);
+
+    for (const mgr_test *t = tests; t->test; ++t) {
+        fprintf(dest, "  %c%s", t->tch, t->enabled ? " " : "*");
+
+        for (int i = 0; i < 3; ++i) {
+            if (t->params[i]) {
+                fprintf(dest, "  %c.%s=%u", t->tch, t->params[i],
+                        *mgr_test_param((mgr_test *)(t), i));
+            }
+        }
+
+        fprintf(dest, "\n");
+    }
+
+    fprintf(dest, "\n(* not run unless selected with --tests)\n");
+}
@@ -0,0 +1,113 @@
+/*!
+    \file       mgr_config.h
+    \brief      Header file for memgrind_c command-line and config file options
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Every option is a key; the same key works as a long option
+    ("--reps 500", "--reps=500", "--d.max 4096") and as a config file
+    line ("reps = 500", "d.max = 4096"). Config files allow blank lines
+    and '#' comments, and are applied in order with the command line,
+    so later options win.
+ */
+
+#ifndef MGR_CONFIG_H
+#define MGR_CONFIG_H
+
+#include "mgr_aligned.h"
+#include "mgr_frag.h"
+#include "mgr_matrix.h"
+#include "mgr_numa.h"
+#include "mgr_soak.h"
+#include "mgr_workload.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define MGR_SWEEP_MAX 8
+
+/*!
+    \brief  Parameter sweep: one test, one parameter, a range of values
+
+    \details    Values run from first to last inclusive, multiplying
+                by step (geometric) or adding step (arithmetic).
+ */
+typedef struct mgr_sweep {
+    char tch;
+    int param;
+    uint32_t first;
+    uint32_t last;
+    uint32_t step;
+    bool geometric;
+} mgr_sweep;
+
+typedef struct mgr_config {
+    uint32_t warmup;
+    uint32_t reps;
+
+    bool seed_set;
+    uint64_t seed;
+    bool rand_tape;
+    bool op_latency;
+    bool perf;
+    bool memory;
+    bool calibrate;         // subtract the harness time (see mgr_calib.h)
+    bool heap;              // walk the heap after every test (see mgr_heap.h)
+
+    uint32_t threads;       // 0: no threaded runs
+    uint32_t xfree_pairs;
+    uint32_t xfree_count;
+    uint32_t xfree_min;
+    uint32_t xfree_max;
+    uint32_t remote_producers;
+    uint32_t remote_consumers;
+    uint32_t remote_count;  // blocks per producer
+
+    char *backend;
+    char *compare;
+    char *trace_record;
+    char *trace_replay;
+    char *workload;         // workload script (see mgr_script.h)
+    char *heap_dump;        // heap snapshots, one per test
+
+    char *json;             // JSON report file, "-" for stdout
+    char *csv;              // CSV report file, "-" for stdout
+
+    char *diff;             // "OLD,NEW": compare two JSON reports, run nothing
+    double diff_alpha;
+    double diff_threshold;  // relative, e.g. 0.05
+
+    mgr_sweep sweeps[MGR_SWEEP_MAX];
+    uint32_t nsweeps;
+
+    bool matrix;            // run the size class matrix
+    mgr_matrix matrix_grid;
+
+    bool soak;              // run the steady-state soak
+    mgr_soak_opts soak_opts;
+
+    bool numa;              // run the NUMA placement benchmark
+    mgr_numa_opts numa_opts;
+
+    bool frag;              // run the fragmentation suite
+    mgr_frag_opts frag_opts;
+
+    bool align;             // run the aligned allocation grid
+    mgr_align_opts align_opts;
+} mgr_config;
+
+void mgr_config_init(mgr_config *cfg);
+void mgr_config_deinit(mgr_config *cfg);
+
+int mgr_config_set(mgr_config *cfg, mgr_test *tests, const char *key, const char *value);
+int mgr_config_load(mgr_config *cfg, mgr_test *tests, const char *path);
+int mgr_config_parse(mgr_config *cfg, mgr_test *tests, int argc, const char *argv[]);
+
+void mgr_config_usage(FILE *dest, const char *prog, const mgr_test *tests);
+
+mgr_test *mgr_test_find(mgr_test *tests, char tch);
+
+#endif /* MGR_CONFIG_H */
@@ -0,0 +1,317 @@
+/*!
+    \file       mgr_footprint.c
+    \brief      Source file for memgrind_c memory footprint and fragmentation metrics
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_footprint.h"
+#include "mgr_alloc.h"
+#include "mgr_ptrmap.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+bool mgr_footprint_on = false;
+
+static struct {
+    const mgr_backend *inner;
+    mgr_ptrmap sizes;           // live block -> requested size
+
+    size_t requested;           // live requested bytes
+    size_t usable;              // live usable bytes
+    size_t requested_total;     // over all allocations
+    size_t usable_total;
+    size_t next_sample;         // live requested bytes that trigger a sample
+
+    size_t rss_base;
+
+    mgr_footprint out;
+} fp;
+
+/*!
+    \brief  Resident set size of the process
+
+    \param[out] out resident bytes
+
+    \return     true on success, false where it cannot be read
+ */
+bool mgr_rss_bytes(size_t *out) {
+#ifdef __linux__
+    FILE *statm = fopen("/proc/self/statm", "r");
+    unsigned long size = 0;
+    unsigned long resident = 0;
+
+    if (statm == NULL) {
+        return false;
+    }
+
+    const bool ok = fscanf(statm, "%lu %lu", &size, &resident) == 2;
+    fclose(statm);
+
+    *out = (size_t)(resident) * (size_t)(sysconf(_SC_PAGESIZE));
+    return ok;
+#else
+    (void)(out);
+    return false;
+#endif
+}
+
+static void fp_sample(void) {
+    mgr_backend_stats stats;
+    size_t rss = 0;
+
+    if (fp.inner->stats_fn && fp.inner->stats_fn(&stats) == 0) {
+        fp.out.heap_known = true;
+        fp.out.heap_peak = stats.mapped > fp.out.heap_peak ? stats.mapped : fp.out.heap_peak;
+    }
+
+    if (fp.out.rss_known && mgr_rss_bytes(&rss)) {
+        const size_t growth = rss > fp.rss_base ? rss - fp.rss_base : 0;
+        fp.out.rss_growth = growth > fp.out.rss_growth ? growth : fp.out.rss_growth;
+    }
+
+    fp.next_sample = fp.requested + (fp.requested / 8) + 4096;
+}
+
+static void fp_add(void *ptr, size_t size) {
+    const size_t usable = fp.inner->usable_size_fn ? fp.inner->usable_size_fn(ptr) : size;
+
+    // a block the map cannot hold is left out of the live totals
+    if (mgr_ptrmap_insert(&fp.sizes, ptr, size) != 0) {
+        return;
+    }
+
+    ++fp.out.allocs;
+
+    fp.requested += size;
+    fp.usable += usable;
+    fp.requested_total += size;
+    fp.usable_total += usable;
+
+    fp.out.requested_peak = fp.requested > fp.out.requested_peak ? fp.requested : fp.out.requested_peak;
+    fp.out.usable_peak = fp.usable > fp.out.usable_peak ? fp.usable : fp.out.usable_peak;
+
+    if (fp.requested >= fp.next_sample) {
+        fp_sample();
+    }
+}
+
+// call before the block is released, while its usable size can still be read
+static void fp_remove(void *ptr) {
+    uint64_t size = 0;
+
+    if (ptr && mgr_ptrmap_remove(&fp.sizes, ptr, &size)) {
+        fp.requested -= (size_t)(size);
+        fp.usable -= fp.inner->usable_size_fn ? fp.inner->usable_size_fn(ptr) : (size_t)(size);
+    }
+}
+
+static void *fp_malloc(size_t size) {
+    void *ptr = fp.inner->malloc_fn(size);
+
+    if (ptr) {
+        fp_add(ptr, size);
+    }
+
+    return ptr;
+}
+
+static void fp_free(void *ptr) {
+    fp_remove(ptr);
+    fp.inner->free_fn(ptr);
+}
+
+static void *fp_realloc(void *ptr, size_t old_size, size_t new_size) {
+    if (fp.inner->realloc_fn == NULL) {
+        return mgr_realloc_emulated(ptr, old_size, new_size);   // through fp_malloc/fp_free
+    }
+
+    uint64_t size = 0;
+    const size_t usable = ptr && fp.inner->usable_size_fn ? fp.inner->usable_size_fn(ptr) : 0;
+    const bool known = ptr && mgr_ptrmap_remove(&fp.sizes, ptr, &size);
+
+    void *res = fp.inner->realloc_fn(ptr, old_size, new_size);
+
+    if (res == NULL && new_size > 0 && known) {
+        mgr_ptrmap_insert(&fp.sizes, ptr, size);   // the old block lives on
+        return NULL;
+    }
+
+    if (known) {
+        fp.requested -= (size_t)(size);
+        fp.usable -= fp.inner->usable_size_fn ? usable : (size_t)(size);
+    }
+
+    if (res) {
+        fp_add(res, new_size);
+    }
+
+    return res;
+}
+
+static void *fp_calloc(size_t count, size_t size) {
+    if (fp.inner->calloc_fn == NULL) {
+        return mgr_calloc_emulated(count, size);                // through fp_malloc
+    }
+
+    void *ptr = fp.inner->calloc_fn(count, size);
+
+    if (ptr) {
+        fp_add(ptr, count * size);
+    }
+
+    return ptr;
+}
+
+static const mgr_backend mgr_backend_footprint = {
+    .name = "footprint",
+    .thread_safe = false,
+    .init_fn = NULL,
+    .teardown_fn = NULL,
+    .malloc_fn = fp_malloc,
+    .free_fn = fp_free,
+    .realloc_fn = fp_realloc,
+    .calloc_fn = fp_calloc,
+    .aligned_malloc_fn = NULL,         // emulated through fp_malloc, padding and all
+    .stats_fn = NULL,
+    .usable_size_fn = NULL,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+    .walk_fn = NULL
+};
+
+/*!
+    \brief  Starts a footprint pass: until mgr_footprint_end, every
+            allocator call is accounted for on its way to the
+            current backend
+
+    \details    For a single-threaded pass only.
+ */
+void mgr_footprint_begin(void) {
+    memset(&fp.out, 0, sizeof fp.out);
+
+    fp.inner = mgr_backend_current;
+    fp.requested = 0;
+    fp.usable = 0;
+    fp.requested_total = 0;
+    fp.usable_total = 0;
+
+    mgr_ptrmap_init(&fp.sizes);
+
+    fp.out.usable_known = fp.inner->usable_size_fn != NULL;
+    fp.out.rss_known = mgr_rss_bytes(&fp.rss_base);
+    fp.out.external_frag = -1.0;
+    fp.out.internal_frag = -1.0;
+
+    fp_sample();
+
+    mgr_backend_current = &mgr_backend_footprint;
+    mgr_footprint_on = true;
+}
+
+/*!
+    \brief  Samples the heap at the workload's mark (see mgr_footprint_mark)
+ */
+void mgr_footprint_sample_mark(void) {
+    mgr_backend_stats stats;
+
+    fp_sample();
+
+    fp.out.marked = true;
+    fp.out.mark_requested = fp.requested;
+
+    if (fp.inner->stats_fn && fp.inner->stats_fn(&stats) == 0 && stats.mapped > 0) {
+        const size_t free_bytes = stats.mapped > stats.in_use ? stats.mapped - stats.in_use : 0;
+        fp.out.external_frag = (double)(free_bytes) / (double)(stats.mapped);
+    }
+}
+
+/*!
+    \brief  Ends a footprint pass and restores the wrapped backend
+
+    \param[out] out footprint of the pass (page fault fields are untouched)
+ */
+void mgr_footprint_end(mgr_footprint *out) {
+    mgr_footprint_on = false;
+    mgr_backend_current = fp.inner;
+
+    fp_sample();
+
+    if (fp.out.usable_known && fp.usable_total > 0) {
+        fp.out.internal_frag = 1.0 - ((double)(fp.requested_total) / (double)(fp.usable_total));
+    }
+
+    mgr_ptrmap_deinit(&fp.sizes);
+
+    fp.out.minor_faults_per_rep = out->minor_faults_per_rep;
+    fp.out.major_faults_per_rep = out->major_faults_per_rep;
+    *out = fp.out;
+}
+
+/*!
+    \brief  Page faults the process has taken so far
+
+    \param[out] minor   faults served without I/O (e.g. first touch of a page)
+    \param[out] major   faults that needed I/O
+ */
+void mgr_page_faults(uint64_t *minor, uint64_t *major) {
+    struct rusage ru;
+
+    if (getrusage(RUSAGE_SELF, &ru) != 0) {
+        *minor = 0;
+        *major = 0;
+        return;
+    }
+
+    *minor = (uint64_t)(ru.ru_minflt);
+    *major = (uint64_t)(ru.ru_majflt);
+}
+
+static void fprint_bytes(FILE *dest, bool known, size_t bytes) {
+    if (known) {
+        fprintf(dest, "\t%12zu", bytes);
+    } else {
+        fprintf(dest, "\t%12s", "-");
+    }
+}
+
+static void fprint_ratio(FILE *dest, bool known, double ratio) {
+    if (known) {
+        fprintf(dest, "\t%9.1lf%%", ratio * 100.0);
+    } else {
+        fprintf(dest, "\t%10s", "-");
+    }
+}
+
+/*!
+    \brief  Prints a footprint as one row; "-" marks what the backend
+            or platform cannot tell
+
+    \param[in]  dest    destination file stream
+    \param[in]  f       footprint
+ */
+void mgr_footprint_fprint(FILE *dest, const mgr_footprint *f) {
+    fprintf(dest,
+            "  %-18s\t%12s\t%12s\t%12s\t%12s\t%10s\t%10s\t%10s\t%10s\t%10s\n",
+            "memory (bytes)", "requested", "usable", "heap", "rss growth",
+            "overhead", "int frag", "ext frag", "minflt/rep", "majflt/rep");
+
+    const bool overhead = f->heap_known && f->requested_peak > 0;
+
+    fprintf(dest, "  %-18s", "peak");
+    fprint_bytes(dest, true, f->requested_peak);
+    fprint_bytes(dest, f->usable_known, f->usable_peak);
+    fprint_bytes(dest, f->heap_known, f->heap_peak);
+    fprint_bytes(dest, f->rss_known, f->rss_growth);
+    fprint_ratio(dest, overhead, overhead ? ((double)(f->heap_peak) / (double)(f->requested_peak)) - 1.0 : 0.0);
+    fprint_ratio(dest, f->internal_frag >= 0.0, f->internal_frag);
+    fprint_ratio(dest, f->external_frag >= 0.0, f->external_frag);
+    fprintf(dest, "\t%10.1lf\t%10.1lf\n", f->minor_faults_per_rep, f->major_faults_per_rep);
+}
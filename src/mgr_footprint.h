@@ -0,0 +1,83 @@
+/*!
+    \file       mgr_footprint.h
+    \brief      Header file for memgrind_c memory footprint and fragmentation metrics
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Footprint is measured in a separate, untimed pass of a test, through
+    a backend that wraps the current one and keeps the requested size of
+    every live block, so that bookkeeping never lands in a timed window.
+
+    - requested: bytes the workload asked for (live, high-water mark)
+    - usable: bytes the allocator actually reserved for those blocks
+      (needs the backend's usable_size_fn); internal fragmentation is
+      the share of usable bytes that were not requested
+    - heap: bytes the backend holds from the operating system (needs
+      its stats_fn); overhead is heap bytes per requested byte, minus 1
+    - rss: resident set growth over the pass (Linux)
+    - external fragmentation: at the workload's mark (after it frees
+      part of its blocks), the share of the heap that is free but still
+      held by the allocator, i.e. (heap - in use) / heap
+
+    Heap and resident sizes are sampled as the live set grows
+    (every 1/8th of growth), at the mark, and at the end of the pass.
+ */
+
+#ifndef MGR_FOOTPRINT_H
+#define MGR_FOOTPRINT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct mgr_footprint {
+    uint64_t allocs;
+
+    size_t requested_peak;
+    size_t usable_peak;
+    double internal_frag;       // over all allocations of the pass
+
+    size_t heap_peak;
+    size_t rss_growth;
+
+    size_t mark_requested;      // live requested bytes at the mark
+    double external_frag;       // at the mark
+
+    bool usable_known;
+    bool heap_known;
+    bool rss_known;
+    bool marked;
+
+    // over the timed repetitions (see mgr_page_faults)
+    double minor_faults_per_rep;
+    double major_faults_per_rep;
+} mgr_footprint;
+
+extern bool mgr_footprint_on;
+
+void mgr_footprint_begin(void);
+void mgr_footprint_end(mgr_footprint *out);
+void mgr_footprint_sample_mark(void);
+
+void mgr_page_faults(uint64_t *minor, uint64_t *major);
+bool mgr_rss_bytes(size_t *out);
+
+void mgr_footprint_fprint(FILE *dest, const mgr_footprint *f);
+
+/*!
+    \brief  Marks the point of a workload where external fragmentation
+            is measured, e.g. right after it frees half of its blocks
+
+    \details    A no-op outside of a footprint pass, so workloads
+                call it unconditionally.
+ */
+static inline void mgr_footprint_mark(void) {
+    if (mgr_footprint_on) {
+        mgr_footprint_sample_mark();
+    }
+}
+
+#endif /* MGR_FOOTPRINT_H */
@@ -0,0 +1,501 @@
+/*!
+    \file       mgr_frag.c
+    \brief      Source file for the memgrind_c adversarial fragmentation suite
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_frag.h"
+#include "mgr_alloc.h"
+#include "mgr_footprint.h"
+#include "mgr_rand.h"
+#include "mgr_stats.h"
+
+#include "cgcs_ulog.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char *const mgr_frag_names[] = {
+    "sawtooth", "interleave", "lifo", "fifo", "random", "robson", "growshrink"
+};
+
+// sawtooth: block size of round r is MGR_FRAG_SAWTOOTH_MIN + r * MGR_FRAG_SAWTOOTH_STEP
+#define MGR_FRAG_SAWTOOTH_MIN 32
+#define MGR_FRAG_SAWTOOTH_STEP 16
+
+// interleave: small blocks, and large blocks of MGR_FRAG_LARGE << (r % 4) bytes
+#define MGR_FRAG_SMALL_MIN 16
+#define MGR_FRAG_SMALL_MAX 32
+#define MGR_FRAG_LARGE 256
+
+// lifo, fifo, random: block sizes
+#define MGR_FRAG_ORDER_MIN 16
+#define MGR_FRAG_ORDER_MAX 512
+
+// robson: block size of round r is MGR_FRAG_ROBSON_MIN << r, at most MGR_FRAG_ROBSON_MAX
+#define MGR_FRAG_ROBSON_MIN 64
+#define MGR_FRAG_ROBSON_MAX (1u << 20)
+
+// growshrink: block sizes, and the low point as a fraction of the budget
+#define MGR_FRAG_GROW_MIN 16
+#define MGR_FRAG_GROW_MAX 4096
+#define MGR_FRAG_GROW_LOW 16
+
+typedef struct frag_block {
+    char *ptr;
+    uint32_t size;
+} frag_block;
+
+/*
+    Blocks of the running pattern, in an array from the C library,
+    outside of the allocator under test.
+ */
+typedef struct frag_state {
+    frag_block *blocks;
+    frag_block *sorted;     // scratch, for frag_extent
+    size_t count;
+    size_t capacity;
+    uintptr_t page_size;
+
+    uint64_t live;          // requested bytes
+    uint64_t ops;           // allocator calls since the last row
+    uint64_t ns;            // time spent in the loops making them
+
+    uint64_t peak_live;
+    uint64_t peak_extent;
+    bool oom;
+} frag_state;
+
+/*!
+    \brief  Looks up fragmentation patterns by name
+
+    \param[in]  list    comma-separated pattern names, or "all"
+    \param[out] out     mask of (1 << mgr_frag_pattern)
+
+    \return     0 on success, -1 if a name is not a pattern
+ */
+int mgr_frag_patterns_parse(const char *list, uint32_t *out) {
+    uint32_t mask = 0;
+
+    while (*list) {
+        const size_t length = strcspn(list, ",");
+        bool found = length == 3 && strncmp(list, "all", 3) == 0;
+
+        if (found) {
+            mask |= MGR_FRAG_ALL;
+        }
+
+        for (size_t i = 0; i < MGR_FRAG_PATTERNS && found == false; ++i) {
+            if (strlen(mgr_frag_names[i]) == length && strncmp(list, mgr_frag_names[i], length) == 0) {
+                mask |= 1u << i;
+                found = true;
+            }
+        }
+
+        if (found == false) {
+            return -1;
+        }
+
+        list += length;
+        list += *list == ',';
+    }
+
+    *out = mask;
+    return mask ? 0 : -1;
+}
+
+static bool frag_alloc(frag_state *s, uint32_t size) {
+    if (s->count == s->capacity) {
+        return false;
+    }
+
+    char *ptr = mgr_malloc(size);
+
+    ++s->ops;
+
+    if (ptr == NULL) {
+        s->oom = true;
+        return false;
+    }
+
+    ptr[0] = (char)(size);
+    ptr[size - 1] = (char)(size);
+
+    s->blocks[s->count].ptr = ptr;
+    s->blocks[s->count].size = size;
+    ++s->count;
+
+    s->live += size;
+    s->peak_live = s->live > s->peak_live ? s->live : s->peak_live;
+
+    return true;
+}
+
+// frees blocks[i], leaving a hole in the array (see frag_compact)
+static void frag_free(frag_state *s, size_t i) {
+    frag_block *b = s->blocks + i;
+
+    if (b->ptr) {
+        mgr_free(b->ptr);
+        ++s->ops;
+        s->live -= b->size;
+        b->ptr = NULL;
+    }
+}
+
+// frees blocks[i] and moves the last block into its place
+static void frag_remove(frag_state *s, size_t i) {
+    frag_free(s, i);
+    s->blocks[i] = s->blocks[--s->count];
+}
+
+static void frag_compact(frag_state *s) {
+    size_t n = 0;
+
+    for (size_t i = 0; i < s->count; ++i) {
+        if (s->blocks[i].ptr) {
+            s->blocks[n++] = s->blocks[i];
+        }
+    }
+
+    s->count = n;
+}
+
+static void frag_free_all(frag_state *s) {
+    for (size_t i = 0; i < s->count; ++i) {
+        frag_free(s, i);
+    }
+
+    s->count = 0;
+}
+
+static int frag_by_address(const void *a, const void *b) {
+    const uintptr_t x = (uintptr_t)(((const frag_block *)(a))->ptr);
+    const uintptr_t y = (uintptr_t)(((const frag_block *)(b))->ptr);
+
+    return (x > y) - (x < y);
+}
+
+// fills the budget with blocks of [min, max] bytes
+static void frag_fill(frag_state *s, uint64_t budget, uint32_t min, uint32_t max) {
+    const uint64_t x = mgr_clock_ns();
+
+    while (s->live < budget && frag_alloc(s, mgr_rand_between(min, max))) {
+        continue;
+    }
+
+    s->ns += mgr_clock_ns() - x;
+}
+
+/*
+    Bytes of the pages that hold at least one live block: what the
+    heap cannot give back, however its allocator lays out its regions.
+ */
+static uint64_t frag_extent(frag_state *s) {
+    uint64_t pages = 0;
+    uintptr_t last = 0;         // one past the last page counted
+    bool any = false;
+
+    memcpy(s->sorted, s->blocks, sizeof *s->blocks * s->count);
+    qsort(s->sorted, s->count, sizeof *s->sorted, frag_by_address);
+
+    for (size_t i = 0; i < s->count; ++i) {
+        uintptr_t first = (uintptr_t)(s->sorted[i].ptr) / s->page_size;
+        const uintptr_t end = ((uintptr_t)(s->sorted[i].ptr) + s->sorted[i].size - 1) / s->page_size + 1;
+
+        first = any && first < last ? last : first;
+
+        if (end > first) {
+            pages += end - first;
+            last = end;
+        }
+
+        any = true;
+    }
+
+    return pages * s->page_size;
+}
+
+static void frag_fprint_row(FILE *dest, const char *label, frag_state *s) {
+    const uint64_t extent = frag_extent(s);
+    size_t rss = 0;
+    mgr_backend_stats stats;
+
+    s->peak_extent = extent > s->peak_extent ? extent : s->peak_extent;
+
+    fprintf(dest, "%s%-10s%s\t%12.0lf\t%9.1lf\t%10.1lf",
+            KGRN_b, label, KNRM,
+            s->ns > 0 ? (double)(s->ops) * 1e9 / (double)(s->ns) : 0.0,
+            (double)(s->live) / 1048576.0,
+            (double)(extent) / 1048576.0);
+
+    if (mgr_rss_bytes(&rss)) {
+        fprintf(dest, "\t%10.1lf", (double)(rss) / 1048576.0);
+    } else {
+        fprintf(dest, "\t%10s", "-");
+    }
+
+    if (mgr_backend_current->stats_fn && mgr_backend_current->stats_fn(&stats) == 0) {
+        fprintf(dest, "\t%10.1lf\n", (double)(stats.mapped) / 1048576.0);
+    } else {
+        fprintf(dest, "\t%10s\n", "-");
+    }
+
+    s->ops = 0;
+    s->ns = 0;
+}
+
+static void frag_sawtooth(frag_state *s, uint64_t budget, uint32_t round) {
+    const uint32_t size = MGR_FRAG_SAWTOOTH_MIN + (round * MGR_FRAG_SAWTOOTH_STEP);
+    const size_t first = s->count;
+
+    frag_fill(s, budget, size, size);
+
+    const uint64_t x = mgr_clock_ns();
+
+    // every other block of this round; its neighbours pin the hole
+    for (size_t i = first; i < s->count; i += 2) {
+        frag_free(s, i);
+    }
+
+    s->ns += mgr_clock_ns() - x;
+    frag_compact(s);
+}
+
+static void frag_interleave(frag_state *s, uint64_t budget, uint32_t round) {
+    const uint32_t large = MGR_FRAG_LARGE << (round % 4);
+
+    uint64_t x = mgr_clock_ns();
+
+    while (s->live < budget) {
+        if (frag_alloc(s, mgr_rand_between(MGR_FRAG_SMALL_MIN, MGR_FRAG_SMALL_MAX)) == false ||
+            frag_alloc(s, large) == false) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < s->count; ++i) {
+        if (s->blocks[i].size == large) {
+            frag_free(s, i);
+        }
+    }
+
+    s->ns += mgr_clock_ns() - x;
+    frag_compact(s);
+
+    // just too large for any of the holes
+    frag_fill(s, budget, large + MGR_FRAG_SMALL_MIN, large + MGR_FRAG_SMALL_MIN);
+}
+
+static void frag_order(frag_state *s, uint64_t budget, mgr_frag_pattern pattern) {
+    frag_fill(s, budget, MGR_FRAG_ORDER_MIN, MGR_FRAG_ORDER_MAX);
+
+    if (pattern == MGR_FRAG_RANDOM) {
+        for (size_t i = s->count; i > 1; --i) {
+            const size_t j = mgr_rand_below((uint32_t)(i));
+            const frag_block b = s->blocks[i - 1];
+
+            s->blocks[i - 1] = s->blocks[j];
+            s->blocks[j] = b;
+        }
+    }
+
+    // the row comes after the frees; the peak is taken here, untimed
+    const uint64_t extent = frag_extent(s);
+
+    s->peak_extent = extent > s->peak_extent ? extent : s->peak_extent;
+}
+
+static void frag_order_free(frag_state *s, mgr_frag_pattern pattern) {
+    const uint64_t x = mgr_clock_ns();
+
+    if (pattern == MGR_FRAG_LIFO) {
+        for (size_t i = s->count; i-- > 0;) {
+            frag_free(s, i);
+        }
+    } else {
+        for (size_t i = 0; i < s->count; ++i) {
+            frag_free(s, i);
+        }
+    }
+
+    s->ns += mgr_clock_ns() - x;
+    s->count = 0;
+}
+
+static void frag_robson(frag_state *s, uint64_t budget, uint32_t round) {
+    const uint32_t shift = round < 16 ? round : 16;
+    const uint32_t size = MGR_FRAG_ROBSON_MIN << shift < MGR_FRAG_ROBSON_MAX ?
+                          MGR_FRAG_ROBSON_MIN << shift : MGR_FRAG_ROBSON_MAX;
+    const uintptr_t window = (uintptr_t)(size) * 2;
+    const size_t first = s->count;
+
+    frag_fill(s, budget, size, size);
+
+    // the lowest block of each window stays; sorting is not timed
+    qsort(s->blocks + first, s->count - first, sizeof *s->blocks, frag_by_address);
+
+    uintptr_t kept = UINTPTR_MAX;
+    const uint64_t x = mgr_clock_ns();
+
+    for (size_t i = first; i < s->count; ++i) {
+        const uintptr_t w = (uintptr_t)(s->blocks[i].ptr) / window;
+
+        if (w == kept) {
+            frag_free(s, i);
+        } else {
+            kept = w;
+        }
+    }
+
+    s->ns += mgr_clock_ns() - x;
+    frag_compact(s);
+}
+
+static void frag_grow(frag_state *s, uint64_t budget) {
+    const uint64_t x = mgr_clock_ns();
+    uint32_t n = 0;
+
+    while (s->live < budget) {
+        if (++n % 4 == 0 && s->count > 0) {
+            frag_remove(s, mgr_rand_below((uint32_t)(s->count)));
+        } else if (frag_alloc(s, mgr_rand_between(MGR_FRAG_GROW_MIN, MGR_FRAG_GROW_MAX)) == false) {
+            break;
+        }
+    }
+
+    s->ns += mgr_clock_ns() - x;
+}
+
+static void frag_shrink(frag_state *s, uint64_t low) {
+    const uint64_t x = mgr_clock_ns();
+    uint32_t n = 0;
+
+    while (s->live > low && s->count > 0) {
+        if (++n % 4 == 0) {
+            if (frag_alloc(s, mgr_rand_between(MGR_FRAG_GROW_MIN, MGR_FRAG_GROW_MAX)) == false) {
+                break;
+            }
+        } else {
+            frag_remove(s, mgr_rand_below((uint32_t)(s->count)));
+        }
+    }
+
+    s->ns += mgr_clock_ns() - x;
+}
+
+static void frag_run_pattern(frag_state *s, const mgr_frag_opts *opts, mgr_frag_pattern pattern, FILE *dest) {
+    fprintf(dest, "\n%s%s%s\n\n", KGRN_b, mgr_frag_names[pattern], KNRM);
+    fprintf(dest, "%s\t%s\t%s\t%s\t%s\t%s\n",
+            KWHT_b"round"KNRM"     ", KWHT_b"       ops/s"KNRM, KWHT_b"live MiB"KNRM,
+            KWHT_b"extent MiB"KNRM, KWHT_b"   rss MiB"KNRM, KWHT_b"  heap MiB"KNRM);
+
+    s->ops = 0;
+    s->ns = 0;
+    s->peak_live = 0;
+    s->peak_extent = 0;
+
+    for (uint32_t round = 0; round < opts->rounds && s->oom == false; ++round) {
+        char label[32];
+
+        snprintf(label, sizeof label, "%u", round);
+
+        switch (pattern) {
+        case MGR_FRAG_SAWTOOTH:
+            frag_sawtooth(s, opts->bytes, round);
+            frag_fprint_row(dest, label, s);
+            break;
+        case MGR_FRAG_INTERLEAVE:
+            frag_interleave(s, opts->bytes, round);
+            frag_fprint_row(dest, label, s);
+            frag_order_free(s, MGR_FRAG_FIFO);
+            break;
+        case MGR_FRAG_LIFO:
+        case MGR_FRAG_FIFO:
+        case MGR_FRAG_RANDOM:
+            // the row's throughput covers the fill and the frees
+            frag_order(s, opts->bytes, pattern);
+            frag_order_free(s, pattern);
+            frag_fprint_row(dest, label, s);
+            break;
+        case MGR_FRAG_ROBSON:
+            frag_robson(s, opts->bytes, round);
+            frag_fprint_row(dest, label, s);
+            break;
+        case MGR_FRAG_GROWSHRINK:
+            frag_grow(s, opts->bytes);
+            snprintf(label, sizeof label, "%u peak", round);
+            frag_fprint_row(dest, label, s);
+            frag_shrink(s, opts->bytes / MGR_FRAG_GROW_LOW);
+            snprintf(label, sizeof label, "%u low", round);
+            frag_fprint_row(dest, label, s);
+            break;
+        case MGR_FRAG_PATTERNS:
+            break;
+        }
+    }
+
+    fprintf(dest, "%s %.1lf MiB, %s %.1lf MiB (%.2lfx)\n",
+            "peak live", (double)(s->peak_live) / 1048576.0,
+            "peak extent", (double)(s->peak_extent) / 1048576.0,
+            s->peak_live > 0 ? (double)(s->peak_extent) / (double)(s->peak_live) : 0.0);
+
+    frag_free_all(s);
+}
+
+/*!
+    \brief  Runs the selected fragmentation patterns (see mgr_frag.h)
+            and outputs one table per pattern to dest
+
+    \details    Blocks are tracked in an array from the C library; only
+                the loops that allocate and free them are timed.
+
+    \param[in]  opts    suite settings
+    \param[in]  dest    destination file stream
+
+    \return     0 on success, -1 if the blocks cannot be tracked
+                or the allocator runs out of memory
+ */
+int mgr_run_frag(const mgr_frag_opts *opts, FILE *dest) {
+    frag_state s;
+
+    memset(&s, 0, sizeof s);
+
+    // every block is at least 16 bytes, and robson's survivors stay in the budget
+    s.capacity = (size_t)(opts->bytes / 16) + 2;
+    s.blocks = malloc(sizeof *s.blocks * s.capacity);
+    s.sorted = malloc(sizeof *s.sorted * s.capacity);
+    s.page_size = (uintptr_t)(sysconf(_SC_PAGESIZE));
+
+    if (s.blocks == NULL || s.sorted == NULL) {
+        fprintf(stderr, "memgrind: frag: cannot track %zu blocks\n", s.capacity);
+        free(s.blocks);
+        free(s.sorted);
+        return -1;
+    }
+
+    fprintf(dest, "\n%s (%s %llu %s, %u %s)\n",
+                  KGRN_b"fragmentation"KNRM,
+                  "budget", (unsigned long long)(opts->bytes), "bytes",
+                  opts->rounds, opts->rounds == 1 ? "round" : "rounds");
+
+    for (uint32_t i = 0; i < MGR_FRAG_PATTERNS && s.oom == false; ++i) {
+        if (opts->patterns & (1u << i)) {
+            frag_run_pattern(&s, opts, (mgr_frag_pattern)(i), dest);
+        }
+    }
+
+    if (s.oom) {
+        fprintf(stderr, "memgrind: frag: out of memory\n");
+    }
+
+    free(s.sorted);
+    free(s.blocks);
+    return s.oom ? -1 : 0;
+}
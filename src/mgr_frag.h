@@ -0,0 +1,70 @@
+/*!
+    \file       mgr_frag.h
+    \brief      Header file for the memgrind_c adversarial fragmentation suite
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Each pattern runs for a number of rounds within a budget of live
+    bytes, and is known to make some allocators hold far more memory
+    than is live:
+
+    - sawtooth: every round fills the budget with blocks larger than the
+      last round's, then frees every other one of them; the survivors
+      pin the holes, which the next round's blocks do not fit
+    - interleave: small and large blocks alternate; every large block is
+      freed, leaving holes between live small blocks that cannot
+      coalesce, and the budget is refilled with blocks slightly too
+      large for them
+    - lifo, fifo, random: the budget is filled with blocks of random
+      sizes, then freed in reverse, allocation or random order
+    - robson: in the manner of Robson's worst case, round r fills the
+      budget with blocks of 16 << r bytes, then frees every block but
+      the lowest in each aligned window of twice that size, so no block
+      of the next round fits where they were; survivors stay to the end
+    - growshrink: the live set grows to the budget (three allocations to
+      one random free), then shrinks to a sixteenth of it (three frees
+      to one allocation), every round
+
+    Rows are sampled at each round's largest live set (and, for
+    growshrink, its smallest; for lifo, fifo and random, once the
+    blocks are freed), with the throughput of the round's allocator
+    calls, the live bytes, the extent of the heap (the bytes of every
+    page that holds at least one live block, which the allocator cannot
+    give back), the resident set size and, if the backend reports it,
+    heap size. Each pattern ends with its peak extent over its peak
+    live bytes. Every block is freed between patterns.
+ */
+
+#ifndef MGR_FRAG_H
+#define MGR_FRAG_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum mgr_frag_pattern {
+    MGR_FRAG_SAWTOOTH,
+    MGR_FRAG_INTERLEAVE,
+    MGR_FRAG_LIFO,
+    MGR_FRAG_FIFO,
+    MGR_FRAG_RANDOM,
+    MGR_FRAG_ROBSON,
+    MGR_FRAG_GROWSHRINK,
+    MGR_FRAG_PATTERNS
+} mgr_frag_pattern;
+
+// every pattern, as a mask
+#define MGR_FRAG_ALL ((uint32_t)((1u << MGR_FRAG_PATTERNS) - 1))
+
+typedef struct mgr_frag_opts {
+    uint64_t bytes;         // live byte budget
+    uint32_t rounds;        // rounds per pattern
+    uint32_t patterns;      // mask of (1 << mgr_frag_pattern)
+} mgr_frag_opts;
+
+int mgr_frag_patterns_parse(const char *list, uint32_t *out);
+
+int mgr_run_frag(const mgr_frag_opts *opts, FILE *dest);
+
+#endif /* MGR_FRAG_H */
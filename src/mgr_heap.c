@@ -0,0 +1,204 @@
+/*!
+    \file       mgr_heap.c
+    \brief      Source file for memgrind_c heap introspection
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_heap.h"
+#include "mgr_alloc.h"
+
+#include <string.h>
+
+static void mgr_heap_flush(mgr_heap_walk *w) {
+    if (w->dest == NULL || w->run_count == 0) {
+        return;
+    }
+
+    fprintf(w->dest, "%c 0x%llx %llu ", w->run_free ? 'F' : 'U',
+            (unsigned long long)(w->run_addr), (unsigned long long)(w->run_size));
+
+    if (w->run_cls == MGR_HEAP_NO_CLASS) {
+        fprintf(w->dest, "-");
+    } else {
+        fprintf(w->dest, "%u", w->run_cls);
+    }
+
+    if (w->run_count > 1) {
+        fprintf(w->dest, " x%llu", (unsigned long long)(w->run_count));
+    }
+
+    fprintf(w->dest, "\n");
+    w->run_count = 0;
+}
+
+/*!
+    \brief  Counts one block (or span) of a heap walk,
+            and writes it to the snapshot, if any
+
+    \param[in]  w           walk
+    \param[in]  addr        block address
+    \param[in]  size        block size (bytes)
+    \param[in]  free_block  true if the block is free
+    \param[in]  cls         size class, or MGR_HEAP_NO_CLASS
+ */
+void mgr_heap_block(mgr_heap_walk *w, const void *addr, size_t size, bool free_block, uint32_t cls) {
+    mgr_heap_summary *s = &w->summary;
+
+    s->walked = true;
+
+    if (free_block) {
+        ++s->free_blocks;
+        s->free_bytes += size;
+        s->largest_free = size > s->largest_free ? size : s->largest_free;
+
+        if (cls < MGR_CLASSES) {
+            ++s->free_lists[cls];
+            s->classes_known = true;
+        }
+    } else {
+        ++s->used_blocks;
+        s->used_bytes += size;
+    }
+
+    const uintptr_t a = (uintptr_t)(addr);
+
+    if (w->run_count > 0 && w->run_free == free_block && w->run_cls == cls && w->run_size == size
+        && a == w->run_addr + (uintptr_t)(w->run_size * w->run_count)) {
+        ++w->run_count;
+        return;
+    }
+
+    mgr_heap_flush(w);
+
+    w->run_addr = a;
+    w->run_size = size;
+    w->run_count = 1;
+    w->run_cls = cls;
+    w->run_free = free_block;
+}
+
+/*!
+    \brief  Reports the totals of a heap that cannot be walked block by block
+
+    \param[in]  w           walk
+    \param[in]  used_bytes  bytes in use
+    \param[in]  free_blocks free blocks the allocator holds
+    \param[in]  free_bytes  their bytes
+ */
+void mgr_heap_totals(mgr_heap_walk *w, uint64_t used_bytes, uint64_t free_blocks, uint64_t free_bytes) {
+    w->summary.walked = false;
+    w->summary.used_bytes = used_bytes;
+    w->summary.free_blocks = free_blocks;
+    w->summary.free_bytes = free_bytes;
+}
+
+/*!
+    \brief  Walks the heap of the current backend
+
+    \details    For a single thread, with no test running. If dest is
+                given, the snapshot is appended to it, headed by label
+                and the backend's name and followed by the summary.
+
+    \param[in]  dest    snapshot file, or NULL
+    \param[in]  label   snapshot heading, e.g. the test's letter
+    \param[out] out     summary
+
+    \return     0 on success, -1 if the backend has no walk_fn
+                (said in the snapshot) or its walk failed
+ */
+int mgr_heap_snapshot(FILE *dest, const char *label, mgr_heap_summary *out) {
+    const mgr_backend *backend = mgr_backend_current;
+    mgr_heap_walk w;
+
+    memset(&w, 0, sizeof w);
+    memset(out, 0, sizeof *out);
+
+    if (backend->walk_fn == NULL) {
+        if (dest) {
+            fprintf(dest, "# heap %s (%s): no heap walk\n\n", label, backend->name);
+        }
+
+        return -1;
+    }
+
+    w.dest = dest;
+
+    if (dest) {
+        fprintf(dest, "# heap %s (%s)\n", label, backend->name);
+    }
+
+    const int status = backend->walk_fn(&w);
+
+    mgr_heap_flush(&w);
+    *out = w.summary;
+
+    if (dest) {
+        const double frag = mgr_heap_frag_index(out);
+
+        fprintf(dest, "# used %llu bytes, free %llu blocks %llu bytes",
+                (unsigned long long)(out->used_bytes),
+                (unsigned long long)(out->free_blocks), (unsigned long long)(out->free_bytes));
+
+        if (frag >= 0.0) {
+            fprintf(dest, ", used blocks %llu, largest free %llu bytes, fragmentation %.3lf",
+                    (unsigned long long)(out->used_blocks), (unsigned long long)(out->largest_free), frag);
+        }
+
+        fprintf(dest, "\n\n");
+    }
+
+    return status;
+}
+
+/*!
+    \brief  Fragmentation index of a walked heap
+
+    \param[in]  s   summary
+
+    \return     1 - largest free block / free bytes, in [0, 1];
+                -1 if the heap was not walked block by block
+ */
+double mgr_heap_frag_index(const mgr_heap_summary *s) {
+    if (s->walked == false) {
+        return -1.0;
+    }
+
+    return s->free_bytes > 0 ? 1.0 - ((double)(s->largest_free) / (double)(s->free_bytes)) : 0.0;
+}
+
+/*!
+    \brief  Outputs a heap summary, under a row of the results table
+
+    \param[in]  dest    destination file stream
+    \param[in]  s       summary
+ */
+void mgr_heap_fprint(FILE *dest, const mgr_heap_summary *s) {
+    if (s->walked == false) {
+        fprintf(dest, "  %-18s\t%s %.1lf KiB\t%s %llu (%.1lf KiB)\n", "heap",
+                "used", (double)(s->used_bytes) / 1024.0,
+                "free", (unsigned long long)(s->free_blocks), (double)(s->free_bytes) / 1024.0);
+        return;
+    }
+
+    fprintf(dest, "  %-18s\t%s %llu (%.1lf KiB)\t%s %llu (%.1lf KiB)\t%s %.1lf KiB\t%s %.3lf\n", "heap",
+            "used", (unsigned long long)(s->used_blocks), (double)(s->used_bytes) / 1024.0,
+            "free", (unsigned long long)(s->free_blocks), (double)(s->free_bytes) / 1024.0,
+            "largest free", (double)(s->largest_free) / 1024.0,
+            "fragmentation", mgr_heap_frag_index(s));
+
+    if (s->classes_known) {
+        fprintf(dest, "  %-18s\t", "free lists");
+
+        for (uint32_t cls = 0; cls < MGR_CLASSES; ++cls) {
+            if (s->free_lists[cls] > 0) {
+                fprintf(dest, "%zu:%llu ", mgr_class_size(cls), (unsigned long long)(s->free_lists[cls]));
+            }
+        }
+
+        fprintf(dest, "\n");
+    }
+}
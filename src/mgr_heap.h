@@ -0,0 +1,81 @@
+/*!
+    \file       mgr_heap.h
+    \brief      Header file for memgrind_c heap introspection
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    A backend that knows its own layout walks its heap into an
+    mgr_heap_walk (its walk_fn), one mgr_heap_block call per block or
+    span of unused memory; a backend that knows only totals reports
+    them with mgr_heap_totals. Either way, the walk yields a summary:
+
+    - used and free blocks, and their bytes
+    - the largest free block, and the fragmentation index,
+      1 - largest free / free bytes: 0 when all free memory is one
+      block, near 1 when it is scattered in small pieces
+    - free list lengths per size class (see mgr_classes.h), for
+      backends that keep them
+
+    and, if a snapshot file is given, one line per run of neighbouring
+    blocks of the same size, state and class:
+
+        U|F ADDRESS SIZE CLASS [xCOUNT]
+
+    where CLASS is "-" for blocks (or spans) outside of any class.
+
+    Walks are for a single thread, between tests: the pool backends
+    walk their regions, their large blocks and the calling thread's
+    cache; the arena walks spans of its chunks, not blocks; the system
+    backend reports glibc's totals, and its own malloc_info in the
+    snapshot. cgcs_malloc has no interface to walk its heap.
+ */
+
+#ifndef MGR_HEAP_H
+#define MGR_HEAP_H
+
+#include "mgr_classes.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// class of a block outside of any size class
+#define MGR_HEAP_NO_CLASS UINT32_MAX
+
+typedef struct mgr_heap_summary {
+    uint64_t used_blocks;
+    uint64_t used_bytes;
+    uint64_t free_blocks;
+    uint64_t free_bytes;
+    uint64_t largest_free;
+    uint64_t free_lists[MGR_CLASSES];   // free blocks per size class
+
+    bool walked;            // block by block, rather than totals
+    bool classes_known;     // free_lists are meaningful
+} mgr_heap_summary;
+
+/*!
+    \brief  A walk in progress, passed to a backend's walk_fn
+ */
+typedef struct mgr_heap_walk {
+    mgr_heap_summary summary;
+    FILE *dest;             // snapshot, or NULL
+
+    // run of blocks not yet written to dest
+    uintptr_t run_addr;
+    uint64_t run_size;
+    uint64_t run_count;
+    uint32_t run_cls;
+    bool run_free;
+} mgr_heap_walk;
+
+void mgr_heap_block(mgr_heap_walk *w, const void *addr, size_t size, bool free_block, uint32_t cls);
+void mgr_heap_totals(mgr_heap_walk *w, uint64_t used_bytes, uint64_t free_blocks, uint64_t free_bytes);
+
+int mgr_heap_snapshot(FILE *dest, const char *label, mgr_heap_summary *out);
+double mgr_heap_frag_index(const mgr_heap_summary *s);
+void mgr_heap_fprint(FILE *dest, const mgr_heap_summary *s);
+
+#endif /* MGR_HEAP_H */
@@ -0,0 +1,223 @@
+/*!
+    \file       mgr_hist.c
+    \brief      Source file for memgrind_c log-linear latency histograms
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#include "mgr_hist.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+    \brief  Maps a histogram bucket back to a representative value
+            (the midpoint of the range of values it covers)
+
+    \param[in]  index   bucket index
+
+    \return     representative value of the bucket
+ */
+uint64_t mgr_hist_value(size_t index) {
+    if (index < MGR_HIST_SUB_COUNT) {
+        return (uint64_t)(index);
+    }
+
+    const unsigned shift = (unsigned)(index / MGR_HIST_SUB_COUNT) - 1;
+    const uint64_t sub = (uint64_t)(index % MGR_HIST_SUB_COUNT);
+    const uint64_t lo = (MGR_HIST_SUB_COUNT + sub) << shift;
+
+    return lo + ((UINT64_C(1) << shift) >> 1);
+}
+
+/*!
+    \brief  Clears all counts of a histogram
+
+    \param[in]  h   histogram
+ */
+void mgr_hist_reset(mgr_hist *h) {
+    memset(h, 0, sizeof *h);
+    h->min = UINT64_MAX;
+}
+
+/*!
+    \brief  Adds the counts of src into dst
+
+    \param[in]  dst destination histogram
+    \param[in]  src source histogram
+ */
+void mgr_hist_merge(mgr_hist *dst, const mgr_hist *src) {
+    if (src->total == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < MGR_HIST_BUCKETS; ++i) {
+        dst->counts[i] += src->counts[i];
+    }
+
+    dst->total += src->total;
+    dst->sum += src->sum;
+    dst->min = src->min < dst->min ? src->min : dst->min;
+    dst->max = src->max > dst->max ? src->max : dst->max;
+}
+
+/*!
+    \brief  Value at percentile p of a histogram
+
+    \param[in]  h   histogram
+    \param[in]  p   percentile, in [0, 100]
+
+    \return     representative value of the bucket holding the pth
+                percentile, clamped to the exact recorded min/max;
+                0 if h is empty
+ */
+uint64_t mgr_hist_percentile(const mgr_hist *h, double p) {
+    if (h->total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)((p / 100.0) * (double)(h->total) + 0.5);
+    rank = rank < 1 ? 1 : (rank > h->total ? h->total : rank);
+
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < MGR_HIST_BUCKETS; ++i) {
+        seen += h->counts[i];
+
+        if (seen >= rank) {
+            const uint64_t value = mgr_hist_value(i);
+            return value < h->min ? h->min : (value > h->max ? h->max : value);
+        }
+    }
+
+    return h->max;
+}
+
+/*!
+    \brief  Arithmetic mean of the recorded values
+
+    \param[in]  h   histogram
+
+    \return     mean value, or 0.0 if h is empty
+ */
+double mgr_hist_mean(const mgr_hist *h) {
+    return h->total > 0 ? h->sum / (double)(h->total) : 0.0;
+}
+
+/*!
+    \brief  Allocates and resets a per-operation latency recorder
+
+    \return     a new recorder, or NULL on failure
+ */
+mgr_oplat *mgr_oplat_new(void) {
+    mgr_oplat *o = malloc(sizeof *o);
+
+    if (o) {
+        mgr_oplat_reset(o);
+    }
+
+    return o;
+}
+
+/*!
+    \brief  Releases a per-operation latency recorder
+
+    \param[in]  o   recorder
+ */
+void mgr_oplat_delete(mgr_oplat *o) {
+    free(o);
+}
+
+/*!
+    \brief  Clears all histograms of a recorder
+
+    \param[in]  o   recorder
+ */
+void mgr_oplat_reset(mgr_oplat *o) {
+    mgr_hist_reset(&o->malloc_all);
+    mgr_hist_reset(&o->free_all);
+
+    for (unsigned i = 0; i < MGR_OPLAT_CLASSES; ++i) {
+        mgr_hist_reset(&o->malloc_class[i]);
+    }
+}
+
+/*!
+    \brief  Adds all histograms of src into dst
+
+    \param[in]  dst destination recorder
+    \param[in]  src source recorder
+ */
+void mgr_oplat_merge(mgr_oplat *dst, const mgr_oplat *src) {
+    mgr_hist_merge(&dst->malloc_all, &src->malloc_all);
+    mgr_hist_merge(&dst->free_all, &src->free_all);
+
+    for (unsigned i = 0; i < MGR_OPLAT_CLASSES; ++i) {
+        mgr_hist_merge(&dst->malloc_class[i], &src->malloc_class[i]);
+    }
+}
+
+static void mgr_hist_fprint_row(FILE *dest, const char *label, const mgr_hist *h) {
+    fprintf(dest,
+            "  %-18s\t%10llu\t%8.1lf\t%8llu\t%8llu\t%8llu\t%8llu\t%8llu\n",
+            label,
+            (unsigned long long)(h->total),
+            mgr_hist_mean(h),
+            (unsigned long long)(mgr_hist_percentile(h, 50.0)),
+            (unsigned long long)(mgr_hist_percentile(h, 90.0)),
+            (unsigned long long)(mgr_hist_percentile(h, 99.0)),
+            (unsigned long long)(mgr_hist_percentile(h, 99.9)),
+            (unsigned long long)(h->max));
+}
+
+/*!
+    \brief  Prints the tail percentiles of one histogram, in
+            nanoseconds, under the same header as mgr_oplat_fprint
+
+    \param[in]  dest    destination file stream
+    \param[in]  label   row label
+    \param[in]  h       histogram
+ */
+void mgr_hist_fprint(FILE *dest, const char *label, const mgr_hist *h) {
+    fprintf(dest,
+            "  %-18s\t%10s\t%8s\t%8s\t%8s\t%8s\t%8s\t%8s\n",
+            "op (ns)", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+
+    mgr_hist_fprint_row(dest, label, h);
+}
+
+/*!
+    \brief  Prints tail percentiles of every non-empty histogram of
+            a recorder, in nanoseconds: all mallocs, all frees,
+            then mallocs per size class
+
+    \param[in]  dest    destination file stream
+    \param[in]  o       recorder
+ */
+void mgr_oplat_fprint(FILE *dest, const mgr_oplat *o) {
+    fprintf(dest,
+            "  %-18s\t%10s\t%8s\t%8s\t%8s\t%8s\t%8s\t%8s\n",
+            "op (ns)", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+
+    mgr_hist_fprint_row(dest, "malloc", &o->malloc_all);
+    mgr_hist_fprint_row(dest, "free", &o->free_all);
+
+    for (unsigned i = 0; i < MGR_OPLAT_CLASSES; ++i) {
+        if (o->malloc_class[i].total == 0) {
+            continue;
+        }
+
+        char label[32];
+        const unsigned long long hi = 1ull << i;
+        const unsigned long long lo = i == 0 ? 0 : (hi >> 1) + 1;
+
+        if (i == MGR_OPLAT_CLASSES - 1) {
+            snprintf(label, sizeof label, "malloc [%llu, ...)", lo);
+        } else {
+            snprintf(label, sizeof label, "malloc [%llu, %llu]", lo, hi);
+        }
+
+        mgr_hist_fprint_row(dest, label, &o->malloc_class[i]);
+    }
+}
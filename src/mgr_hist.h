@@ -0,0 +1,109 @@
+/*!
+    \file       mgr_hist.h
+    \brief      Header file for memgrind_c log-linear latency histograms
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#ifndef MGR_HIST_H
+#define MGR_HIST_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Log-linear (HDR-style) bucketing:
+    values below MGR_HIST_SUB_COUNT get one bucket each;
+    every power of two above that is split into MGR_HIST_SUB_COUNT
+    linear sub-buckets, so the relative error of any recorded value
+    is at most 1 / MGR_HIST_SUB_COUNT (about 3%).
+ */
+#define MGR_HIST_SUB_BITS 5
+#define MGR_HIST_SUB_COUNT (1u << MGR_HIST_SUB_BITS)
+#define MGR_HIST_BUCKETS ((64 - MGR_HIST_SUB_BITS + 1) * MGR_HIST_SUB_COUNT)
+
+// Request sizes are grouped in power-of-two classes: [0, 1], (1, 2], (2, 4]...
+#define MGR_OPLAT_CLASSES 24
+
+typedef struct mgr_hist {
+    uint64_t counts[MGR_HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double sum;
+} mgr_hist;
+
+/*!
+    \brief  Per-operation latency recorder for allocator calls
+ */
+typedef struct mgr_oplat {
+    mgr_hist malloc_all;
+    mgr_hist free_all;
+    mgr_hist malloc_class[MGR_OPLAT_CLASSES];
+} mgr_oplat;
+
+void mgr_hist_reset(mgr_hist *h);
+void mgr_hist_merge(mgr_hist *dst, const mgr_hist *src);
+uint64_t mgr_hist_percentile(const mgr_hist *h, double p);
+uint64_t mgr_hist_value(size_t index);
+double mgr_hist_mean(const mgr_hist *h);
+void mgr_hist_fprint(FILE *dest, const char *label, const mgr_hist *h);
+
+mgr_oplat *mgr_oplat_new(void);
+void mgr_oplat_delete(mgr_oplat *o);
+void mgr_oplat_reset(mgr_oplat *o);
+void mgr_oplat_merge(mgr_oplat *dst, const mgr_oplat *src);
+void mgr_oplat_fprint(FILE *dest, const mgr_oplat *o);
+
+/*!
+    \brief  Maps a value to its histogram bucket
+
+    \param[in]  value   value to map
+
+    \return     index into mgr_hist.counts
+ */
+static inline size_t mgr_hist_index(uint64_t value) {
+    if (value < MGR_HIST_SUB_COUNT) {
+        return (size_t)(value);
+    }
+
+    const unsigned msb = 63u - (unsigned)(__builtin_clzll(value));
+    const unsigned shift = msb - MGR_HIST_SUB_BITS;
+    const uint64_t sub = (value >> shift) - MGR_HIST_SUB_COUNT;
+
+    return (size_t)(MGR_HIST_SUB_COUNT + (shift * MGR_HIST_SUB_COUNT) + sub);
+}
+
+/*!
+    \brief  Records one value into a histogram, in O(1)
+
+    \param[in]  h       histogram
+    \param[in]  value   value to record
+ */
+static inline void mgr_hist_record(mgr_hist *h, uint64_t value) {
+    ++h->counts[mgr_hist_index(value)];
+    ++h->total;
+    h->sum += (double)(value);
+    h->min = value < h->min ? value : h->min;
+    h->max = value > h->max ? value : h->max;
+}
+
+/*!
+    \brief  Maps an allocation request size to its power-of-two size class
+
+    \param[in]  size    request size, in bytes
+
+    \return     size class in [0, MGR_OPLAT_CLASSES)
+ */
+static inline unsigned mgr_size_class(size_t size) {
+    if (size <= 1) {
+        return 0;
+    }
+
+    const unsigned cls = 64u - (unsigned)(__builtin_clzll((unsigned long long)(size - 1)));
+    return cls < MGR_OPLAT_CLASSES ? cls : MGR_OPLAT_CLASSES - 1;
+}
+
+#endif /* MGR_HIST_H */
@@ -0,0 +1,359 @@
+/*!
+    \file       mgr_locality.c
+    \brief      Source file for the memgrind_c cache-locality workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_locality.h"
+#include "mgr_alloc.h"
+#include "mgr_rand.h"
+#include "mgr_workload.h"
+
+_Thread_local mgr_traversal mgr_traversal_tls;
+_Thread_local mgr_perf *mgr_traversal_perf = NULL;
+
+// noise blocks are [MGR_NOISE_MIN, MGR_NOISE_MAX] bytes
+#define MGR_NOISE_MIN 16
+#define MGR_NOISE_MAX 256
+
+// chain length a hash table is sized for
+#define MGR_HASH_LOAD 4
+
+typedef struct list_node {
+    struct list_node *next;
+    uint64_t key;
+    uint64_t value;
+} list_node;
+
+typedef struct tree_node {
+    struct tree_node *left;
+    struct tree_node *right;
+    uint64_t key;
+    uint64_t value;
+} tree_node;
+
+typedef struct hash_node {
+    struct hash_node *next;
+    uint64_t key;
+    uint64_t value;
+} hash_node;
+
+// keeps traversal results alive
+static volatile uint64_t mgr_locality_sink;
+
+/*
+    Noise blocks, allocated between nodes and freed once the structure
+    is built; NULL blocks when there is no noise.
+ */
+typedef struct locality_noise {
+    void **blocks;
+    size_t count;
+    uint32_t per_node;
+} locality_noise;
+
+static void locality_noise_init(locality_noise *n, uint32_t nodes, uint32_t per_node) {
+    n->blocks = per_node > 0 ? mgr_malloc(sizeof *n->blocks * (size_t)(nodes) * per_node) : NULL;
+    n->count = 0;
+    n->per_node = n->blocks ? per_node : 0;
+}
+
+static void locality_noise_add(locality_noise *n) {
+    for (uint32_t i = 0; i < n->per_node; ++i) {
+        const uint32_t size = mgr_rand_range(MGR_NOISE_MIN, MGR_NOISE_MAX + 1);
+        char *ptr = mgr_malloc(size);
+
+        if (ptr) {
+            ptr[0] = (char)(size);
+            n->blocks[n->count++] = ptr;
+        }
+    }
+}
+
+static void locality_noise_free(locality_noise *n) {
+    for (size_t i = 0; i < n->count; ++i) {
+        mgr_free(n->blocks[i]);
+    }
+
+    if (n->blocks) {
+        mgr_free(n->blocks);
+    }
+}
+
+/*!
+    \brief  Test o:
+            build a linked list, then walk it
+
+    \details    nodes nodes are appended to a singly linked list, each
+                followed by noise random-size blocks, which are freed
+                once the list is built. The list is then walked from
+                head to tail passes times, reading every node, and
+                freed.
+
+                Walks are timed apart from the rest of the test and
+                shown under its row (see mgr_locality.h).
+
+    \param[in]  nodes   list length
+    \param[in]  passes  walks over the list
+    \param[in]  noise   noise blocks allocated after every node
+ */
+void mgr_list_traverse(uint32_t nodes, uint32_t passes, uint32_t noise) {
+    locality_noise n;
+    list_node *head = NULL;
+    list_node **tail = &head;
+    uint32_t length = 0;
+
+    locality_noise_init(&n, nodes, noise);
+
+    for (; length < nodes; ++length) {
+        list_node *node = mgr_malloc(sizeof *node);
+
+        if (node == NULL) {
+            break;
+        }
+
+        node->next = NULL;
+        node->key = length;
+        node->value = (uint64_t)(length) * 3;
+
+        *tail = node;
+        tail = &node->next;
+
+        locality_noise_add(&n);
+    }
+
+    locality_noise_free(&n);
+
+    const uint64_t start = mgr_traverse_begin();
+    uint64_t sum = 0;
+
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        for (const list_node *node = head; node; node = node->next) {
+            sum += node->key ^ node->value;
+        }
+    }
+
+    mgr_traverse_end(start, (uint64_t)(length) * passes);
+    mgr_locality_sink = sum;
+
+    while (head) {
+        list_node *next = head->next;
+        mgr_free(head);
+        head = next;
+    }
+}
+
+/*!
+    \brief  Test p:
+            build a binary search tree, then search it
+
+    \details    The keys 0 through nodes - 1 are inserted, in random
+                order, into an unbalanced binary search tree (expected
+                depth about 2 ln nodes); every node is followed by
+                noise random-size blocks, which are freed once the tree
+                is built. Every key is then looked up, in insertion
+                order, passes times, and the tree is freed.
+
+                Lookups are timed apart from the rest of the test and
+                shown under its row; every node on a search path counts
+                as visited (see mgr_locality.h).
+
+    \param[in]  nodes   tree size
+    \param[in]  passes  lookups of every key
+    \param[in]  noise   noise blocks allocated after every node
+ */
+void mgr_tree_traverse(uint32_t nodes, uint32_t passes, uint32_t noise) {
+    uint32_t *keys = mgr_malloc(sizeof *keys * (nodes > 0 ? nodes : 1));
+    locality_noise n;
+    tree_node *root = NULL;
+    uint32_t count = 0;
+
+    if (keys == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < nodes; ++i) {
+        keys[i] = i;
+    }
+
+    for (uint32_t i = nodes; i > 1; --i) {
+        const uint32_t j = mgr_rand_below(i);
+        const uint32_t key = keys[i - 1];
+
+        keys[i - 1] = keys[j];
+        keys[j] = key;
+    }
+
+    locality_noise_init(&n, nodes, noise);
+
+    for (; count < nodes; ++count) {
+        tree_node *node = mgr_malloc(sizeof *node);
+
+        if (node == NULL) {
+            break;
+        }
+
+        node->left = NULL;
+        node->right = NULL;
+        node->key = keys[count];
+        node->value = (uint64_t)(keys[count]) * 3;
+
+        tree_node **link = &root;
+
+        while (*link) {
+            link = node->key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+
+        *link = node;
+
+        locality_noise_add(&n);
+    }
+
+    locality_noise_free(&n);
+
+    const uint64_t start = mgr_traverse_begin();
+    uint64_t visited = 0;
+    uint64_t sum = 0;
+
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const tree_node *node = root;
+
+            while (node && node->key != keys[i]) {
+                node = keys[i] < node->key ? node->left : node->right;
+                ++visited;
+            }
+
+            if (node) {
+                sum += node->value;
+                ++visited;
+            }
+        }
+    }
+
+    mgr_traverse_end(start, visited);
+    mgr_locality_sink = sum;
+
+    // free without a stack: rotate left children up until there are none
+    while (root) {
+        if (root->left) {
+            tree_node *left = root->left;
+
+            root->left = left->right;
+            left->right = root;
+            root = left;
+        } else {
+            tree_node *right = root->right;
+            mgr_free(root);
+            root = right;
+        }
+    }
+
+    mgr_free(keys);
+}
+
+/*!
+    \brief  Test q:
+            build a chained hash table, then probe it
+
+    \details    nodes random keys are inserted at the head of their
+                chains, in a table of about nodes / MGR_HASH_LOAD
+                buckets (a power of two); every node is followed by
+                noise random-size blocks, which are freed once the
+                table is built. Every key is then looked up, in
+                insertion order, passes times, and the table is freed.
+
+                Lookups are timed apart from the rest of the test and
+                shown under its row; every node on a chain walk counts
+                as visited (see mgr_locality.h).
+
+    \param[in]  nodes   entries
+    \param[in]  passes  lookups of every key
+    \param[in]  noise   noise blocks allocated after every node
+ */
+void mgr_hash_chains(uint32_t nodes, uint32_t passes, uint32_t noise) {
+    unsigned shift = 63;
+
+    while (shift > 32 && ((uint64_t)(1) << (64 - shift)) * MGR_HASH_LOAD <= nodes) {
+        --shift;
+    }
+
+    const size_t buckets = (size_t)(1) << (64 - shift);
+    hash_node **table = mgr_calloc(buckets, sizeof *table);
+    uint64_t *keys = mgr_malloc(sizeof *keys * (nodes > 0 ? nodes : 1));
+    locality_noise n;
+    uint32_t count = 0;
+
+    if (table == NULL || keys == NULL) {
+        if (table) {
+            mgr_free(table);
+        }
+
+        if (keys) {
+            mgr_free(keys);
+        }
+
+        return;
+    }
+
+    locality_noise_init(&n, nodes, noise);
+
+    for (; count < nodes; ++count) {
+        hash_node *node = mgr_malloc(sizeof *node);
+
+        if (node == NULL) {
+            break;
+        }
+
+        keys[count] = mgr_rand_next();
+
+        const size_t bucket = (size_t)((keys[count] * UINT64_C(0x9e3779b97f4a7c15)) >> shift);
+
+        node->key = keys[count];
+        node->value = (uint64_t)(count) * 3;
+        node->next = table[bucket];
+        table[bucket] = node;
+
+        locality_noise_add(&n);
+    }
+
+    locality_noise_free(&n);
+
+    const uint64_t start = mgr_traverse_begin();
+    uint64_t visited = 0;
+    uint64_t sum = 0;
+
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const size_t bucket = (size_t)((keys[i] * UINT64_C(0x9e3779b97f4a7c15)) >> shift);
+            const hash_node *node = table[bucket];
+
+            while (node && node->key != keys[i]) {
+                node = node->next;
+                ++visited;
+            }
+
+            if (node) {
+                sum += node->value;
+                ++visited;
+            }
+        }
+    }
+
+    mgr_traverse_end(start, visited);
+    mgr_locality_sink = sum;
+
+    for (size_t i = 0; i < buckets; ++i) {
+        while (table[i]) {
+            hash_node *next = table[i]->next;
+            mgr_free(table[i]);
+            table[i] = next;
+        }
+    }
+
+    mgr_free(keys);
+    mgr_free(table);
+}
@@ -0,0 +1,75 @@
+/*!
+    \file       mgr_locality.h
+    \brief      Header file for the memgrind_c cache-locality workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    The locality workloads (tests o, p and q) build a linked structure
+    out of allocated nodes, then traverse it. Building is what the
+    allocator does; traversing is what the application does with the
+    memory it got, and its speed depends on where the allocator put
+    the nodes: next to each other, or scattered among other blocks.
+
+    To make placement matter, every node can be followed by noise
+    blocks of random sizes, which are freed once the structure is
+    built, as unrelated allocations of a real program would be.
+
+    Traversals are timed on their own, between mgr_traverse_begin and
+    mgr_traverse_end, into the calling thread's mgr_traversal_tls; if
+    mgr_traversal_perf is set, hardware counters count them as well.
+ */
+
+#ifndef MGR_LOCALITY_H
+#define MGR_LOCALITY_H
+
+#include "mgr_perf.h"
+#include "mgr_stats.h"
+
+#include <stdint.h>
+
+/*!
+    \brief  Traversal totals of a thread
+ */
+typedef struct mgr_traversal {
+    uint64_t ns;        // time spent traversing
+    uint64_t nodes;     // nodes visited
+} mgr_traversal;
+
+extern _Thread_local mgr_traversal mgr_traversal_tls;
+
+// counters started and stopped around every traversal; NULL for none
+extern _Thread_local mgr_perf *mgr_traversal_perf;
+
+/*!
+    \brief  Starts timing a traversal
+
+    \return     start time, for mgr_traverse_end
+ */
+static inline uint64_t mgr_traverse_begin(void) {
+    if (mgr_traversal_perf) {
+        mgr_perf_start(mgr_traversal_perf);
+    }
+
+    return mgr_clock_ns();
+}
+
+/*!
+    \brief  Stops timing a traversal
+
+    \param[in]  start   value returned by mgr_traverse_begin
+    \param[in]  nodes   nodes visited
+ */
+static inline void mgr_traverse_end(uint64_t start, uint64_t nodes) {
+    const uint64_t end = mgr_clock_ns();
+
+    if (mgr_traversal_perf) {
+        mgr_perf_stop(mgr_traversal_perf);
+    }
+
+    mgr_traversal_tls.ns += end - start;
+    mgr_traversal_tls.nodes += nodes;
+}
+
+#endif /* MGR_LOCALITY_H */
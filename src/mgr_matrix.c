@@ -0,0 +1,219 @@
+/*!
+    \file       mgr_matrix.c
+    \brief      Source file for the memgrind_c size class throughput matrix
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_matrix.h"
+#include "mgr_alloc.h"
+#include "mgr_rand.h"
+#include "mgr_workload.h"
+
+#include "cgcs_ulog.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint32_t mgr_matrix_default_sizes[] = {
+    8, 16, 32, 64, 128, 256, 512, 1024, 2048,
+    4095, 4096, 4097,                       // around a page
+    8192, 16384, 32768, 65536,
+    131071, 131072, 131073,                 // around glibc's mmap threshold
+    262144, 1048576, 4194304
+};
+
+static const uint32_t mgr_matrix_default_lives[] = { 1, 64, 4096 };
+
+/*
+    Live blocks of test g; kept per thread and grown with the C library,
+    outside of the allocator under test, and reused from one repetition
+    to the next.
+ */
+static _Thread_local void **churn_slots = NULL;
+static _Thread_local uint32_t churn_capacity = 0;
+
+/*!
+    \brief  Test g:
+            keep a live set of equal-size blocks, and churn through it
+
+    \details    Allocate live blocks of size bytes, then ops times,
+                free a block at random and allocate its replacement;
+                finally free every block.
+
+                The first and last byte of every block are written,
+                so a block that straddles a page costs what it would
+                in a program that uses it.
+
+    \param[in]  size    block size (bytes)
+    \param[in]  live    live set size (blocks)
+    \param[in]  ops     replacements (one free and one malloc each)
+ */
+void mgr_size_class_churn(uint32_t size, uint32_t live, uint32_t ops) {
+    if (live == 0) {
+        return;
+    }
+
+    if (live > churn_capacity) {
+        void **slots = realloc(churn_slots, sizeof *slots * live);
+
+        if (slots == NULL) {
+            return;
+        }
+
+        churn_slots = slots;
+        churn_capacity = live;
+    }
+
+    for (uint32_t i = 0; i < live; ++i) {
+        char *ptr = mgr_malloc(size);
+
+        if (ptr && size > 0) {
+            ptr[0] = (char)(i);
+            ptr[size - 1] = (char)(i);
+        }
+
+        churn_slots[i] = ptr;
+    }
+
+    for (uint32_t i = 0; i < ops; ++i) {
+        const uint32_t slot = mgr_rand_below(live);
+
+        if (churn_slots[slot]) {
+            mgr_free(churn_slots[slot]);
+        }
+
+        char *ptr = mgr_malloc(size);
+
+        if (ptr && size > 0) {
+            ptr[0] = (char)(i);
+            ptr[size - 1] = (char)(i);
+        }
+
+        churn_slots[slot] = ptr;
+    }
+
+    for (uint32_t i = 0; i < live; ++i) {
+        if (churn_slots[i]) {
+            mgr_free(churn_slots[i]);
+        }
+    }
+}
+
+/*!
+    \brief  Sets the default grid (see mgr_matrix.h)
+
+    \param[out] m   matrix grid
+ */
+void mgr_matrix_defaults(mgr_matrix *m) {
+    m->nsizes = sizeof mgr_matrix_default_sizes / sizeof *mgr_matrix_default_sizes;
+    m->nlives = sizeof mgr_matrix_default_lives / sizeof *mgr_matrix_default_lives;
+
+    memcpy(m->sizes, mgr_matrix_default_sizes, sizeof mgr_matrix_default_sizes);
+    memcpy(m->lives, mgr_matrix_default_lives, sizeof mgr_matrix_default_lives);
+}
+
+/*!
+    \brief  Parses one axis of the grid: a comma-separated list of
+            positive integers, each optionally suffixed K or M (binary)
+
+    \param[in]  key     option key, for error messages
+    \param[in]  value   list, e.g. "64,4K,1M"
+    \param[out] axis    values, at most MGR_MATRIX_MAX
+    \param[out] count   number of values
+
+    \return     0 on success, -1 if the list is invalid (reported on stderr)
+ */
+int mgr_matrix_parse_axis(const char *key, const char *value, uint32_t *axis, uint32_t *count) {
+    uint32_t n = 0;
+    const char *s = value;
+
+    while (*s) {
+        char *end = NULL;
+
+        errno = 0;
+        unsigned long long v = strtoull(s, &end, 10);
+
+        if (*end == 'K' || *end == 'k') {
+            v <<= 10;
+            ++end;
+        } else if (*end == 'M' || *end == 'm') {
+            v <<= 20;
+            ++end;
+        }
+
+        if (errno != 0 || end == s || *s == '-' || v == 0 || v > UINT32_MAX || (*end != ',' && *end != '\0')) {
+            fprintf(stderr, "memgrind: %s: '%s' is not a list of positive sizes\n", key, value);
+            return -1;
+        }
+
+        if (n == MGR_MATRIX_MAX) {
+            fprintf(stderr, "memgrind: %s: at most %d values\n", key, MGR_MATRIX_MAX);
+            return -1;
+        }
+
+        axis[n++] = (uint32_t)(v);
+        s = *end == ',' ? end + 1 : end;
+    }
+
+    if (n == 0) {
+        fprintf(stderr, "memgrind: %s: empty list\n", key);
+        return -1;
+    }
+
+    *count = n;
+    return 0;
+}
+
+static void mgr_matrix_fprint_table(FILE *dest, const mgr_matrix *m, const double *ns_per_op,
+                                    const char *title, bool throughput) {
+    fprintf(dest, "\n%s\n%s%-10s%s", title, KWHT_b, "size", KNRM);
+
+    for (uint32_t j = 0; j < m->nlives; ++j) {
+        char live[32];
+        snprintf(live, sizeof live, "live=%u", m->lives[j]);
+        fprintf(dest, "\t%12s", live);
+    }
+
+    fprintf(dest, "\n");
+
+    for (uint32_t i = 0; i < m->nsizes; ++i) {
+        fprintf(dest, "%s%-10u%s", KGRN_b, m->sizes[i], KNRM);
+
+        for (uint32_t j = 0; j < m->nlives; ++j) {
+            const double ns = ns_per_op[(j * m->nsizes) + i];
+
+            if (ns < 0.0) {
+                fprintf(dest, "\t%12s", "-");
+            } else if (throughput) {
+                fprintf(dest, "\t%12.2lf", ns > 0.0 ? 1000.0 / ns : 0.0);
+            } else {
+                fprintf(dest, "\t%12.1lf", ns);
+            }
+        }
+
+        fprintf(dest, "\n");
+    }
+}
+
+/*!
+    \brief  Prints the matrix as two tables, ns per allocator call
+            and millions of allocator calls per second; a block size
+            per row, a live set size per column
+
+    \param[in]  dest        destination file stream
+    \param[in]  m           matrix grid
+    \param[in]  ns_per_op   cell (live j, size i) at j * m->nsizes + i;
+                            negative for a cell that was skipped
+ */
+void mgr_matrix_fprint(FILE *dest, const mgr_matrix *m, const double *ns_per_op) {
+    mgr_matrix_fprint_table(dest, m, ns_per_op, KGRN_b"ns per allocator call"KNRM" (median repetition)", false);
+    mgr_matrix_fprint_table(dest, m, ns_per_op, KGRN_b"millions of allocator calls per second"KNRM, true);
+
+    fprintf(dest, "\n(- : live set over %llu MiB, skipped)\n",
+            (unsigned long long)(MGR_MATRIX_BYTES_MAX >> 20));
+}
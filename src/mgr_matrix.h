@@ -0,0 +1,58 @@
+/*!
+    \file       mgr_matrix.h
+    \brief      Header file for the memgrind_c size class throughput matrix
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    The matrix runs test g (fixed-size churn, see mgr_size_class_churn)
+    over a grid of block sizes and live set sizes, and reports ns per
+    allocator call and millions of calls per second for every cell.
+
+    The default sizes run from 8 bytes to 4 MiB in powers of two, with
+    sizes one byte either side of a 4 KiB page and of glibc's default
+    mmap threshold (128 KiB) added, where allocators tend to change
+    strategy. Cells whose live set would exceed MGR_MATRIX_BYTES_MAX
+    are skipped.
+ */
+
+#ifndef MGR_MATRIX_H
+#define MGR_MATRIX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// most sizes (or live set sizes) on one axis
+#define MGR_MATRIX_MAX 32
+
+// largest live set of a cell, size * live, in bytes
+#define MGR_MATRIX_BYTES_MAX ((uint64_t)(256) << 20)
+
+typedef struct mgr_matrix {
+    uint32_t sizes[MGR_MATRIX_MAX];     // block sizes (rows)
+    uint32_t nsizes;
+    uint32_t lives[MGR_MATRIX_MAX];     // live set sizes (columns)
+    uint32_t nlives;
+} mgr_matrix;
+
+void mgr_matrix_defaults(mgr_matrix *m);
+int mgr_matrix_parse_axis(const char *key, const char *value, uint32_t *axis, uint32_t *count);
+
+/*!
+    \brief  Whether a cell of the matrix is run
+
+    \param[in]  size    block size
+    \param[in]  live    live set size
+
+    \return     true if the live set fits MGR_MATRIX_BYTES_MAX
+ */
+static inline bool mgr_matrix_fits(uint32_t size, uint32_t live) {
+    return (uint64_t)(size) * (uint64_t)(live) <= MGR_MATRIX_BYTES_MAX;
+}
+
+void mgr_matrix_fprint(FILE *dest, const mgr_matrix *m, const double *ns_per_op);
+
+#endif /* MGR_MATRIX_H */
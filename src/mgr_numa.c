@@ -0,0 +1,400 @@
+/*!
+    \file       mgr_numa.c
+    \brief      Source file for the memgrind_c NUMA placement benchmark
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    No NUMA library is needed: the topology comes from sysfs, threads
+    are placed with the same pinning as threaded runs, and pages are
+    placed by first touch. Where the kernel supports move_pages, the
+    node the blocks actually landed on is checked and printed.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "mgr_numa.h"
+#include "mgr_alloc.h"
+#include "mgr_rand.h"
+#include "mgr_stats.h"
+#include "mgr_thread.h"
+
+#include "cgcs_ulog.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// most nodes benchmarked (every pair of them is run)
+#define MGR_NUMA_NODES_MAX 16
+
+// blocks whose page placement is checked per pair
+#define MGR_NUMA_PROBES 16
+
+typedef struct numa_node {
+    int id;
+    int cpus[2];            // first two cpus of the node; the second may be -1
+} numa_node;
+
+typedef struct numa_topology {
+    numa_node nodes[MGR_NUMA_NODES_MAX];
+    uint32_t count;
+    bool known;             // false: sysfs unavailable, one pseudo-node
+} numa_topology;
+
+typedef struct numa_job {
+    const mgr_numa_opts *opts;
+    int cpu;                // to pin to
+    int pinned;             // cpu pinned to, -1 if unpinned
+    uint64_t stream;        // random stream
+
+    void **blocks;          // in chase order
+    uint32_t count;         // blocks allocated
+
+    uint64_t malloc_ns;
+    uint64_t access_ns;
+    uint64_t free_ns;
+} numa_job;
+
+/*
+    Reads the first max entries of a sysfs list ("0-3,8,10-11")
+    from path; returns how many there were, or -1 if path is unreadable.
+ */
+static int numa_read_list(const char *path, int *out, int max) {
+    FILE *fp = fopen(path, "r");
+    char line[4096];
+    int n = 0;
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    if (fgets(line, sizeof line, fp) == NULL) {
+        line[0] = '\0';
+    }
+
+    fclose(fp);
+
+    for (char *s = line; *s && *s != '\n' && n < max;) {
+        char *end = NULL;
+        long first = strtol(s, &end, 10);
+        long last = first;
+
+        if (end == s) {
+            break;
+        }
+
+        if (*end == '-') {
+            s = end + 1;
+            last = strtol(s, &end, 10);
+        }
+
+        for (long i = first; i <= last && n < max; ++i) {
+            out[n++] = (int)(i);
+        }
+
+        s = *end == ',' ? end + 1 : end;
+
+        if (end == s) {
+            break;
+        }
+    }
+
+    return n;
+}
+
+static void numa_topology_read(numa_topology *t) {
+    int ids[MGR_NUMA_NODES_MAX];
+    const int n = numa_read_list("/sys/devices/system/node/online", ids, MGR_NUMA_NODES_MAX);
+
+    t->count = 0;
+
+    for (int i = 0; i < n; ++i) {
+        char path[128];
+        int cpus[2] = { -1, -1 };
+
+        snprintf(path, sizeof path, "/sys/devices/system/node/node%d/cpulist", ids[i]);
+
+        if (numa_read_list(path, cpus, 2) > 0) {          // memory-only nodes are left out
+            numa_node *node = t->nodes + t->count++;
+
+            node->id = ids[i];
+            node->cpus[0] = cpus[0];
+            node->cpus[1] = cpus[1];
+        }
+    }
+
+    t->known = t->count > 0;
+
+    if (t->known == false) {
+        t->count = 1;
+        t->nodes[0].id = 0;
+        t->nodes[0].cpus[0] = 0;
+        t->nodes[0].cpus[1] = mgr_cpu_count() > 1 ? 1 : -1;
+    }
+}
+
+/*
+    Node that most of the probed blocks' pages are on, -2 if they
+    are split between nodes, -1 if the kernel cannot tell.
+ */
+static int numa_page_node(void **blocks, uint32_t count) {
+#if defined(__linux__) && defined(SYS_move_pages)
+    void *pages[MGR_NUMA_PROBES];
+    int status[MGR_NUMA_PROBES];
+    const uint32_t n = count < MGR_NUMA_PROBES ? count : MGR_NUMA_PROBES;
+    const uintptr_t page_size = (uintptr_t)(sysconf(_SC_PAGESIZE));
+    int node = -1;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        pages[i] = (void *)((uintptr_t)(blocks[(uint64_t)(i) * count / n]) & ~(page_size - 1));
+    }
+
+    // with no target nodes, move_pages only reports where the pages are
+    if (n == 0 || syscall(SYS_move_pages, 0, (unsigned long)(n), pages, NULL, status, 0) != 0) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        if (status[i] < 0) {
+            return -1;
+        }
+
+        if (node >= 0 && status[i] != node) {
+            return -2;
+        }
+
+        node = status[i];
+    }
+
+    return node;
+#else
+    (void)(blocks);
+    (void)(count);
+    return -1;
+#endif
+}
+
+// allocates, writes and links the blocks, on the alloc node
+static void *numa_alloc_main(void *arg) {
+    numa_job *job = arg;
+    const uint32_t size = job->opts->size;
+
+    job->pinned = mgr_pin(job->cpu);
+    mgr_rand_seed_thread(job->stream);
+
+    const uint64_t x = mgr_clock_ns();
+
+    for (job->count = 0; job->count < job->opts->count; ++job->count) {
+        void *ptr = mgr_malloc(size);
+
+        if (ptr == NULL) {
+            break;
+        }
+
+        job->blocks[job->count] = ptr;
+    }
+
+    const uint64_t y = mgr_clock_ns();
+
+    job->malloc_ns = y - x;
+
+    for (uint32_t i = 0; i < job->count; ++i) {
+        memset(job->blocks[i], 0xa5, size);           // first touch
+    }
+
+    for (uint32_t i = job->count; i > 1; --i) {
+        const uint32_t j = mgr_rand_below(i);
+        void *block = job->blocks[i - 1];
+
+        job->blocks[i - 1] = job->blocks[j];
+        job->blocks[j] = block;
+    }
+
+    for (uint32_t i = 0; i < job->count; ++i) {
+        *(void **)(job->blocks[i]) = job->blocks[(i + 1) % job->count];
+    }
+
+    return NULL;
+}
+
+// chases the cycle, then frees every block, on the use node
+static void *numa_use_main(void *arg) {
+    numa_job *job = arg;
+    void *volatile sink = NULL;
+
+    job->pinned = mgr_pin(job->cpu);
+
+    if (job->count > 0) {
+        void *p = job->blocks[0];
+        const uint64_t hops = (uint64_t)(job->count) * job->opts->passes;
+
+        const uint64_t x = mgr_clock_ns();
+
+        for (uint64_t i = 0; i < hops; ++i) {
+            p = *(void **)(p);
+        }
+
+        const uint64_t y = mgr_clock_ns();
+
+        sink = p;
+        job->access_ns = y - x;
+    }
+
+    const uint64_t x = mgr_clock_ns();
+
+    for (uint32_t i = 0; i < job->count; ++i) {
+        mgr_free(job->blocks[i]);
+    }
+
+    const uint64_t y = mgr_clock_ns();
+
+    job->free_ns = y - x;
+    (void)(sink);
+
+    return NULL;
+}
+
+static int numa_run_on(void *(*fn)(void *), numa_job *job) {
+    pthread_t tid;
+
+    if (pthread_create(&tid, NULL, fn, job) != 0) {
+        return -1;
+    }
+
+    pthread_join(tid, NULL);
+    return 0;
+}
+
+static void numa_fprint_cpu(FILE *dest, int node, int cpu) {
+    char label[32];
+
+    if (cpu >= 0) {
+        snprintf(label, sizeof label, "%d (cpu %d)", node, cpu);
+    } else {
+        snprintf(label, sizeof label, "%d (unpinned)", node);
+    }
+
+    fprintf(dest, "%-16s\t", label);
+}
+
+/*!
+    \brief  Runs the NUMA benchmark (see mgr_numa.h) and outputs one row
+            per pair of nodes to dest
+
+    \details    Threads run one at a time, so backends that are not
+                thread-safe need no lock. The blocks' addresses are
+                kept in an array from the C library.
+
+    \param[in]  opts    benchmark settings
+    \param[in]  dest    destination file stream
+
+    \return     0 on success, -1 if a thread could not be created
+                or the blocks cannot be tracked
+ */
+int mgr_run_numa(const mgr_numa_opts *opts, FILE *dest) {
+    numa_topology topo;
+    numa_job job;
+    int status = 0;
+
+    numa_topology_read(&topo);
+
+    memset(&job, 0, sizeof job);
+    job.opts = opts;
+    job.blocks = malloc(sizeof *job.blocks * (opts->count > 0 ? opts->count : 1));
+
+    if (job.blocks == NULL || opts->size < sizeof(void *)) {
+        fprintf(stderr, "memgrind: numa: %s\n", job.blocks ? "blocks must hold a pointer" : "cannot track the blocks");
+        free(job.blocks);
+        return -1;
+    }
+
+    fprintf(dest, "\n%s (%u %s, %u %s of %u %s, %u %s)\n",
+                  KGRN_b"numa"KNRM,
+                  topo.count, topo.count == 1 ? "node" : "nodes",
+                  opts->count, "blocks", opts->size, "bytes",
+                  opts->passes, opts->passes == 1 ? "pass" : "passes");
+
+    if (topo.known == false) {
+        fprintf(dest, "%s\n", "NUMA topology unavailable; running as a single node");
+    } else if (topo.count == 1) {
+        fprintf(dest, "%s\n", "single NUMA node; local pair only");
+    }
+
+    fprintf(dest, "\n%s\t\t%s\t\t%s\t%s\t%s\t%s\n",
+            KWHT_b"alloc node"KNRM, KWHT_b"use node"KNRM, KWHT_b"pages on"KNRM,
+            KWHT_b"malloc ns"KNRM, KWHT_b"access ns"KNRM, KWHT_b"free ns"KNRM);
+
+    for (uint32_t a = 0; a < topo.count && status == 0; ++a) {
+        for (uint32_t u = 0; u < topo.count && status == 0; ++u) {
+            const numa_node *alloc = topo.nodes + a;
+            const numa_node *use = topo.nodes + u;
+
+            // a local pair uses a second cpu of the node, if it has one
+            const int use_cpu = a == u && use->cpus[1] >= 0 ? use->cpus[1] : use->cpus[0];
+
+            job.cpu = alloc->cpus[0];
+            job.stream = ((uint64_t)(a) * MGR_NUMA_NODES_MAX) + u + 1;
+            job.malloc_ns = job.access_ns = job.free_ns = 0;
+
+            if (numa_run_on(numa_alloc_main, &job) != 0) {
+                status = -1;
+                break;
+            }
+
+            const int alloc_pinned = job.pinned;
+            const int pages = numa_page_node(job.blocks, job.count);
+
+            job.cpu = use_cpu;
+
+            if (numa_run_on(numa_use_main, &job) != 0) {
+                // no thread to free them on: free them here
+                for (uint32_t i = 0; i < job.count; ++i) {
+                    mgr_free(job.blocks[i]);
+                }
+
+                status = -1;
+                break;
+            }
+
+            const double count = job.count > 0 ? (double)(job.count) : 1.0;
+            const double hops = count * (opts->passes > 0 ? opts->passes : 1);
+
+            numa_fprint_cpu(dest, alloc->id, alloc_pinned);
+            numa_fprint_cpu(dest, use->id, job.pinned);
+
+            if (pages >= 0) {
+                fprintf(dest, "%8d", pages);
+            } else {
+                fprintf(dest, "%8s", pages == -2 ? "mixed" : "-");
+            }
+
+            fprintf(dest, "\t%9.1lf\t%9.1lf\t%7.1lf\n",
+                    (double)(job.malloc_ns) / count,
+                    (double)(job.access_ns) / hops,
+                    (double)(job.free_ns) / count);
+
+            if (job.count < opts->count) {
+                fprintf(stderr, "memgrind: numa: out of memory after %u blocks\n", job.count);
+            }
+        }
+    }
+
+    if (status != 0) {
+        fprintf(stderr, "memgrind: numa: thread creation failed\n");
+    }
+
+    free(job.blocks);
+    return status;
+}
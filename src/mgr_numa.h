@@ -0,0 +1,38 @@
+/*!
+    \file       mgr_numa.h
+    \brief      Header file for the memgrind_c NUMA placement benchmark
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    For every pair of NUMA nodes (alloc, use), including a node with
+    itself, a thread pinned to a cpu of node alloc allocates count
+    blocks of size bytes through the current backend, writes every
+    block (so that, under the default first-touch policy, its pages
+    are placed on alloc), and links the blocks into one random cycle.
+    Then a thread pinned to a cpu of node use chases that cycle
+    passes times (one dependent load per block: access latency) and
+    frees every block (cross-node free cost). Pairs where alloc and
+    use are the same node are the local baseline; they still use two
+    threads, on two cpus where the node has them.
+
+    Nodes and their cpus are read from sysfs (Linux). Without it, or
+    on a single-node machine, the benchmark runs the local pair only.
+ */
+
+#ifndef MGR_NUMA_H
+#define MGR_NUMA_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct mgr_numa_opts {
+    uint32_t count;         // blocks per pair
+    uint32_t size;          // block size (bytes)
+    uint32_t passes;        // chases over the cycle
+} mgr_numa_opts;
+
+int mgr_run_numa(const mgr_numa_opts *opts, FILE *dest);
+
+#endif /* MGR_NUMA_H */
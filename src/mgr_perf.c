@@ -0,0 +1,303 @@
+/*!
+    \file       mgr_perf.c
+    \brief      Source file for memgrind_c hardware performance counters
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "mgr_perf.h"
+
+#include <errno.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char *const mgr_perf_event_names[MGR_PERF_EVENTS] = {
+    "cycles",
+    "instructions",
+    "L1d misses",
+    "LLC misses",
+    "dTLB misses",
+    "branch misses"
+};
+
+// names in JSON/CSV reports
+const char *const mgr_perf_event_keys[MGR_PERF_EVENTS] = {
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "dtlb_misses",
+    "branch_misses"
+};
+
+#ifdef __linux__
+
+#define MGR_HW_CACHE(cache, op, result) \
+    ((cache) | ((op) << 8) | ((result) << 16))
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} mgr_perf_events[MGR_PERF_EVENTS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, MGR_HW_CACHE(PERF_COUNT_HW_CACHE_L1D,
+                                       PERF_COUNT_HW_CACHE_OP_READ,
+                                       PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HW_CACHE, MGR_HW_CACHE(PERF_COUNT_HW_CACHE_DTLB,
+                                       PERF_COUNT_HW_CACHE_OP_READ,
+                                       PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+};
+
+static int perf_event_open(struct perf_event_attr *attr) {
+    // this thread, any cpu, no group
+    return (int)(syscall(SYS_perf_event_open, attr, 0, -1, -1, 0));
+}
+
+static int mgr_perf_paranoid(void) {
+    FILE *file = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+    int level = -100;
+
+    if (file) {
+        if (fscanf(file, "%d", &level) != 1) {
+            level = -100;
+        }
+
+        fclose(file);
+    }
+
+    return level;
+}
+
+#endif
+
+/*!
+    \brief  Opens the counters for the calling thread, disabled
+
+    \param[out] p       counters
+    \param[out] reason  why no counters could be opened
+    \param[in]  size    size of reason
+
+    \return     0 if at least one counter is open, -1 otherwise
+ */
+int mgr_perf_open(mgr_perf *p, char *reason, size_t size) {
+    p->nopen = 0;
+
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        p->fds[i] = -1;
+    }
+
+#ifdef __linux__
+    int error = 0;
+
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = mgr_perf_events[i].type;
+        attr.config = mgr_perf_events[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const int fd = perf_event_open(&attr);
+
+        if (fd < 0) {
+            error = error ? error : errno;
+            continue;
+        }
+
+        p->fds[i] = fd;
+        ++p->nopen;
+    }
+
+    if (p->nopen == 0) {
+        if (error == EACCES || error == EPERM) {
+            snprintf(reason, size, "%s (kernel.perf_event_paranoid is %d)",
+                     strerror(error), mgr_perf_paranoid());
+        } else if (error == ENOENT || error == EOPNOTSUPP) {
+            snprintf(reason, size, "%s", "the cpu (or hypervisor) exposes no hardware counters");
+        } else {
+            snprintf(reason, size, "%s", strerror(error));
+        }
+
+        return -1;
+    }
+
+    return 0;
+#else
+    snprintf(reason, size, "%s", "not supported on this platform");
+    return -1;
+#endif
+}
+
+/*!
+    \brief  Closes every counter
+
+    \param[in]  p   counters
+ */
+void mgr_perf_close(mgr_perf *p) {
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+#ifdef __linux__
+        if (p->fds[i] >= 0) {
+            close(p->fds[i]);
+        }
+#endif
+
+        p->fds[i] = -1;
+    }
+
+    p->nopen = 0;
+}
+
+#ifdef __linux__
+static void mgr_perf_ioctl(mgr_perf *p, unsigned long request) {
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        if (p->fds[i] >= 0) {
+            ioctl(p->fds[i], request, 0);
+        }
+    }
+}
+#endif
+
+/*!
+    \brief  Zeroes the counters
+
+    \param[in]  p   counters
+ */
+void mgr_perf_reset(mgr_perf *p) {
+#ifdef __linux__
+    mgr_perf_ioctl(p, PERF_EVENT_IOC_RESET);
+#else
+    (void)(p);
+#endif
+}
+
+/*!
+    \brief  Starts counting (counts accumulate until mgr_perf_reset)
+
+    \param[in]  p   counters
+ */
+void mgr_perf_start(mgr_perf *p) {
+#ifdef __linux__
+    mgr_perf_ioctl(p, PERF_EVENT_IOC_ENABLE);
+#else
+    (void)(p);
+#endif
+}
+
+/*!
+    \brief  Stops counting
+
+    \param[in]  p   counters
+ */
+void mgr_perf_stop(mgr_perf *p) {
+#ifdef __linux__
+    mgr_perf_ioctl(p, PERF_EVENT_IOC_DISABLE);
+#else
+    (void)(p);
+#endif
+}
+
+/*!
+    \brief  Reads the counter totals
+
+    \details    If the PMU was multiplexed between more events than it
+                has counters for, each value is scaled up by the share
+                of time its event was actually counting.
+
+    \param[in]  p   counters
+    \param[out] out counter totals
+
+    \return     0 on success, -1 if the counters could not be read
+ */
+int mgr_perf_read(mgr_perf *p, mgr_perf_counts *out) {
+    memset(out, 0, sizeof *out);
+
+#ifdef __linux__
+    out->running_ratio = 1.0;
+
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        uint64_t buffer[3];     // value, time enabled, time running
+
+        if (p->fds[i] < 0 || read(p->fds[i], buffer, sizeof buffer) != (ssize_t)(sizeof buffer)) {
+            continue;
+        }
+
+        if (buffer[2] == 0) {
+            continue;           // never scheduled onto the PMU
+        }
+
+        const double ratio = buffer[1] > 0 ? (double)(buffer[2]) / (double)(buffer[1]) : 1.0;
+
+        out->values[i] = (uint64_t)((double)(buffer[0]) / ratio);
+        out->valid[i] = true;
+        out->running_ratio = ratio < out->running_ratio ? ratio : out->running_ratio;
+    }
+
+    return p->nopen > 0 ? 0 : -1;
+#else
+    (void)(p);
+    return -1;
+#endif
+}
+
+static void mgr_perf_fprint_row(FILE *dest, const char *label, double per_rep, double per_op) {
+    fprintf(dest, "  %-18s\t%12.1lf\t%10.3lf\n", label, per_rep, per_op);
+}
+
+/*!
+    \brief  Prints the counters per repetition and per unit of work
+            (an allocator call, a node visited...), with instructions
+            per cycle
+
+    \param[in]  dest    destination file stream
+    \param[in]  title   heading of the table, e.g. "perf counter"
+    \param[in]  c       counter totals over all repetitions
+    \param[in]  reps    timed repetitions
+    \param[in]  units   units of work over all repetitions
+    \param[in]  unit    name of a unit of work, e.g. "op"
+ */
+void mgr_perf_fprint(FILE *dest, const char *title, const mgr_perf_counts *c,
+                     uint64_t reps, uint64_t units, const char *unit) {
+    const double nreps = reps > 0 ? (double)(reps) : 1.0;
+    const double nunits = units > 0 ? (double)(units) : 1.0;
+    char per_unit[32];
+
+    snprintf(per_unit, sizeof per_unit, "per %s", unit);
+    fprintf(dest, "  %-18s\t%12s\t%10s\n", title, "per rep", per_unit);
+
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        if (c->valid[i]) {
+            mgr_perf_fprint_row(dest, mgr_perf_event_names[i],
+                                (double)(c->values[i]) / nreps,
+                                (double)(c->values[i]) / nunits);
+        }
+    }
+
+    if (c->valid[MGR_PERF_CYCLES] && c->valid[MGR_PERF_INSTRUCTIONS] && c->values[MGR_PERF_CYCLES] > 0) {
+        fprintf(dest, "  %-18s\t%12.3lf\n", "IPC",
+                (double)(c->values[MGR_PERF_INSTRUCTIONS]) / (double)(c->values[MGR_PERF_CYCLES]));
+    }
+
+    if (c->running_ratio < 1.0) {
+        fprintf(dest, "  (counters multiplexed, scaled from %.0lf%% of the run)\n", c->running_ratio * 100.0);
+    }
+}
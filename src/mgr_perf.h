@@ -0,0 +1,67 @@
+/*!
+    \file       mgr_perf.h
+    \brief      Header file for memgrind_c hardware performance counters
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    On Linux, counters are read through perf_event_open, counting user
+    space only, so that perf_event_paranoid up to 2 permits them. Each
+    event is opened on its own rather than as a group, so a PMU with
+    fewer free counters than events multiplexes them (and the values
+    are scaled) instead of counting nothing. Events the cpu or
+    hypervisor does not support are left out.
+
+    Elsewhere, or when perf access is denied, mgr_perf_open fails with
+    a reason and the caller carries on without counters.
+ */
+
+#ifndef MGR_PERF_H
+#define MGR_PERF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum mgr_perf_event {
+    MGR_PERF_CYCLES,
+    MGR_PERF_INSTRUCTIONS,
+    MGR_PERF_L1D_MISSES,
+    MGR_PERF_LLC_MISSES,
+    MGR_PERF_DTLB_MISSES,
+    MGR_PERF_BRANCH_MISSES,
+    MGR_PERF_EVENTS
+} mgr_perf_event;
+
+/*!
+    \brief  Counter totals over a measurement
+ */
+typedef struct mgr_perf_counts {
+    uint64_t values[MGR_PERF_EVENTS];
+    bool valid[MGR_PERF_EVENTS];    // false: event not counted
+
+    // < 1.0 when the PMU was shared and values were scaled up (the least share)
+    double running_ratio;
+} mgr_perf_counts;
+
+typedef struct mgr_perf {
+    int fds[MGR_PERF_EVENTS];       // -1: event not counted
+    int nopen;
+} mgr_perf;
+
+extern const char *const mgr_perf_event_names[MGR_PERF_EVENTS];
+extern const char *const mgr_perf_event_keys[MGR_PERF_EVENTS];
+
+int mgr_perf_open(mgr_perf *p, char *reason, size_t size);
+void mgr_perf_close(mgr_perf *p);
+
+void mgr_perf_reset(mgr_perf *p);
+void mgr_perf_start(mgr_perf *p);
+void mgr_perf_stop(mgr_perf *p);
+int mgr_perf_read(mgr_perf *p, mgr_perf_counts *out);
+
+void mgr_perf_fprint(FILE *dest, const char *title, const mgr_perf_counts *c,
+                     uint64_t reps, uint64_t units, const char *unit);
+
+#endif /* MGR_PERF_H */
@@ -0,0 +1,135 @@
+/*!
+    \file       mgr_ptrmap.c
+    \brief      Source file for the memgrind_c block address map
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#include "mgr_ptrmap.h"
+
+#include <stdlib.h>
+
+static size_t mgr_ptrmap_hash(const void *ptr, size_t capacity) {
+    const uint64_t h = ((uint64_t)(uintptr_t)(ptr) >> 4) * UINT64_C(0x9E3779B97F4A7C15);
+    return (size_t)(h >> 32) & (capacity - 1);
+}
+
+static int mgr_ptrmap_grow(mgr_ptrmap *m) {
+    const size_t capacity = m->capacity > 0 ? m->capacity * 2 : 1024;
+    mgr_ptrmap_entry *table = calloc(capacity, sizeof *table);
+
+    if (table == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < m->capacity; ++i) {
+        if (m->table[i].ptr) {
+            size_t j = mgr_ptrmap_hash(m->table[i].ptr, capacity);
+
+            while (table[j].ptr) {
+                j = (j + 1) & (capacity - 1);
+            }
+
+            table[j] = m->table[i];
+        }
+    }
+
+    free(m->table);
+    m->table = table;
+    m->capacity = capacity;
+    return 0;
+}
+
+/*!
+    \brief  Initializes an empty map (no memory is held until the first insert)
+
+    \param[out] m   map
+ */
+void mgr_ptrmap_init(mgr_ptrmap *m) {
+    m->table = NULL;
+    m->capacity = 0;
+    m->size = 0;
+}
+
+/*!
+    \brief  Releases the memory held by a map
+
+    \param[in]  m   map
+ */
+void mgr_ptrmap_deinit(mgr_ptrmap *m) {
+    free(m->table);
+    mgr_ptrmap_init(m);
+}
+
+/*!
+    \brief  Maps ptr to value; ptr must not be in the map already
+
+    \param[in]  m       map
+    \param[in]  ptr     block address (not NULL)
+    \param[in]  value   value to keep for ptr
+
+    \return     0 on success, -1 if the map could not grow
+ */
+int mgr_ptrmap_insert(mgr_ptrmap *m, void *ptr, uint64_t value) {
+    if ((m->size + 1) * 2 > m->capacity && mgr_ptrmap_grow(m) != 0) {
+        return -1;
+    }
+
+    size_t i = mgr_ptrmap_hash(ptr, m->capacity);
+
+    while (m->table[i].ptr) {
+        i = (i + 1) & (m->capacity - 1);
+    }
+
+    m->table[i].ptr = ptr;
+    m->table[i].value = value;
+    ++m->size;
+
+    return 0;
+}
+
+/*!
+    \brief  Removes ptr from the map
+
+    \param[in]  m       map
+    \param[in]  ptr     block address
+    \param[out] value   value kept for ptr, if found
+
+    \return     true if ptr was in the map
+ */
+bool mgr_ptrmap_remove(mgr_ptrmap *m, void *ptr, uint64_t *value) {
+    if (m->capacity == 0) {
+        return false;
+    }
+
+    size_t i = mgr_ptrmap_hash(ptr, m->capacity);
+
+    while (m->table[i].ptr && m->table[i].ptr != ptr) {
+        i = (i + 1) & (m->capacity - 1);
+    }
+
+    if (m->table[i].ptr == NULL) {
+        return false;
+    }
+
+    *value = m->table[i].value;
+    size_t hole = i;
+
+    for (size_t j = (i + 1) & (m->capacity - 1); m->table[j].ptr; j = (j + 1) & (m->capacity - 1)) {
+        const size_t home = mgr_ptrmap_hash(m->table[j].ptr, m->capacity);
+
+        // move j into the hole unless its home lies cyclically in (hole, j]
+        const bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+
+        if (stays == false) {
+            m->table[hole] = m->table[j];
+            hole = j;
+        }
+    }
+
+    m->table[hole].ptr = NULL;
+    --m->size;
+
+    return true;
+}
@@ -0,0 +1,39 @@
+/*!
+    \file       mgr_ptrmap.h
+    \brief      Header file for the memgrind_c block address map
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Maps live block addresses to a value (a trace slot, a request size):
+    open addressing with linear probing, kept at most half full, and
+    backward-shift deletion, so there are no tombstones to build up
+    under malloc/free churn.
+ */
+
+#ifndef MGR_PTRMAP_H
+#define MGR_PTRMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct mgr_ptrmap_entry {
+    void *ptr;
+    uint64_t value;
+} mgr_ptrmap_entry;
+
+typedef struct mgr_ptrmap {
+    mgr_ptrmap_entry *table;
+    size_t capacity;    // 0 or a power of two
+    size_t size;
+} mgr_ptrmap;
+
+void mgr_ptrmap_init(mgr_ptrmap *m);
+void mgr_ptrmap_deinit(mgr_ptrmap *m);
+
+int mgr_ptrmap_insert(mgr_ptrmap *m, void *ptr, uint64_t value);
+bool mgr_ptrmap_remove(mgr_ptrmap *m, void *ptr, uint64_t *value);
+
+#endif /* MGR_PTRMAP_H */
@@ -0,0 +1,149 @@
+/*!
+    \file       mgr_rand.c
+    \brief      Source file for the memgrind_c per-thread pseudorandom generator
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_rand.h"
+
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+_Thread_local mgr_rand_state mgr_rand_tls = {
+    // splitmix64 of seed 0, stream 0: usable before any seeding
+    { UINT64_C(0xe220a8397b1dcdaf), UINT64_C(0x6e789e6aa1b965f4),
+      UINT64_C(0x06c45d188009454f), UINT64_C(0xf88bb8a8724c81ec) },
+    NULL, NULL, NULL, 0, 0
+};
+
+bool mgr_rand_tape_enabled = false;
+
+static uint64_t mgr_rand_seed_global = 0;
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+/*!
+    \brief  Sets the process-wide seed, and reseeds the calling thread
+            as stream 0
+
+    \param[in]  seed    seed value (printed in reports to reproduce a run)
+ */
+void mgr_rand_seed(uint64_t seed) {
+    mgr_rand_seed_global = seed;
+    mgr_rand_seed_thread(0);
+}
+
+/*!
+    \brief  The process-wide seed
+
+    \return     seed last passed to mgr_rand_seed
+ */
+uint64_t mgr_rand_seed_value(void) {
+    return mgr_rand_seed_global;
+}
+
+/*!
+    \brief  A seed that differs from run to run, for when none is given
+
+    \return     seed mixed from the clock and the process id
+ */
+uint64_t mgr_rand_seed_default(void) {
+    struct timespec ts = { 0, 0 };
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    uint64_t x = ((uint64_t)(ts.tv_sec) << 32) ^ (uint64_t)(ts.tv_nsec) ^ ((uint64_t)(getpid()) << 16);
+    return splitmix64(&x);
+}
+
+/*!
+    \brief  Seeds the calling thread's generator with its own stream
+            derived from the process-wide seed
+
+    \details    Worker threads call this with distinct stream numbers,
+                so a threaded run is reproducible from the seed too.
+                Any tape is emptied.
+
+    \param[in]  stream  stream number (0 is the main thread)
+ */
+void mgr_rand_seed_thread(uint64_t stream) {
+    mgr_rand_state *st = &mgr_rand_tls;
+    uint64_t x = mgr_rand_seed_global ^ (stream * UINT64_C(0xD1B54A32D192ED03));
+
+    for (int i = 0; i < 4; ++i) {
+        st->s[i] = splitmix64(&x);
+    }
+
+    st->tape_pos = NULL;
+    st->tape_end = NULL;
+    st->draws = 0;
+}
+
+/*!
+    \brief  Makes room for count values on the calling thread's tape
+
+    \param[in]  count   tape length
+
+    \return     0 on success, -1 if the tape could not be allocated
+ */
+int mgr_rand_tape_reserve(size_t count) {
+    mgr_rand_state *st = &mgr_rand_tls;
+
+    if (count <= st->tape_capacity) {
+        return 0;
+    }
+
+    uint64_t *tape = realloc(st->tape, sizeof *tape * count);
+
+    if (tape == NULL) {
+        return -1;
+    }
+
+    st->tape = tape;
+    st->tape_capacity = count;
+    st->tape_pos = NULL;
+    st->tape_end = NULL;
+
+    return 0;
+}
+
+/*!
+    \brief  Fills the calling thread's whole tape from its generator,
+            and rewinds it; call outside the timed window
+ */
+void mgr_rand_tape_fill(void) {
+    mgr_rand_state *st = &mgr_rand_tls;
+
+    st->tape_pos = NULL;
+    st->tape_end = NULL;
+
+    for (size_t i = 0; i < st->tape_capacity; ++i) {
+        st->tape[i] = mgr_rand_next();
+    }
+
+    st->tape_pos = st->tape;
+    st->tape_end = st->tape + st->tape_capacity;
+}
+
+/*!
+    \brief  Frees the calling thread's tape; draws go to the generator
+ */
+void mgr_rand_tape_release(void) {
+    mgr_rand_state *st = &mgr_rand_tls;
+
+    free(st->tape);
+
+    st->tape = NULL;
+    st->tape_capacity = 0;
+    st->tape_pos = NULL;
+    st->tape_end = NULL;
+}
@@ -0,0 +1,162 @@
+/*!
+    \file       mgr_rand.h
+    \brief      Header file for the memgrind_c per-thread pseudorandom generator
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    xoshiro256** with per-thread state, seeded through splitmix64 from
+    one process-wide seed and a stream number per thread, so a run is
+    reproducible from its seed and threads never share (or lock) state.
+
+    In tape mode, random values are generated ahead of time into a
+    per-thread buffer outside the timed window; inside it, a draw is
+    a load and a pointer increment. A draw past the end of the tape
+    falls back to the generator, which continues the same sequence.
+ */
+
+#ifndef MGR_RAND_H
+#define MGR_RAND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct mgr_rand_state {
+    uint64_t s[4];
+
+    const uint64_t *tape_pos;
+    const uint64_t *tape_end;
+    uint64_t *tape;
+    size_t tape_capacity;
+
+    uint64_t draws;     // values drawn since last reset
+} mgr_rand_state;
+
+extern _Thread_local mgr_rand_state mgr_rand_tls;
+
+void mgr_rand_seed(uint64_t seed);
+uint64_t mgr_rand_seed_value(void);
+uint64_t mgr_rand_seed_default(void);
+void mgr_rand_seed_thread(uint64_t stream);
+
+extern bool mgr_rand_tape_enabled;
+
+int mgr_rand_tape_reserve(size_t count);
+void mgr_rand_tape_fill(void);
+void mgr_rand_tape_release(void);
+
+/*!
+    \brief  Tape length for a repetition that drew draws values in
+            warmup, with slack for runs that draw a few more
+
+    \param[in]  draws   most values drawn by one warmup repetition
+
+    \return     tape length to reserve
+ */
+static inline size_t mgr_rand_tape_length(uint64_t draws) {
+    return (size_t)(draws + (draws / 2) + 64);
+}
+
+static inline uint64_t mgr_rand_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/*!
+    \brief  Next value of the calling thread's generator (or tape)
+
+    \return     uniformly distributed 64-bit value
+ */
+static inline uint64_t mgr_rand_next(void) {
+    mgr_rand_state *st = &mgr_rand_tls;
+
+    ++st->draws;
+
+    if (st->tape_pos < st->tape_end) {
+        return *st->tape_pos++;
+    }
+
+    uint64_t *s = st->s;
+
+    const uint64_t result = mgr_rand_rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = mgr_rand_rotl(s[3], 45);
+
+    return result;
+}
+
+/*!
+    \brief  Unbiased value in [0, range), by Lemire's multiply-shift
+            with rejection (no modulo bias, no division in the common case)
+
+    \param[in]  range   exclusive upper bound; 0 yields 0
+
+    \return     uniformly distributed value in [0, range)
+ */
+static inline uint32_t mgr_rand_below(uint32_t range) {
+    uint64_t m = (mgr_rand_next() >> 32) * (uint64_t)(range);
+    uint32_t low = (uint32_t)(m);
+
+    if (low < range) {
+        const uint32_t threshold = (uint32_t)(-range) % range;
+
+        while (low < threshold) {
+            m = (mgr_rand_next() >> 32) * (uint64_t)(range);
+            low = (uint32_t)(m);
+        }
+    }
+
+    return (uint32_t)(m >> 32);
+}
+
+/*!
+    \brief  Unbiased value in [minimum, maximum)
+
+    \param[in]  minimum inclusive lower bound
+    \param[in]  maximum exclusive upper bound
+
+    \return     uniformly distributed value, or minimum if the range is empty
+ */
+static inline uint32_t mgr_rand_range(uint32_t minimum, uint32_t maximum) {
+    return maximum > minimum ? minimum + mgr_rand_below(maximum - minimum) : minimum;
+}
+
+/*!
+    \brief  Unbiased value in [minimum, maximum], for upper bounds
+            up to UINT32_MAX that maximum + 1 would wrap
+
+    \param[in]  minimum inclusive lower bound
+    \param[in]  maximum inclusive upper bound
+
+    \return     uniformly distributed value, or minimum if the range is empty
+ */
+static inline uint32_t mgr_rand_between(uint32_t minimum, uint32_t maximum) {
+    if (maximum <= minimum) {
+        return minimum;
+    }
+
+    // every 32-bit value: a range of 2^32 does not fit mgr_rand_below
+    if (maximum - minimum == UINT32_MAX) {
+        return (uint32_t)(mgr_rand_next() >> 32);
+    }
+
+    return minimum + mgr_rand_below(maximum - minimum + 1);
+}
+
+/*!
+    \brief  Fair coin flip
+
+    \return     true or false, each with probability 1/2
+ */
+static inline bool mgr_rand_bool(void) {
+    return (mgr_rand_next() >> 63) != 0;
+}
+
+#endif /* MGR_RAND_H */
@@ -0,0 +1,124 @@
+/*!
+    \file       mgr_realloc.c
+    \brief      Source file for the memgrind_c realloc and calloc workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_alloc.h"
+#include "mgr_workload.h"
+
+#include <string.h>
+
+// capacity a growing buffer starts with
+#define MGR_GROWTH_INITIAL 16
+
+/*!
+    \brief  Test i:
+            grow a buffer with realloc, then shrink it to fit
+
+    \details    Starting from MGR_GROWTH_INITIAL bytes, the buffer's
+                capacity becomes capacity * growth / 100 + step until it
+                reaches max; every new byte is written, as appending
+                would. The buffer is then shrunk to max bytes and freed.
+
+                growth 200 (step 0) doubles, growth 150 grows by half,
+                growth 100 with a step grows by a constant.
+
+                How many of the calls kept the block in place is shown
+                under the test's row.
+
+    \param[in]  max     final size (bytes)
+    \param[in]  growth  growth factor, in percent
+    \param[in]  step    bytes added on every growth
+ */
+void mgr_realloc_growth(uint32_t max, uint32_t growth, uint32_t step) {
+    size_t capacity = MGR_GROWTH_INITIAL < max ? MGR_GROWTH_INITIAL : max;
+    char *buffer = mgr_malloc(capacity);
+
+    if (buffer == NULL) {
+        return;
+    }
+
+    memset(buffer, 0xa5, capacity);
+
+    while (capacity < max) {
+        size_t next = ((capacity * growth) / 100) + step;
+
+        next = next > capacity ? next : capacity + 1;   // always grow
+
+        char *grown = mgr_realloc(buffer, capacity, next);
+
+        if (grown == NULL) {
+            break;
+        }
+
+        memset(grown + capacity, 0xa5, next - capacity);
+
+        buffer = grown;
+        capacity = next;
+    }
+
+    if (capacity > max && max > 0) {
+        char *fitted = mgr_realloc(buffer, capacity, max);      // shrink to fit
+
+        if (fitted) {
+            buffer = fitted;
+        }
+    }
+
+    mgr_free(buffer);
+}
+
+/*!
+    \brief  Test j:
+            allocate zeroed blocks, read them, free them
+
+    \details    With memset 0, the blocks come from calloc, which may
+                skip zeroing memory fresh from the operating system;
+                with memset 1, from malloc followed by memset, for
+                comparison. One byte of every page is read back, so
+                pages the allocator left unmapped are faulted in.
+
+    \param[in]  count       blocks
+    \param[in]  size        block size (bytes)
+    \param[in]  use_memset  0: calloc, 1: malloc + memset
+ */
+void mgr_calloc_blocks(uint32_t count, uint32_t size, uint32_t use_memset) {
+    void **blocks = mgr_malloc(sizeof *blocks * (count > 0 ? count : 1));
+    volatile unsigned char sum = 0;
+
+    if (blocks == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (use_memset) {
+            blocks[i] = mgr_malloc(size);
+
+            if (blocks[i]) {
+                memset(blocks[i], 0, size);
+            }
+        } else {
+            blocks[i] = mgr_calloc(1, size);
+        }
+
+        const unsigned char *bytes = blocks[i];
+
+        for (size_t j = 0; bytes && j < size; j += 4096) {
+            sum += bytes[j];
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (blocks[i]) {
+            mgr_free(blocks[i]);
+        }
+    }
+
+    mgr_free(blocks);
+    (void)(sum);
+}
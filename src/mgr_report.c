@@ -0,0 +1,628 @@
+/*!
+    \file       mgr_report.c
+    \brief      Source file for memgrind_c machine-readable results (JSON/CSV)
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#ifdef __APPLE__
+#define _DARWIN_C_SOURCE
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "mgr_report.h"
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+// Set by the build (see src/CMakeLists.txt)
+#ifndef MGR_BUILD_TYPE
+#define MGR_BUILD_TYPE "unknown"
+#endif
+
+#ifndef MGR_BUILD_FLAGS
+#define MGR_BUILD_FLAGS "unknown"
+#endif
+
+#if defined(__clang__)
+#define MGR_COMPILER __VERSION__
+#elif defined(__GNUC__)
+#define MGR_COMPILER "gcc " __VERSION__
+#elif defined(__VERSION__)
+#define MGR_COMPILER __VERSION__
+#else
+#define MGR_COMPILER "unknown"
+#endif
+
+/*
+    Reads the cpu model name into buffer; "unknown" if the platform
+    does not say.
+ */
+static void mgr_cpu_model(char *buffer, size_t size) {
+    snprintf(buffer, size, "%s", "unknown");
+
+#ifdef __APPLE__
+    size_t length = size;
+
+    if (sysctlbyname("machdep.cpu.brand_string", buffer, &length, NULL, 0) != 0) {
+        snprintf(buffer, size, "%s", "unknown");
+    }
+#else
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+
+    if (cpuinfo == NULL) {
+        return;
+    }
+
+    char line[512];
+
+    while (fgets(line, sizeof line, cpuinfo)) {
+        // x86 says "model name", most arm kernels say "Model" or "Hardware"
+        if (strncmp(line, "model name", 10) == 0 ||
+            strncmp(line, "Model", 5) == 0 ||
+            strncmp(line, "Hardware", 8) == 0) {
+            const char *value = strchr(line, ':');
+
+            if (value) {
+                value += value[1] == ' ' ? 2 : 1;
+                snprintf(buffer, size, "%.*s", (int)(strcspn(value, "\n")), value);
+                break;
+            }
+        }
+    }
+
+    fclose(cpuinfo);
+#endif
+}
+
+static void json_string(FILE *dest, const char *s) {
+    fputc('"', dest);
+
+    for (; *s; ++s) {
+        const unsigned char c = (unsigned char)(*s);
+
+        if (c == '"' || c == '\\') {
+            fprintf(dest, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(dest, "\\u%04x", c);
+        } else {
+            fputc(c, dest);
+        }
+    }
+
+    fputc('"', dest);
+}
+
+static void json_field(FILE *dest, const char *key, const char *value) {
+    fprintf(dest, "    \"%s\": ", key);
+    json_string(dest, value);
+    fprintf(dest, ",\n");
+}
+
+// CSV fields are quoted when they could be mistaken for more than one
+static void csv_string(FILE *dest, const char *s) {
+    if (strpbrk(s, ",\"\n") == NULL) {
+        fputs(s, dest);
+        return;
+    }
+
+    fputc('"', dest);
+
+    for (; *s; ++s) {
+        if (*s == '"') {
+            fputc('"', dest);
+        }
+
+        fputc(*s, dest);
+    }
+
+    fputc('"', dest);
+}
+
+static void mgr_report_write_meta(mgr_report *r, const mgr_run_info *info) {
+    char cpu[256];
+    char timestamp[32];
+    char os[256];
+    char seed[32];
+
+    struct utsname un;
+    struct tm tm;
+
+    const time_t now = time(NULL);
+
+    mgr_cpu_model(cpu, sizeof cpu);
+    strftime(timestamp, sizeof timestamp, "%Y-%m-%dT%H:%M:%SZ", gmtime_r(&now, &tm));
+
+    if (uname(&un) != 0) {
+        memset(&un, 0, sizeof un);
+    }
+
+    snprintf(os, sizeof os, "%s %s", un.sysname, un.release);
+    snprintf(seed, sizeof seed, "%llu", (unsigned long long)(info->seed));
+
+    const struct {
+        const char *key;
+        const char *value;
+    } meta[] = {
+        { "tool", "memgrind-c" },
+        { "timestamp", timestamp },
+        { "host", un.nodename },
+        { "os", os },
+        { "arch", un.machine },
+        { "cpu_model", cpu },
+        { "compiler", MGR_COMPILER },
+        { "build_type", MGR_BUILD_TYPE },
+        { "build_flags", MGR_BUILD_FLAGS },
+        { "backend", info->backend },
+        { "seed", seed },
+        { NULL, NULL }
+    };
+
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (r->json) {
+        fprintf(r->json, "{\n  \"meta\": {\n");
+
+        for (size_t i = 0; meta[i].key; ++i) {
+            json_field(r->json, meta[i].key, meta[i].value);
+        }
+
+        fprintf(r->json,
+                "    \"cpus\": %ld,\n"
+                "    \"warmup\": %u,\n"
+                "    \"reps\": %u,\n"
+                "    \"rand_tape\": %s,\n"
+                "    \"op_latency\": %s,\n"
+                "    \"perf\": %s,\n"
+                "    \"memory\": %s,\n"
+                "    \"calibrated\": %s\n"
+                "  },\n"
+                "  \"results\": [",
+                cpus,
+                info->warmup,
+                info->reps,
+                info->rand_tape ? "true" : "false",
+                info->op_latency ? "true" : "false",
+                info->perf ? "true" : "false",
+                info->memory ? "true" : "false",
+                info->calibrated ? "true" : "false");
+    }
+
+    if (r->csv) {
+        for (size_t i = 0; meta[i].key; ++i) {
+            fprintf(r->csv, "# %s: %s\n", meta[i].key, meta[i].value);
+        }
+
+        fprintf(r->csv,
+                "# cpus: %ld\n"
+                "# warmup: %u\n"
+                "# reps: %u\n"
+                "# rand_tape: %s\n"
+                "# op_latency: %s\n"
+                "# perf: %s\n"
+                "# memory: %s\n"
+                "# calibrated: %s\n"
+                "section,label,test,params,ops,reallocs,reallocs_in_place,count,mean_ns,ci95_ns,min_ns,median_ns,p90_ns,p99_ns,max_ns,stddev_ns,",
+                cpus,
+                info->warmup,
+                info->reps,
+                info->rand_tape ? "true" : "false",
+                info->op_latency ? "true" : "false",
+                info->perf ? "true" : "false",
+                info->memory ? "true" : "false",
+                info->calibrated ? "true" : "false");
+
+        for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+            fprintf(r->csv, "%s,", mgr_perf_event_keys[i]);
+        }
+
+        fprintf(r->csv, "requested_peak,usable_peak,heap_peak,rss_growth,internal_frag,external_frag,"
+                        "minor_faults_per_rep,major_faults_per_rep,traversal_ns,traversal_nodes,");
+
+        for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+            fprintf(r->csv, "traversal_%s,", mgr_perf_event_keys[i]);
+        }
+
+        fprintf(r->csv, "harness_mean_ns,harness_median_ns,heap_used_blocks,heap_used_bytes,heap_free_blocks,"
+                        "heap_free_bytes,heap_largest_free,heap_frag_index,samples_ns\n");
+    }
+}
+
+/*!
+    \brief  Opens the JSON and/or CSV report and writes the run metadata
+
+    \param[out] r           report
+    \param[in]  json_path   JSON report file, "-" for stdout, NULL for none
+    \param[in]  csv_path    CSV report file, "-" for stdout, NULL for none
+    \param[in]  info        run metadata
+
+    \return     0 on success, -1 if a file could not be opened
+                (then neither is left open, nor a JSON file created)
+ */
+int mgr_report_open(mgr_report *r, const char *json_path, const char *csv_path, const mgr_run_info *info) {
+    r->json = NULL;
+    r->csv = NULL;
+    r->results = 0;
+
+    if (json_path) {
+        r->json = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+
+        if (r->json == NULL) {
+            perror(json_path);
+            return -1;
+        }
+    }
+
+    if (csv_path) {
+        r->csv = strcmp(csv_path, "-") == 0 ? stdout : fopen(csv_path, "w");
+
+        if (r->csv == NULL) {
+            perror(csv_path);
+
+            // nothing was written yet: leave no half-made JSON report behind
+            if (r->json && r->json != stdout) {
+                fclose(r->json);
+                remove(json_path);
+            }
+
+            r->json = NULL;
+            return -1;
+        }
+    }
+
+    mgr_report_write_meta(r, info);
+    return 0;
+}
+
+static void json_hist(FILE *dest, const char *key, const mgr_hist *h, const char *indent) {
+    fprintf(dest,
+            "%s\"%s\": { \"count\": %llu, \"mean\": %.1lf, \"min\": %llu, \"max\": %llu, \"buckets\": [",
+            indent,
+            key,
+            (unsigned long long)(h->total),
+            mgr_hist_mean(h),
+            (unsigned long long)(h->total ? h->min : 0),
+            (unsigned long long)(h->max));
+
+    const char *sep = "";
+
+    for (size_t i = 0; i < MGR_HIST_BUCKETS; ++i) {
+        if (h->counts[i]) {
+            fprintf(dest, "%s[%llu, %llu]", sep,
+                    (unsigned long long)(mgr_hist_value(i)),
+                    (unsigned long long)(h->counts[i]));
+            sep = ", ";
+        }
+    }
+
+    fprintf(dest, "] }");
+}
+
+// sizes and ratios the backend cannot tell are null in JSON, empty in CSV
+
+static void json_size(FILE *dest, const char *key, bool known, size_t value) {
+    if (known) {
+        fprintf(dest, ", \"%s\": %zu", key, value);
+    } else {
+        fprintf(dest, ", \"%s\": null", key);
+    }
+}
+
+static void json_ratio(FILE *dest, const char *key, double ratio) {
+    if (ratio >= 0.0) {
+        fprintf(dest, ", \"%s\": %.4lf", key, ratio);
+    } else {
+        fprintf(dest, ", \"%s\": null", key);
+    }
+}
+
+static void csv_size(FILE *dest, bool known, size_t value) {
+    if (known) {
+        fprintf(dest, "%zu", value);
+    }
+
+    fputc(',', dest);
+}
+
+static void csv_ratio(FILE *dest, double ratio) {
+    if (ratio >= 0.0) {
+        fprintf(dest, "%.4lf", ratio);
+    }
+
+    fputc(',', dest);
+}
+
+static void mgr_report_json_result(FILE *dest, const mgr_result *res) {
+    const mgr_test *test = res->test;
+    const mgr_summary *summary = &res->summary;
+    const char tch[2] = { test->tch, '\0' };
+
+    fprintf(dest, "\n    {\n      \"section\": ");
+    json_string(dest, res->section);
+    fprintf(dest, ",\n      \"label\": ");
+    json_string(dest, res->label);
+    fprintf(dest, ",\n      \"test\": ");
+    json_string(dest, tch);
+    fprintf(dest, ",\n      \"params\": {");
+
+    const char *sep = " ";
+
+    for (int i = 0; i < 3; ++i) {
+        if (test->params[i]) {
+            fprintf(dest, "%s\"%s\": %u", sep, test->params[i], *mgr_test_param((mgr_test *)(test), i));
+            sep = ", ";
+        }
+    }
+
+    fprintf(dest,
+            " },\n"
+            "      \"ops\": %llu,\n"
+            "      \"reallocs\": %llu,\n"
+            "      \"reallocs_in_place\": %llu,\n"
+            "      \"summary_ns\": { \"count\": %zu, \"mean\": %.1lf, \"ci95\": %.1lf, \"min\": %.0lf, "
+            "\"median\": %.1lf, \"p90\": %.1lf, \"p99\": %.1lf, \"max\": %.0lf, \"stddev\": %.1lf },\n"
+            "      \"samples_ns\": [",
+            (unsigned long long)(res->ops),
+            (unsigned long long)(res->reallocs),
+            (unsigned long long)(res->reallocs_in_place),
+            summary->count, summary->mean, summary->ci95, summary->min,
+            summary->median, summary->p90, summary->p99, summary->max, summary->stddev);
+
+    for (size_t i = 0; i < res->samples->size; ++i) {
+        fprintf(dest, "%s%.0lf", i ? ", " : "", res->samples->data[i]);
+    }
+
+    fprintf(dest, "]");
+
+    if (res->perf) {
+        fprintf(dest, ",\n      \"perf\": { \"running_ratio\": %.3lf", res->perf->running_ratio);
+
+        for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+            if (res->perf->valid[i]) {
+                fprintf(dest, ", \"%s\": %llu", mgr_perf_event_keys[i],
+                        (unsigned long long)(res->perf->values[i]));
+            }
+        }
+
+        fprintf(dest, " }");
+    }
+
+    if (res->footprint) {
+        const mgr_footprint *f = res->footprint;
+
+        fprintf(dest, ",\n      \"memory\": { \"allocs\": %llu, \"requested_peak\": %zu",
+                (unsigned long long)(f->allocs), f->requested_peak);
+        json_size(dest, "usable_peak", f->usable_known, f->usable_peak);
+        json_size(dest, "heap_peak", f->heap_known, f->heap_peak);
+        json_size(dest, "rss_growth", f->rss_known, f->rss_growth);
+        json_ratio(dest, "internal_frag", f->internal_frag);
+        json_ratio(dest, "external_frag", f->external_frag);
+
+        if (f->marked) {
+            fprintf(dest, ", \"mark_requested\": %zu", f->mark_requested);
+        }
+
+        fprintf(dest, ", \"minor_faults_per_rep\": %.1lf, \"major_faults_per_rep\": %.1lf }",
+                f->minor_faults_per_rep, f->major_faults_per_rep);
+    }
+
+    if (res->harness) {
+        const double allocator = summary->mean - res->harness->mean;
+
+        fprintf(dest, ",\n      \"harness_ns\": { \"mean\": %.1lf, \"median\": %.1lf, "
+                      "\"allocator_mean\": %.1lf }",
+                res->harness->mean, res->harness->median, allocator > 0.0 ? allocator : 0.0);
+    }
+
+    if (res->traversal) {
+        fprintf(dest, ",\n      \"traversal\": { \"ns\": %llu, \"nodes\": %llu",
+                (unsigned long long)(res->traversal->ns),
+                (unsigned long long)(res->traversal->nodes));
+
+        for (int i = 0; res->traversal_perf && i < MGR_PERF_EVENTS; ++i) {
+            if (res->traversal_perf->valid[i]) {
+                fprintf(dest, ", \"%s\": %llu", mgr_perf_event_keys[i],
+                        (unsigned long long)(res->traversal_perf->values[i]));
+            }
+        }
+
+        fprintf(dest, " }");
+    }
+
+    if (res->heap) {
+        const mgr_heap_summary *h = res->heap;
+
+        fprintf(dest, ",\n      \"heap\": { \"walked\": %s", h->walked ? "true" : "false");
+        json_size(dest, "used_blocks", h->walked, (size_t)(h->used_blocks));
+        json_size(dest, "used_bytes", true, (size_t)(h->used_bytes));
+        json_size(dest, "free_blocks", true, (size_t)(h->free_blocks));
+        json_size(dest, "free_bytes", true, (size_t)(h->free_bytes));
+        json_size(dest, "largest_free", h->walked, (size_t)(h->largest_free));
+        json_ratio(dest, "frag_index", mgr_heap_frag_index(h));
+
+        if (h->classes_known) {
+            fprintf(dest, ", \"free_lists\": {");
+
+            for (uint32_t cls = 0, n = 0; cls < MGR_CLASSES; ++cls) {
+                if (h->free_lists[cls] > 0) {
+                    fprintf(dest, "%s \"%zu\": %llu", n++ ? "," : "", mgr_class_size(cls),
+                            (unsigned long long)(h->free_lists[cls]));
+                }
+            }
+
+            fprintf(dest, " }");
+        }
+
+        fprintf(dest, " }");
+    }
+
+    if (res->oplat) {
+        const mgr_oplat *oplat = res->oplat;
+
+        fprintf(dest, ",\n      \"oplat_ns\": {\n");
+        json_hist(dest, "malloc", &oplat->malloc_all, "        ");
+        fprintf(dest, ",\n");
+        json_hist(dest, "free", &oplat->free_all, "        ");
+
+        for (unsigned i = 0; i < MGR_OPLAT_CLASSES; ++i) {
+            if (oplat->malloc_class[i].total) {
+                char key[32];
+                snprintf(key, sizeof key, "malloc_le_%llu", 1ull << i);
+
+                fprintf(dest, ",\n");
+                json_hist(dest, key, &oplat->malloc_class[i], "        ");
+            }
+        }
+
+        fprintf(dest, "\n      }");
+    }
+
+    fprintf(dest, "\n    }");
+}
+
+static void mgr_report_csv_result(FILE *dest, const mgr_result *res) {
+    const mgr_test *test = res->test;
+    const mgr_summary *summary = &res->summary;
+
+    char params[128] = "";
+    size_t length = 0;
+
+    for (int i = 0; i < 3 && length < sizeof params; ++i) {
+        if (test->params[i]) {
+            length += snprintf(params + length, sizeof params - length, "%s%s=%u",
+                               length ? " " : "", test->params[i],
+                               *mgr_test_param((mgr_test *)(test), i));
+        }
+    }
+
+    csv_string(dest, res->section);
+    fputc(',', dest);
+    csv_string(dest, res->label);
+
+    fprintf(dest, ",%c,%s,%llu,%llu,%llu,%zu,%.1lf,%.1lf,%.0lf,%.1lf,%.1lf,%.1lf,%.0lf,%.1lf,",
+            test->tch, params, (unsigned long long)(res->ops),
+            (unsigned long long)(res->reallocs), (unsigned long long)(res->reallocs_in_place),
+            summary->count, summary->mean, summary->ci95, summary->min,
+            summary->median, summary->p90, summary->p99, summary->max, summary->stddev);
+
+    // counters not measured are left empty
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        if (res->perf && res->perf->valid[i]) {
+            fprintf(dest, "%llu", (unsigned long long)(res->perf->values[i]));
+        }
+
+        fputc(',', dest);
+    }
+
+    // so are memory figures the backend cannot tell
+    if (res->footprint) {
+        const mgr_footprint *f = res->footprint;
+
+        fprintf(dest, "%zu,", f->requested_peak);
+        csv_size(dest, f->usable_known, f->usable_peak);
+        csv_size(dest, f->heap_known, f->heap_peak);
+        csv_size(dest, f->rss_known, f->rss_growth);
+        csv_ratio(dest, f->internal_frag);
+        csv_ratio(dest, f->external_frag);
+        fprintf(dest, "%.1lf,%.1lf,", f->minor_faults_per_rep, f->major_faults_per_rep);
+    } else {
+        fprintf(dest, ",,,,,,,,");
+    }
+
+    if (res->traversal) {
+        fprintf(dest, "%llu,%llu,", (unsigned long long)(res->traversal->ns),
+                (unsigned long long)(res->traversal->nodes));
+    } else {
+        fprintf(dest, ",,");
+    }
+
+    for (int i = 0; i < MGR_PERF_EVENTS; ++i) {
+        if (res->traversal_perf && res->traversal_perf->valid[i]) {
+            fprintf(dest, "%llu", (unsigned long long)(res->traversal_perf->values[i]));
+        }
+
+        fputc(',', dest);
+    }
+
+    if (res->harness) {
+        fprintf(dest, "%.1lf,%.1lf,", res->harness->mean, res->harness->median);
+    } else {
+        fprintf(dest, ",,");
+    }
+
+    if (res->heap && res->heap->walked) {
+        fprintf(dest, "%llu,%llu,%llu,%llu,%llu,%.4lf,",
+                (unsigned long long)(res->heap->used_blocks), (unsigned long long)(res->heap->used_bytes),
+                (unsigned long long)(res->heap->free_blocks), (unsigned long long)(res->heap->free_bytes),
+                (unsigned long long)(res->heap->largest_free), mgr_heap_frag_index(res->heap));
+    } else if (res->heap) {
+        fprintf(dest, ",%llu,%llu,%llu,,,",
+                (unsigned long long)(res->heap->used_bytes),
+                (unsigned long long)(res->heap->free_blocks), (unsigned long long)(res->heap->free_bytes));
+    } else {
+        fprintf(dest, ",,,,,,");
+    }
+
+    for (size_t i = 0; i < res->samples->size; ++i) {
+        fprintf(dest, "%s%.0lf", i ? " " : "", res->samples->data[i]);
+    }
+
+    fputc('\n', dest);
+}
+
+/*!
+    \brief  Writes one result to every open report
+
+    \param[in]  r       report
+    \param[in]  res     result
+ */
+void mgr_report_result(mgr_report *r, const mgr_result *res) {
+    if (r->json) {
+        fprintf(r->json, "%s", r->results ? "," : "");
+        mgr_report_json_result(r->json, res);
+    }
+
+    if (r->csv) {
+        mgr_report_csv_result(r->csv, res);
+    }
+
+    ++r->results;
+}
+
+/*!
+    \brief  Finishes and closes every open report
+
+    \param[in]  r   report
+
+    \return     0 on success, -1 if a report could not be written in full
+ */
+int mgr_report_close(mgr_report *r) {
+    int status = 0;
+
+    if (r->json) {
+        fprintf(r->json, "%s]\n}\n", r->results ? "\n  " : "");
+
+        if (ferror(r->json) || (r->json == stdout ? fflush(r->json) : fclose(r->json)) != 0) {
+            status = -1;
+        }
+    }
+
+    if (r->csv) {
+        if (ferror(r->csv) || (r->csv == stdout ? fflush(r->csv) : fclose(r->csv)) != 0) {
+            status = -1;
+        }
+    }
+
+    r->json = NULL;
+    r->csv = NULL;
+
+    return status;
+}
@@ -0,0 +1,94 @@
+/*!
+    \file       mgr_report.h
+    \brief      Header file for memgrind_c machine-readable results (JSON/CSV)
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    A report is written as results come in. The JSON report holds the
+    run metadata, and per result the test parameters, the summary, every
+    timed sample (in run order) and, in op latency mode, the non-empty
+    buckets of the per-operation histograms. The CSV report holds one
+    row per result, with the metadata as leading '#' comment lines.
+
+    mgr_report_diff reads two JSON reports and tests every result they
+    have in common for a significant change (see mgr_report_diff.c).
+ */
+
+#ifndef MGR_REPORT_H
+#define MGR_REPORT_H
+
+#include "mgr_footprint.h"
+#include "mgr_heap.h"
+#include "mgr_hist.h"
+#include "mgr_locality.h"
+#include "mgr_perf.h"
+#include "mgr_stats.h"
+#include "mgr_workload.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*!
+    \brief  Run metadata, written once at the top of a report
+ */
+typedef struct mgr_run_info {
+    const char *backend;
+    uint64_t seed;
+    uint32_t warmup;
+    uint32_t reps;
+    bool rand_tape;
+    bool op_latency;
+    bool perf;              // hardware counters are open
+    bool memory;            // footprints are measured
+    bool calibrated;        // results carry the harness time
+} mgr_run_info;
+
+/*!
+    \brief  One measured test, as written to a report
+ */
+typedef struct mgr_result {
+    const char *section;            // part of the run: "tests", "sweep", "compare"...
+    const char *label;              // unique within the run, e.g. "d.max=64"
+    const mgr_test *test;           // with the parameters it ran with
+
+    mgr_summary summary;            // of the timed repetitions (ns)
+    const mgr_samples *samples;     // timed repetitions in run order (ns)
+    uint64_t ops;                   // allocator calls over all timed repetitions
+    uint64_t reallocs;              // of which mgr_realloc
+    uint64_t reallocs_in_place;     // of which kept the block in place
+
+    const mgr_oplat *oplat;         // NULL unless op latency mode is on
+    const mgr_perf_counts *perf;    // NULL unless counters are open
+    const mgr_footprint *footprint; // NULL unless footprints are measured
+    const mgr_summary *harness;     // the test on the null backend (ns); NULL unless calibrated
+
+    const mgr_traversal *traversal;         // NULL unless the test timed traversals
+    const mgr_perf_counts *traversal_perf;  // during traversals; NULL unless counters are open
+
+    const mgr_heap_summary *heap;   // after the test; NULL unless the heap was walked
+} mgr_result;
+
+typedef struct mgr_report {
+    FILE *json;
+    FILE *csv;
+    size_t results;     // results written so far
+} mgr_report;
+
+int mgr_report_open(mgr_report *r, const char *json_path, const char *csv_path, const mgr_run_info *info);
+void mgr_report_result(mgr_report *r, const mgr_result *res);
+int mgr_report_close(mgr_report *r);
+
+/*!
+    \brief  Significance test settings for mgr_report_diff
+ */
+typedef struct mgr_diff_opts {
+    double alpha;           // largest p-value that counts as significant
+    double threshold;       // smallest relative change of the median that counts
+} mgr_diff_opts;
+
+int mgr_report_diff(const char *old_path, const char *new_path, const mgr_diff_opts *opts, FILE *dest);
+
+#endif /* MGR_REPORT_H */
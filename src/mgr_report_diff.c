@@ -0,0 +1,578 @@
+/*!
+    \file       mgr_report_diff.c
+    \brief      Source file for memgrind_c regression checks between JSON reports
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Results are matched by section and label. Each pair is tested with
+    the Mann-Whitney U test (normal approximation, tie-corrected), which
+    assumes nothing about the shape of the timing distributions; they
+    are seldom normal, with a long right tail from interrupts and page
+    faults. A change is reported only if it is both significant
+    (p < alpha) and large enough (the median moved by more than the
+    threshold), so that tiny but consistent shifts do not fail a build.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_report.h"
+
+#include "cgcs_ulog.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct mgr_diff_result {
+    char *section;                  // as long as in the report; NULL if absent
+    char *label;
+    mgr_samples samples;
+} mgr_diff_result;
+
+typedef struct mgr_diff_file {
+    mgr_diff_result *results;
+    size_t count;
+    size_t capacity;
+} mgr_diff_file;
+
+/*
+    A minimal reader for the reports mgr_report writes: it walks any
+    well-formed JSON, but only keeps "section", "label" and "samples_ns"
+    of each object in the top-level "results" array.
+ */
+typedef struct json_cursor {
+    const char *pos;
+    const char *end;
+} json_cursor;
+
+static void json_skip_ws(json_cursor *c) {
+    while (c->pos < c->end && isspace((unsigned char)(*c->pos))) {
+        ++c->pos;
+    }
+}
+
+static bool json_accept(json_cursor *c, char ch) {
+    json_skip_ws(c);
+
+    if (c->pos < c->end && *c->pos == ch) {
+        ++c->pos;
+        return true;
+    }
+
+    return false;
+}
+
+static int json_string_read(json_cursor *c, char *buffer, size_t size) {
+    size_t n = 0;
+
+    if (json_accept(c, '"') == false) {
+        return -1;
+    }
+
+    while (c->pos < c->end && *c->pos != '"') {
+        char ch = *c->pos++;
+
+        if (ch == '\\' && c->pos < c->end) {
+            ch = *c->pos++;
+
+            if (ch == 'u' && c->end - c->pos >= 4) {
+                // only control characters (\u00XX) are ever escaped
+                char hex[5];
+
+                memcpy(hex, c->pos, 4);
+                hex[4] = '\0';
+
+                ch = (char)(strtol(hex, NULL, 16));
+                c->pos += 4;
+            } else if (ch == 'n') {
+                ch = '\n';
+            } else if (ch == 't') {
+                ch = '\t';
+            }
+        }
+
+        if (buffer && n + 1 < size) {
+            buffer[n++] = ch;
+        }
+    }
+
+    if (buffer && size > 0) {
+        buffer[n] = '\0';
+    }
+
+    return json_accept(c, '"') ? 0 : -1;
+}
+
+// reads a string into a buffer of its own length, so that no name is cut short
+static int json_string_dup(json_cursor *c, char **out) {
+    json_cursor probe = *c;
+
+    if (json_string_read(&probe, NULL, 0) != 0) {
+        return -1;
+    }
+
+    // escapes only ever shorten the raw text
+    const size_t size = (size_t)(probe.pos - c->pos);
+    char *buffer = malloc(size);
+
+    if (buffer == NULL) {
+        return -1;
+    }
+
+    free(*out);
+    *out = buffer;
+
+    return json_string_read(c, buffer, size);
+}
+
+static int json_skip_value(json_cursor *c, int depth) {
+    json_skip_ws(c);
+
+    if (c->pos >= c->end || depth > 64) {
+        return -1;
+    }
+
+    if (*c->pos == '"') {
+        return json_string_read(c, NULL, 0);
+    }
+
+    if (*c->pos == '{' || *c->pos == '[') {
+        const char close = *c->pos == '{' ? '}' : ']';
+        const bool object = close == '}';
+
+        ++c->pos;
+
+        if (json_accept(c, close)) {
+            return 0;
+        }
+
+        do {
+            if (object && (json_string_read(c, NULL, 0) != 0 || json_accept(c, ':') == false)) {
+                return -1;
+            }
+
+            if (json_skip_value(c, depth + 1) != 0) {
+                return -1;
+            }
+        } while (json_accept(c, ','));
+
+        return json_accept(c, close) ? 0 : -1;
+    }
+
+    // number, true, false, null
+    while (c->pos < c->end && strchr(",}] \t\r\n", *c->pos) == NULL) {
+        ++c->pos;
+    }
+
+    return 0;
+}
+
+static int json_read_samples(json_cursor *c, mgr_samples *samples) {
+    if (json_accept(c, '[') == false) {
+        return -1;
+    }
+
+    if (json_accept(c, ']')) {
+        return 0;
+    }
+
+    do {
+        char *next = NULL;
+
+        json_skip_ws(c);
+        const double value = strtod(c->pos, &next);
+
+        if (next == c->pos || next > c->end) {
+            return -1;
+        }
+
+        c->pos = next;
+        mgr_samples_push(samples, value);
+    } while (json_accept(c, ','));
+
+    return json_accept(c, ']') ? 0 : -1;
+}
+
+static int json_read_result(json_cursor *c, mgr_diff_result *result) {
+    char key[64];
+
+    if (json_accept(c, '{') == false) {
+        return -1;
+    }
+
+    if (json_accept(c, '}')) {
+        return 0;
+    }
+
+    do {
+        if (json_string_read(c, key, sizeof key) != 0 || json_accept(c, ':') == false) {
+            return -1;
+        }
+
+        int status = 0;
+
+        if (strcmp(key, "section") == 0) {
+            status = json_string_dup(c, &result->section);
+        } else if (strcmp(key, "label") == 0) {
+            status = json_string_dup(c, &result->label);
+        } else if (strcmp(key, "samples_ns") == 0) {
+            status = json_read_samples(c, &result->samples);
+        } else {
+            status = json_skip_value(c, 1);
+        }
+
+        if (status != 0) {
+            return -1;
+        }
+    } while (json_accept(c, ','));
+
+    return json_accept(c, '}') ? 0 : -1;
+}
+
+static int json_read_report(json_cursor *c, mgr_diff_file *file) {
+    char key[64];
+
+    if (json_accept(c, '{') == false) {
+        return -1;
+    }
+
+    do {
+        if (json_string_read(c, key, sizeof key) != 0 || json_accept(c, ':') == false) {
+            return -1;
+        }
+
+        if (strcmp(key, "results") != 0) {
+            if (json_skip_value(c, 1) != 0) {
+                return -1;
+            }
+
+            continue;
+        }
+
+        if (json_accept(c, '[') == false) {
+            return -1;
+        }
+
+        if (json_accept(c, ']')) {
+            continue;
+        }
+
+        do {
+            if (file->count == file->capacity) {
+                const size_t capacity = file->capacity > 0 ? file->capacity * 2 : 64;
+                mgr_diff_result *results = realloc(file->results, sizeof *results * capacity);
+
+                if (results == NULL) {
+                    return -1;
+                }
+
+                file->results = results;
+                file->capacity = capacity;
+            }
+
+            mgr_diff_result *result = &file->results[file->count++];
+            mgr_samples_init(&result->samples, 128);
+            result->section = NULL;
+            result->label = NULL;
+
+            if (json_read_result(c, result) != 0) {
+                return -1;
+            }
+        } while (json_accept(c, ','));
+
+        if (json_accept(c, ']') == false) {
+            return -1;
+        }
+    } while (json_accept(c, ','));
+
+    return json_accept(c, '}') ? 0 : -1;
+}
+
+static void mgr_diff_file_deinit(mgr_diff_file *file) {
+    for (size_t i = 0; i < file->count; ++i) {
+        mgr_samples_deinit(&file->results[i].samples);
+        free(file->results[i].section);
+        free(file->results[i].label);
+    }
+
+    free(file->results);
+    file->results = NULL;
+    file->count = 0;
+    file->capacity = 0;
+}
+
+static inline const char *or_empty(const char *s) {
+    return s ? s : "";
+}
+
+static bool mgr_diff_same(const mgr_diff_result *a, const mgr_diff_result *b) {
+    return strcmp(or_empty(a->section), or_empty(b->section)) == 0 &&
+           strcmp(or_empty(a->label), or_empty(b->label)) == 0;
+}
+
+/*
+    Prints the label, prefixed with its section outside of the tests
+    table (e.g. "sweep/d.max=64"), in a column of at least 16.
+ */
+static void mgr_diff_fprint_name(FILE *dest, const mgr_diff_result *r) {
+    const char *section = or_empty(r->section);
+    int n = 0;
+
+    if (section[0] == '\0' || strcmp(section, "tests") == 0) {
+        n = fprintf(dest, "%s", or_empty(r->label));
+    } else {
+        n = fprintf(dest, "%s/%s", section, or_empty(r->label));
+    }
+
+    fprintf(dest, "%*s", n < 16 ? 16 - n : 0, "");
+}
+
+static int mgr_diff_file_load(mgr_diff_file *file, const char *path) {
+    FILE *in = fopen(path, "rb");
+
+    file->results = NULL;
+    file->count = 0;
+    file->capacity = 0;
+
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    size_t size = 0;
+    size_t capacity = 1 << 16;
+    char *text = malloc(capacity);
+
+    while (text) {
+        size += fread(text + size, 1, capacity - size, in);
+
+        if (size < capacity) {
+            break;
+        }
+
+        char *bigger = realloc(text, capacity * 2);
+
+        if (bigger == NULL) {
+            free(text);
+            text = NULL;
+        } else {
+            text = bigger;
+            capacity *= 2;
+        }
+    }
+
+    const bool read_error = ferror(in) != 0;
+    fclose(in);
+
+    if (text) {
+        text[size] = '\0';     // size < capacity: strtod stops here
+    }
+
+    json_cursor c = { text, text + size };
+    const int status = text && read_error == false ? json_read_report(&c, file) : -1;
+
+    free(text);
+
+    if (status != 0) {
+        fprintf(stderr, "memgrind: %s: not a memgrind JSON report\n", path);
+        mgr_diff_file_deinit(file);
+    }
+
+    return status;
+}
+
+typedef struct rank_entry {
+    double value;
+    int group;
+} rank_entry;
+
+static int compare_rank_entry(const void *e0, const void *e1) {
+    const double a = ((const rank_entry *)(e0))->value;
+    const double b = ((const rank_entry *)(e1))->value;
+    return (a > b) - (a < b);
+}
+
+/*
+    Two-sided p-value of the Mann-Whitney U test that x and y come from
+    the same distribution; 1.0 if it cannot be computed.
+ */
+static double mann_whitney_p(const mgr_samples *x, const mgr_samples *y) {
+    const size_t n1 = x->size;
+    const size_t n2 = y->size;
+    const size_t n = n1 + n2;
+
+    if (n1 == 0 || n2 == 0) {
+        return 1.0;
+    }
+
+    rank_entry *entries = malloc(sizeof *entries * n);
+
+    if (entries == NULL) {
+        return 1.0;
+    }
+
+    for (size_t i = 0; i < n1; ++i) {
+        entries[i] = (rank_entry){ x->data[i], 0 };
+    }
+
+    for (size_t i = 0; i < n2; ++i) {
+        entries[n1 + i] = (rank_entry){ y->data[i], 1 };
+    }
+
+    qsort(entries, n, sizeof *entries, compare_rank_entry);
+
+    double rank_sum = 0.0;
+    double ties = 0.0;
+
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+
+        while (j < n && entries[j].value == entries[i].value) {
+            ++j;
+        }
+
+        // tied values share the mean of the ranks they span (1-based)
+        const double rank = ((double)(i + 1) + (double)(j)) / 2.0;
+        const double t = (double)(j - i);
+
+        for (size_t k = i; k < j; ++k) {
+            rank_sum += entries[k].group == 0 ? rank : 0.0;
+        }
+
+        ties += (t * t * t) - t;
+        i = j;
+    }
+
+    free(entries);
+
+    const double u = rank_sum - ((double)(n1) * (double)(n1 + 1) / 2.0);
+    const double mu = (double)(n1) * (double)(n2) / 2.0;
+    const double var = ((double)(n1) * (double)(n2) / 12.0) *
+                       (((double)(n) + 1.0) - (ties / ((double)(n) * ((double)(n) - 1.0))));
+
+    if (var <= 0.0) {
+        return 1.0;
+    }
+
+    // continuity correction toward the mean
+    const double d = fabs(u - mu) - 0.5;
+    const double z = (d > 0.0 ? d : 0.0) / sqrt(var);
+
+    return erfc(z / sqrt(2.0));
+}
+
+static double median_of(const mgr_samples *s) {
+    mgr_samples copy;
+    mgr_summary summary;
+
+    mgr_samples_init(&copy, s->size);
+
+    for (size_t i = 0; i < s->size; ++i) {
+        mgr_samples_push(&copy, s->data[i]);
+    }
+
+    mgr_summarize(&copy, &summary);
+    mgr_samples_deinit(&copy);
+
+    return summary.median;
+}
+
+/*!
+    \brief  Compares every result two JSON reports have in common
+
+    \details    A result regresses when its samples differ significantly
+                (p < opts->alpha) and its median grew by more than
+                opts->threshold; it improves likewise in the other
+                direction. Results in only one report are listed, but
+                do not count as regressions.
+
+    \param[in]  old_path    baseline JSON report
+    \param[in]  new_path    JSON report under test
+    \param[in]  opts        significance test settings
+    \param[in]  dest        destination file stream
+
+    \return     0 if nothing regressed, 1 if something did,
+                -1 if a report could not be read
+ */
+int mgr_report_diff(const char *old_path, const char *new_path, const mgr_diff_opts *opts, FILE *dest) {
+    static mgr_diff_file old_file;
+    static mgr_diff_file new_file;
+
+    if (mgr_diff_file_load(&old_file, old_path) != 0) {
+        return -1;
+    }
+
+    if (mgr_diff_file_load(&new_file, new_path) != 0) {
+        mgr_diff_file_deinit(&old_file);
+        return -1;
+    }
+
+    size_t regressions = 0;
+
+    fprintf(dest, "\n%s %s %s %s (medians in ns; p < %g, change > %g%%)\n\n"
+                  "%s\n"
+                  "%s\t\t%s\t%s\t%s\t\t%s\t\t%s\n"
+                  "%s\n",
+                  KGRN_b"comparing"KNRM, old_path, KGRN_b"to"KNRM, new_path,
+                  opts->alpha, opts->threshold * 100.0,
+                  "-------------------------------------------------------------------------------------",
+                  KWHT_b"result"KNRM, KWHT_b"old median"KNRM, KWHT_b"new median"KNRM,
+                  KWHT_b"change"KNRM, KWHT_b"p"KNRM, KWHT_b"verdict"KNRM,
+                  "-------------------------------------------------------------------------------------");
+
+    for (size_t i = 0; i < old_file.count; ++i) {
+        const mgr_diff_result *o = &old_file.results[i];
+        const mgr_diff_result *n = NULL;
+
+        for (size_t j = 0; j < new_file.count && n == NULL; ++j) {
+            n = mgr_diff_same(&new_file.results[j], o) ? &new_file.results[j] : NULL;
+        }
+
+        if (n == NULL) {
+            mgr_diff_fprint_name(dest, o);
+            fprintf(dest, "\t%s\n", KGRY"only in old report"KNRM);
+            continue;
+        }
+
+        const double old_median = median_of(&o->samples);
+        const double new_median = median_of(&n->samples);
+        const double change = old_median > 0.0 ? (new_median - old_median) / old_median : 0.0;
+        const double p = mann_whitney_p(&o->samples, &n->samples);
+
+        const char *verdict = KGRY"unchanged"KNRM;
+
+        if (p < opts->alpha && change > opts->threshold) {
+            verdict = KRED_b"REGRESSION"KNRM;
+            ++regressions;
+        } else if (p < opts->alpha && change < -opts->threshold) {
+            verdict = KGRN_b"improvement"KNRM;
+        }
+
+        mgr_diff_fprint_name(dest, o);
+        fprintf(dest, "\t%10.0lf\t%10.0lf\t%+7.2lf%%\t%.2e\t%s\n",
+                old_median, new_median, change * 100.0, p, verdict);
+    }
+
+    for (size_t j = 0; j < new_file.count; ++j) {
+        bool found = false;
+
+        for (size_t i = 0; i < old_file.count && found == false; ++i) {
+            found = mgr_diff_same(&new_file.results[j], &old_file.results[i]);
+        }
+
+        if (found == false) {
+            mgr_diff_fprint_name(dest, &new_file.results[j]);
+            fprintf(dest, "\t%s\n", KGRY"only in new report"KNRM);
+        }
+    }
+
+    fprintf(dest, "\n%zu %s\n", regressions, regressions == 1 ? "regression" : "regressions");
+
+    mgr_diff_file_deinit(&old_file);
+    mgr_diff_file_deinit(&new_file);
+
+    return regressions > 0 ? 1 : 0;
+}
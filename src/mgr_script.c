@@ -0,0 +1,783 @@
+/*!
+    \file       mgr_script.c
+    \brief      Source file for memgrind_c workload scripts
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_script.h"
+#include "mgr_alloc.h"
+#include "mgr_rand.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// bytes between the writes of a touch
+#define MGR_SCRIPT_LINE 64
+
+// most words in a line
+#define MGR_SCRIPT_WORDS 8
+
+static mgr_script_program *scripts = NULL;
+static uint32_t nscripts = 0;
+
+/*
+    A phase, while its workload is compiled.
+ */
+typedef struct mgr_script_phase {
+    char name[MGR_SCRIPT_NAME_MAX];
+    uint32_t list;
+    uint32_t first_op;
+    uint32_t repeat;
+} mgr_script_phase;
+
+typedef struct mgr_script_parser {
+    const char *path;
+    int lineno;
+
+    mgr_script_program *prog;           // workload being compiled, or NULL
+    uint32_t op_capacity;
+
+    mgr_script_phase phases[MGR_SCRIPT_LISTS_MAX];
+    uint32_t nphases;
+    bool window[MGR_SCRIPT_LISTS_MAX];  // list is a "life" window of fixed capacity
+} mgr_script_parser;
+
+static int mgr_script_error(const mgr_script_parser *ps, const char *what, const char *word) {
+    fprintf(stderr, "memgrind: %s:%d: %s%s%s%s\n", ps->path, ps->lineno, what,
+            word ? " '" : "", word ? word : "", word ? "'" : "");
+    return -1;
+}
+
+// a positive count or size, with an optional K or M suffix; *end is what follows
+static int mgr_script_number(const char *s, uint32_t *out, const char **end) {
+    char *e = NULL;
+
+    errno = 0;
+    unsigned long long v = strtoull(s, &e, 10);
+
+    if (*e == 'K' || *e == 'k') {
+        v <<= 10;
+        ++e;
+    } else if (*e == 'M' || *e == 'm') {
+        v <<= 20;
+        ++e;
+    }
+
+    if (errno != 0 || e == s || *s == '-' || *s == '+' || v == 0 || v > UINT32_MAX) {
+        return -1;
+    }
+
+    *out = (uint32_t)(v);
+    *end = e;
+    return 0;
+}
+
+static int mgr_script_count_word(const char *s, uint32_t *out) {
+    const char *end = NULL;
+    return mgr_script_number(s, out, &end) == 0 && *end == '\0' ? 0 : -1;
+}
+
+static uint8_t mgr_script_log2(uint32_t x) {
+    uint8_t e = 0;
+
+    while (x >>= 1) {
+        ++e;
+    }
+
+    return e;
+}
+
+// SIZE: 64, 16-256 or 16-64K:log
+static int mgr_script_parse_size(const char *s, mgr_script_op *op) {
+    const char *end = NULL;
+
+    if (mgr_script_number(s, &op->lo, &end) != 0) {
+        return -1;
+    }
+
+    op->hi = op->lo;
+    op->dist = MGR_SCRIPT_FIXED;
+
+    if (*end == '-') {
+        if (mgr_script_number(end + 1, &op->hi, &end) != 0 || op->hi < op->lo) {
+            return -1;
+        }
+
+        op->dist = MGR_SCRIPT_UNIFORM;
+
+        if (strcmp(end, ":log") == 0) {
+            op->dist = MGR_SCRIPT_LOG;
+            end += 4;
+        }
+    }
+
+    op->lo_exp = mgr_script_log2(op->lo);
+    op->hi_exp = mgr_script_log2(op->hi);
+
+    return *end == '\0' && op->hi <= MGR_SCRIPT_SIZE_MAX ? 0 : -1;
+}
+
+static mgr_script_op *mgr_script_emit(mgr_script_parser *ps, mgr_script_opcode code) {
+    mgr_script_program *p = ps->prog;
+
+    if (p->nops == ps->op_capacity) {
+        const uint32_t capacity = ps->op_capacity > 0 ? ps->op_capacity * 2 : 16;
+        mgr_script_op *ops = realloc(p->ops, sizeof *ops * capacity);
+
+        if (ops == NULL) {
+            mgr_script_error(ps, "out of memory", NULL);
+            return NULL;
+        }
+
+        p->ops = ops;
+        ps->op_capacity = capacity;
+    }
+
+    mgr_script_op *op = p->ops + p->nops++;
+
+    memset(op, 0, sizeof *op);
+    op->code = (uint8_t)(code);
+    return op;
+}
+
+static int mgr_script_new_list(mgr_script_parser *ps, uint32_t capacity, uint32_t *list) {
+    mgr_script_program *p = ps->prog;
+
+    if (p->nlists == MGR_SCRIPT_LISTS_MAX) {
+        return mgr_script_error(ps, "too many phases and life windows in workload", p->name);
+    }
+
+    ps->window[p->nlists] = capacity > 0;
+    p->lists[p->nlists].base = 0;
+    p->lists[p->nlists].capacity = capacity;
+
+    *list = p->nlists++;
+    return 0;
+}
+
+static int mgr_script_find_phase(mgr_script_parser *ps, const char *name, uint32_t *list) {
+    for (uint32_t i = 0; i < ps->nphases; ++i) {
+        if (strcmp(ps->phases[i].name, name) == 0) {
+            *list = ps->phases[i].list;
+            return 0;
+        }
+    }
+
+    return mgr_script_error(ps, "no earlier phase named", name);
+}
+
+// the current phase's blocks, or the named phase's with "from NAME"
+static int mgr_script_phase_list(mgr_script_parser *ps, const char *from, uint32_t *list) {
+    if (from) {
+        return mgr_script_find_phase(ps, from, list);
+    }
+
+    if (ps->nphases == 0) {
+        return mgr_script_error(ps, "expected 'phase' first", NULL);
+    }
+
+    *list = ps->phases[ps->nphases - 1].list;
+    return 0;
+}
+
+static int mgr_script_end_phase(mgr_script_parser *ps) {
+    if (ps->nphases == 0) {
+        return 0;
+    }
+
+    const mgr_script_phase *ph = ps->phases + ps->nphases - 1;
+
+    if (ph->repeat < 2 || ph->first_op == ps->prog->nops) {
+        return 0;
+    }
+
+    mgr_script_op *op = mgr_script_emit(ps, MGR_SCRIPT_LOOP);
+
+    if (op == NULL) {
+        return -1;
+    }
+
+    op->list = (uint8_t)(ps->prog->nloops++);
+    op->count = ph->repeat;
+    op->lo = ph->first_op;
+    return 0;
+}
+
+/*
+    Sizes every phase's ring buffer to the most blocks it ever holds,
+    by running the workload on counts alone. A loop whose pass leaves
+    the counts as it found them is left early: its remaining passes
+    would do the same.
+ */
+static int mgr_script_size_lists(mgr_script_parser *ps) {
+    mgr_script_program *p = ps->prog;
+
+    uint32_t len[MGR_SCRIPT_LISTS_MAX] = { 0 };
+    uint32_t peak[MGR_SCRIPT_LISTS_MAX] = { 0 };
+    uint32_t seen[MGR_SCRIPT_LISTS_MAX] = { 0 };
+    uint32_t loops[MGR_SCRIPT_LISTS_MAX] = { 0 };
+
+    for (uint32_t pc = 0; p->ops[pc].code != MGR_SCRIPT_END; ) {
+        const mgr_script_op *op = p->ops + pc;
+
+        switch (op->code) {
+        case MGR_SCRIPT_ALLOC:
+            if (ps->window[op->list]) {
+                const uint64_t n = (uint64_t)(len[op->list]) + op->count;
+                len[op->list] = n < p->lists[op->list].capacity ? (uint32_t)(n) : p->lists[op->list].capacity;
+            } else if ((uint64_t)(len[op->list]) + op->count > MGR_SCRIPT_BLOCKS_MAX) {
+                return mgr_script_error(ps, "too many live blocks in workload", p->name);
+            } else {
+                len[op->list] += op->count;
+            }
+
+            peak[op->list] = len[op->list] > peak[op->list] ? len[op->list] : peak[op->list];
+            ++pc;
+            break;
+
+        case MGR_SCRIPT_FREE_LIFO:
+        case MGR_SCRIPT_FREE_FIFO:
+        case MGR_SCRIPT_FREE_RANDOM:
+            len[op->list] -= op->count < len[op->list] ? op->count : len[op->list];
+            ++pc;
+            break;
+
+        case MGR_SCRIPT_LOOP:
+            if (++loops[op->list] < op->count
+                && (loops[op->list] == 1 || memcmp(len, seen, sizeof *len * p->nlists) != 0)) {
+                memcpy(seen, len, sizeof *len * p->nlists);
+                pc = op->lo;
+            } else {
+                loops[op->list] = 0;
+                ++pc;
+            }
+
+            break;
+
+        default:
+            ++pc;
+            break;
+        }
+    }
+
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < p->nlists; ++i) {
+        if (ps->window[i] == false) {
+            p->lists[i].capacity = peak[i] > 0 ? peak[i] : 1;
+        }
+
+        p->lists[i].base = (uint32_t)(total);
+        total += p->lists[i].capacity;
+
+        if (total > MGR_SCRIPT_BLOCKS_MAX) {
+            return mgr_script_error(ps, "too many live blocks in workload", p->name);
+        }
+    }
+
+    p->nblocks = (uint32_t)(total);
+    return 0;
+}
+
+static int mgr_script_end_workload(mgr_script_parser *ps) {
+    if (ps->prog == NULL) {
+        return 0;
+    }
+
+    if (mgr_script_end_phase(ps) != 0) {
+        return -1;
+    }
+
+    if (ps->prog->nops == 0) {
+        return mgr_script_error(ps, "empty workload", ps->prog->name);
+    }
+
+    if (mgr_script_emit(ps, MGR_SCRIPT_END) == NULL || mgr_script_size_lists(ps) != 0) {
+        return -1;
+    }
+
+    ps->prog = NULL;
+    return 0;
+}
+
+static int mgr_script_workload(mgr_script_parser *ps, char **words, int n) {
+    if (n != 2 || strlen(words[1]) >= MGR_SCRIPT_NAME_MAX) {
+        return mgr_script_error(ps, "expected 'workload NAME', NAME shorter than 32", NULL);
+    }
+
+    if (mgr_script_end_workload(ps) != 0) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < nscripts; ++i) {
+        if (strcmp(scripts[i].name, words[1]) == 0) {
+            return mgr_script_error(ps, "duplicate workload", words[1]);
+        }
+    }
+
+    mgr_script_program *grown = realloc(scripts, sizeof *grown * (nscripts + 1));
+
+    if (grown == NULL) {
+        return mgr_script_error(ps, "out of memory", NULL);
+    }
+
+    scripts = grown;
+    ps->prog = scripts + nscripts++;
+    ps->op_capacity = 0;
+    ps->nphases = 0;
+
+    memset(ps->prog, 0, sizeof *ps->prog);
+    strcpy(ps->prog->name, words[1]);
+    return 0;
+}
+
+static int mgr_script_phase_start(mgr_script_parser *ps, char **words, int n) {
+    mgr_script_phase *ph = ps->phases + ps->nphases;
+
+    if (ps->prog->nlists == MGR_SCRIPT_LISTS_MAX) {
+        return mgr_script_error(ps, "too many phases and life windows in workload", ps->prog->name);
+    }
+
+    if (n < 2 || n > 3 || strlen(words[1]) >= MGR_SCRIPT_NAME_MAX) {
+        return mgr_script_error(ps, "expected 'phase NAME [xREPEAT]', NAME shorter than 32", NULL);
+    }
+
+    ph->repeat = 1;
+
+    if (n == 3 && (words[2][0] != 'x' || mgr_script_count_word(words[2] + 1, &ph->repeat) != 0)) {
+        return mgr_script_error(ps, "invalid repeat", words[2]);
+    }
+
+    for (uint32_t i = 0; i < ps->nphases; ++i) {
+        if (strcmp(ps->phases[i].name, words[1]) == 0) {
+            return mgr_script_error(ps, "duplicate phase", words[1]);
+        }
+    }
+
+    if (mgr_script_end_phase(ps) != 0 || mgr_script_new_list(ps, 0, &ph->list) != 0) {
+        return -1;
+    }
+
+    strcpy(ph->name, words[1]);
+    ph->first_op = ps->prog->nops;
+    ++ps->nphases;
+    return 0;
+}
+
+static int mgr_script_alloc(mgr_script_parser *ps, char **words, int n) {
+    mgr_script_op op;
+    uint32_t life = 0;
+    uint32_t list = 0;
+
+    memset(&op, 0, sizeof op);
+
+    if ((n != 3 && n != 5) || (n == 5 && strcmp(words[3], "life") != 0)) {
+        return mgr_script_error(ps, "expected 'alloc COUNT SIZE [life L]'", NULL);
+    }
+
+    if (mgr_script_count_word(words[1], &op.count) != 0) {
+        return mgr_script_error(ps, "invalid count", words[1]);
+    }
+
+    if (mgr_script_parse_size(words[2], &op) != 0) {
+        return mgr_script_error(ps, "invalid size (64, 16-256 or 16-64K:log, at most 1G)", words[2]);
+    }
+
+    if (n == 5 && (mgr_script_count_word(words[4], &life) != 0 || life > MGR_SCRIPT_BLOCKS_MAX)) {
+        return mgr_script_error(ps, "invalid life", words[4]);
+    }
+
+    if (mgr_script_phase_list(ps, NULL, &list) != 0 || (life > 0 && mgr_script_new_list(ps, life, &list) != 0)) {
+        return -1;
+    }
+
+    mgr_script_op *emitted = mgr_script_emit(ps, MGR_SCRIPT_ALLOC);
+
+    if (emitted == NULL) {
+        return -1;
+    }
+
+    op.code = MGR_SCRIPT_ALLOC;
+    op.list = (uint8_t)(list);
+    *emitted = op;
+    return 0;
+}
+
+static int mgr_script_touch(mgr_script_parser *ps, char **words, int n) {
+    uint32_t list = 0;
+
+    if ((n != 1 && n != 3) || (n == 3 && strcmp(words[1], "from") != 0)) {
+        return mgr_script_error(ps, "expected 'touch [from PHASE]'", NULL);
+    }
+
+    if (mgr_script_phase_list(ps, n == 3 ? words[2] : NULL, &list) != 0) {
+        return -1;
+    }
+
+    mgr_script_op *op = mgr_script_emit(ps, MGR_SCRIPT_TOUCH);
+
+    if (op == NULL) {
+        return -1;
+    }
+
+    op->list = (uint8_t)(list);
+    return 0;
+}
+
+static int mgr_script_free(mgr_script_parser *ps, char **words, int n) {
+    mgr_script_opcode code = MGR_SCRIPT_FREE_LIFO;
+    uint32_t count = UINT32_MAX;
+    const char *from = NULL;
+    uint32_t list = 0;
+    int i = 1;
+
+    if (i < n && strcmp(words[i], "all") == 0) {
+        ++i;
+    } else if (i < n && mgr_script_count_word(words[i], &count) == 0) {
+        ++i;
+    }
+
+    if (i < n && strcmp(words[i], "lifo") == 0) {
+        ++i;
+    } else if (i < n && strcmp(words[i], "fifo") == 0) {
+        code = MGR_SCRIPT_FREE_FIFO;
+        ++i;
+    } else if (i < n && strcmp(words[i], "random") == 0) {
+        code = MGR_SCRIPT_FREE_RANDOM;
+        ++i;
+    }
+
+    if (i + 1 < n && strcmp(words[i], "from") == 0) {
+        from = words[i + 1];
+        i += 2;
+    }
+
+    if (i != n) {
+        return mgr_script_error(ps, "expected 'free [COUNT|all] [lifo|fifo|random] [from PHASE]'", NULL);
+    }
+
+    if (mgr_script_phase_list(ps, from, &list) != 0) {
+        return -1;
+    }
+
+    mgr_script_op *op = mgr_script_emit(ps, code);
+
+    if (op == NULL) {
+        return -1;
+    }
+
+    op->list = (uint8_t)(list);
+    op->count = count;
+    return 0;
+}
+
+static int mgr_script_line(mgr_script_parser *ps, char *line) {
+    char *words[MGR_SCRIPT_WORDS + 1];
+    char *save = NULL;
+    int n = 0;
+
+    for (char *w = strtok_r(line, " \t\r\n", &save); w; w = strtok_r(NULL, " \t\r\n", &save)) {
+        if (n == MGR_SCRIPT_WORDS) {
+            return mgr_script_error(ps, "too many words", NULL);
+        }
+
+        words[n++] = w;
+    }
+
+    if (n == 0) {
+        return 0;
+    }
+
+    if (strcmp(words[0], "workload") == 0) {
+        return mgr_script_workload(ps, words, n);
+    }
+
+    if (ps->prog == NULL) {
+        return mgr_script_error(ps, "expected 'workload' first", NULL);
+    }
+
+    if (strcmp(words[0], "threads") == 0) {
+        if (n != 2 || mgr_script_count_word(words[1], &ps->prog->threads) != 0) {
+            return mgr_script_error(ps, "expected 'threads N'", NULL);
+        }
+
+        return 0;
+    } else if (strcmp(words[0], "phase") == 0) {
+        return mgr_script_phase_start(ps, words, n);
+    } else if (strcmp(words[0], "alloc") == 0) {
+        return mgr_script_alloc(ps, words, n);
+    } else if (strcmp(words[0], "touch") == 0) {
+        return mgr_script_touch(ps, words, n);
+    } else if (strcmp(words[0], "free") == 0) {
+        return mgr_script_free(ps, words, n);
+    }
+
+    return mgr_script_error(ps, "unknown directive", words[0]);
+}
+
+/*!
+    \brief  Compiles every workload of a script
+
+    \param[in]  path    script file
+
+    \return     0 on success, -1 on the first invalid line
+                (reported on stderr with its line number)
+ */
+int mgr_script_load(const char *path) {
+    FILE *file = fopen(path, "r");
+
+    mgr_script_unload();
+
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    mgr_script_parser *ps = calloc(1, sizeof *ps);
+    char line[1024];
+    int status = ps ? 0 : -1;
+
+    if (ps) {
+        ps->path = path;
+    }
+
+    while (status == 0 && fgets(line, sizeof line, file)) {
+        ++ps->lineno;
+
+        char *hash = strchr(line, '#');
+
+        if (hash) {
+            *hash = '\0';
+        }
+
+        status = mgr_script_line(ps, line);
+    }
+
+    if (status == 0) {
+        status = mgr_script_end_workload(ps);
+    }
+
+    if (status == 0 && nscripts == 0) {
+        fprintf(stderr, "memgrind: %s: no workloads\n", path);
+        status = -1;
+    }
+
+    if (status != 0) {
+        mgr_script_unload();
+    }
+
+    free(ps);
+    fclose(file);
+    return status;
+}
+
+/*!
+    \brief  Releases the workloads compiled by mgr_script_load
+ */
+void mgr_script_unload(void) {
+    for (uint32_t i = 0; i < nscripts; ++i) {
+        free(scripts[i].ops);
+    }
+
+    free(scripts);
+    scripts = NULL;
+    nscripts = 0;
+}
+
+/*!
+    \brief  Number of workloads loaded
+
+    \return     workloads compiled by the last mgr_script_load
+ */
+uint32_t mgr_script_count(void) {
+    return nscripts;
+}
+
+/*!
+    \brief  A loaded workload
+
+    \param[in]  index   in [0, mgr_script_count())
+
+    \return     the compiled workload, or NULL if index is out of range
+ */
+const mgr_script_program *mgr_script_get(uint32_t index) {
+    return index < nscripts ? scripts + index : NULL;
+}
+
+typedef struct mgr_script_block {
+    char *ptr;
+    size_t size;
+} mgr_script_block;
+
+typedef struct mgr_script_ring {
+    mgr_script_block *blocks;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t len;
+} mgr_script_ring;
+
+/*
+    Blocks of the workload running on this thread; grown with the C
+    library, outside of the allocator under test, and reused from one
+    repetition to the next.
+ */
+static _Thread_local mgr_script_block *script_blocks = NULL;
+static _Thread_local uint32_t script_capacity = 0;
+static _Thread_local mgr_script_ring script_rings[MGR_SCRIPT_LISTS_MAX];
+static _Thread_local uint32_t script_loops[MGR_SCRIPT_LISTS_MAX];
+
+static inline uint32_t mgr_script_slot(const mgr_script_ring *r, uint32_t i) {
+    const uint32_t slot = r->head + i;
+    return slot < r->capacity ? slot : slot - r->capacity;
+}
+
+static inline size_t mgr_script_size(const mgr_script_op *op) {
+    if (op->dist == MGR_SCRIPT_FIXED) {
+        return op->lo;
+    } else if (op->dist == MGR_SCRIPT_UNIFORM) {
+        return mgr_rand_range(op->lo, op->hi + 1);
+    }
+
+    const uint32_t e = mgr_rand_range(op->lo_exp, op->hi_exp + 1u);
+    const uint32_t lo = (uint32_t)(1) << e > op->lo ? (uint32_t)(1) << e : op->lo;
+    const uint32_t hi = ((uint32_t)(2) << e) - 1 < op->hi ? ((uint32_t)(2) << e) - 1 : op->hi;
+
+    return mgr_rand_range(lo, hi + 1);
+}
+
+/*!
+    \brief  Workload: runs a loaded workload through the current backend
+
+    \details    Frees whatever the workload leaves live, so repetitions
+                start from the same state.
+
+    \param[in]  index           workload, in [0, mgr_script_count())
+    \param[in]  unused_value1   unused value -- needed for function uniformity
+    \param[in]  unused_value2   unused value -- needed for function uniformity
+ */
+void mgr_script_run(uint32_t index, uint32_t unused_value1, uint32_t unused_value2) {
+    const mgr_script_program *p = mgr_script_get(index);
+
+    if (p == NULL) {
+        return;
+    }
+
+    if (p->nblocks > script_capacity) {
+        mgr_script_block *blocks = realloc(script_blocks, sizeof *blocks * p->nblocks);
+
+        if (blocks == NULL) {
+            return;
+        }
+
+        script_blocks = blocks;
+        script_capacity = p->nblocks;
+    }
+
+    for (uint32_t i = 0; i < p->nlists; ++i) {
+        script_rings[i].blocks = script_blocks + p->lists[i].base;
+        script_rings[i].capacity = p->lists[i].capacity;
+        script_rings[i].head = 0;
+        script_rings[i].len = 0;
+    }
+
+    memset(script_loops, 0, sizeof *script_loops * p->nloops);
+
+    for (const mgr_script_op *op = p->ops; op->code != MGR_SCRIPT_END; ) {
+        mgr_script_ring *r = script_rings + op->list;
+
+        switch (op->code) {
+        case MGR_SCRIPT_ALLOC:
+            for (uint32_t i = 0; i < op->count; ++i) {
+                if (r->len == r->capacity) {
+                    mgr_free(r->blocks[r->head].ptr);
+                    r->head = mgr_script_slot(r, 1);
+                    --r->len;
+                }
+
+                const size_t size = mgr_script_size(op);
+                char *ptr = mgr_malloc(size);
+
+                if (ptr == NULL) {
+                    break;
+                }
+
+                ptr[0] = (char)(i);
+
+                mgr_script_block *b = r->blocks + mgr_script_slot(r, r->len++);
+
+                b->ptr = ptr;
+                b->size = size;
+            }
+
+            ++op;
+            break;
+
+        case MGR_SCRIPT_TOUCH:
+            for (uint32_t i = 0; i < r->len; ++i) {
+                const mgr_script_block *b = r->blocks + mgr_script_slot(r, i);
+
+                for (size_t off = 0; off < b->size; off += MGR_SCRIPT_LINE) {
+                    b->ptr[off] = (char)(off);
+                }
+            }
+
+            ++op;
+            break;
+
+        case MGR_SCRIPT_FREE_LIFO:
+            for (uint32_t i = 0; i < op->count && r->len > 0; ++i) {
+                mgr_free(r->blocks[mgr_script_slot(r, --r->len)].ptr);
+            }
+
+            ++op;
+            break;
+
+        case MGR_SCRIPT_FREE_FIFO:
+            for (uint32_t i = 0; i < op->count && r->len > 0; ++i) {
+                mgr_free(r->blocks[r->head].ptr);
+                r->head = mgr_script_slot(r, 1);
+                --r->len;
+            }
+
+            ++op;
+            break;
+
+        case MGR_SCRIPT_FREE_RANDOM:
+            for (uint32_t i = 0; i < op->count && r->len > 0; ++i) {
+                const uint32_t slot = mgr_script_slot(r, mgr_rand_below(r->len));
+                const uint32_t last = mgr_script_slot(r, --r->len);
+
+                mgr_free(r->blocks[slot].ptr);
+                r->blocks[slot] = r->blocks[last];
+            }
+
+            ++op;
+            break;
+
+        case MGR_SCRIPT_LOOP:
+            if (++script_loops[op->list] < op->count) {
+                op = p->ops + op->lo;
+            } else {
+                script_loops[op->list] = 0;
+                ++op;
+            }
+
+            break;
+        }
+    }
+
+    for (uint32_t i = p->nlists; i-- > 0; ) {
+        mgr_script_ring *r = script_rings + i;
+
+        while (r->len > 0) {
+            mgr_free(r->blocks[mgr_script_slot(r, --r->len)].ptr);
+        }
+    }
+}
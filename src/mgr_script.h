@@ -0,0 +1,117 @@
+/*!
+    \file       mgr_script.h
+    \brief      Header file for memgrind_c workload scripts
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    A workload script describes allocation patterns without C code.
+    One directive per line; '#' starts a comment; sizes and counts
+    take a K or M suffix:
+
+        workload NAME               starts a workload
+        threads N                   also run it on N threads
+        phase NAME [xREPEAT]        starts a phase, run REPEAT times
+        alloc COUNT SIZE [life L]   allocates COUNT blocks
+        touch [from PHASE]          writes every cache line of the
+                                    live blocks
+        free [COUNT|all] [ORDER] [from PHASE]
+                                    frees live blocks, lifo (default),
+                                    fifo or random
+
+    SIZE is fixed (64), uniform over a range (16-256), or spread evenly
+    over the powers of two of a range (16-64K:log). Blocks belong to
+    the phase that allocates them, and outlive it unless freed; alloc
+    and free work on the current phase's blocks, touch and free on an
+    earlier phase's with "from". A block allocated with "life L" is
+    freed by its op's allocation L blocks later: a sliding window of
+    short-lived blocks. Whatever is live at the end of the workload
+    is freed, last first.
+
+    A script is compiled once, when loaded, into an op array per
+    workload: every phase's blocks get a ring buffer sized to the most
+    they ever hold, so running a workload is one pass of a switch over
+    the ops, without parsing or bookkeeping allocations.
+ */
+
+#ifndef MGR_SCRIPT_H
+#define MGR_SCRIPT_H
+
+#include <stdint.h>
+
+// largest block
+#define MGR_SCRIPT_SIZE_MAX ((uint32_t)(1) << 30)
+
+// most blocks a workload keeps live
+#define MGR_SCRIPT_BLOCKS_MAX ((uint32_t)(1) << 24)
+
+// most phases and life windows in a workload
+#define MGR_SCRIPT_LISTS_MAX 256
+
+// length of a workload or phase name
+#define MGR_SCRIPT_NAME_MAX 32
+
+typedef enum mgr_script_opcode {
+    MGR_SCRIPT_ALLOC,           // into list, evicting its oldest block if full
+    MGR_SCRIPT_TOUCH,
+    MGR_SCRIPT_FREE_LIFO,
+    MGR_SCRIPT_FREE_FIFO,
+    MGR_SCRIPT_FREE_RANDOM,
+    MGR_SCRIPT_LOOP,            // back to op lo, count times in all
+    MGR_SCRIPT_END
+} mgr_script_opcode;
+
+typedef enum mgr_script_dist {
+    MGR_SCRIPT_FIXED,           // lo
+    MGR_SCRIPT_UNIFORM,         // lo to hi
+    MGR_SCRIPT_LOG              // powers of two lo to hi, then uniform in one
+} mgr_script_dist;
+
+/*!
+    \brief  One compiled op
+ */
+typedef struct mgr_script_op {
+    uint8_t code;               // mgr_script_opcode
+    uint8_t dist;               // mgr_script_dist (alloc)
+    uint8_t list;               // list of blocks; loop counter (loop)
+    uint8_t lo_exp;             // powers of two of lo and hi (log)
+    uint8_t hi_exp;
+    uint32_t count;             // blocks, UINT32_MAX for all; repetitions (loop)
+    uint32_t lo;                // sizes; target op (loop)
+    uint32_t hi;
+} mgr_script_op;
+
+/*!
+    \brief  A ring buffer of blocks, in the workload's block array
+ */
+typedef struct mgr_script_list {
+    uint32_t base;
+    uint32_t capacity;
+} mgr_script_list;
+
+/*!
+    \brief  A compiled workload
+ */
+typedef struct mgr_script_program {
+    char name[MGR_SCRIPT_NAME_MAX];
+    uint32_t threads;           // 0 if only run on the main thread
+
+    mgr_script_op *ops;
+    uint32_t nops;
+
+    mgr_script_list lists[MGR_SCRIPT_LISTS_MAX];
+    uint32_t nlists;
+    uint32_t nloops;
+    uint32_t nblocks;           // sum of list capacities
+} mgr_script_program;
+
+int mgr_script_load(const char *path);
+void mgr_script_unload(void);
+
+uint32_t mgr_script_count(void);
+const mgr_script_program *mgr_script_get(uint32_t index);
+
+void mgr_script_run(uint32_t index, uint32_t unused_value1, uint32_t unused_value2);
+
+#endif /* MGR_SCRIPT_H */
@@ -0,0 +1,280 @@
+/*!
+    \file       mgr_soak.c
+    \brief      Source file for the memgrind_c steady-state soak workload
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_soak.h"
+#include "mgr_alloc.h"
+#include "mgr_footprint.h"
+#include "mgr_hist.h"
+#include "mgr_rand.h"
+#include "mgr_stats.h"
+
+#include "cgcs_ulog.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// shape of the Pareto lifetime distribution (finite mean, infinite variance)
+#define MGR_SOAK_PARETO_SHAPE 1.5
+
+static const char *const mgr_lifetime_names[] = { "exp", "fifo", "pareto" };
+
+/*
+    Live object, kept in a binary min-heap ordered by the step
+    at which its lifetime runs out.
+ */
+typedef struct soak_object {
+    uint64_t death;
+    char *ptr;
+    uint32_t size;
+} soak_object;
+
+/*!
+    \brief  Looks up a lifetime distribution by name
+
+    \param[in]  name    "exp", "fifo" or "pareto"
+    \param[out] out     lifetime distribution
+
+    \return     0 on success, -1 if there is no such distribution
+ */
+int mgr_lifetime_parse(const char *name, mgr_lifetime *out) {
+    for (size_t i = 0; i < sizeof mgr_lifetime_names / sizeof *mgr_lifetime_names; ++i) {
+        if (strcmp(name, mgr_lifetime_names[i]) == 0) {
+            *out = (mgr_lifetime)(i);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+    \brief  Name of a lifetime distribution
+
+    \param[in]  lifetime    lifetime distribution
+
+    \return     its name, as accepted by mgr_lifetime_parse
+ */
+const char *mgr_lifetime_name(mgr_lifetime lifetime) {
+    return mgr_lifetime_names[lifetime];
+}
+
+// uniform in [0, 1)
+static double soak_uniform(void) {
+    return (double)(mgr_rand_next() >> 11) / 9007199254740992.0;
+}
+
+static uint64_t soak_lifetime(mgr_lifetime lifetime, double mean) {
+    double steps = mean;
+
+    if (lifetime == MGR_LIFETIME_EXP) {
+        steps = -mean * log(1.0 - soak_uniform());
+    } else if (lifetime == MGR_LIFETIME_PARETO) {
+        // scale chosen so that the mean is mean
+        const double scale = mean * (MGR_SOAK_PARETO_SHAPE - 1.0) / MGR_SOAK_PARETO_SHAPE;
+        steps = scale / pow(1.0 - soak_uniform(), 1.0 / MGR_SOAK_PARETO_SHAPE);
+    }
+
+    return steps < 1e15 ? (uint64_t)(steps) + 1 : (uint64_t)(1e15);
+}
+
+static void soak_touch(char *ptr, uint32_t size) {
+    if (ptr && size > 0) {
+        ptr[0] = (char)(size);
+        ptr[size - 1] = (char)(size);
+    }
+}
+
+static void soak_sift_down(soak_object *heap, size_t count, size_t i) {
+    const soak_object x = heap[i];
+
+    for (;;) {
+        size_t child = (2 * i) + 1;
+
+        if (child >= count) {
+            break;
+        }
+
+        if (child + 1 < count && heap[child + 1].death < heap[child].death) {
+            ++child;
+        }
+
+        if (heap[child].death >= x.death) {
+            break;
+        }
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = x;
+}
+
+static void soak_fprint_window(FILE *dest, double t, const mgr_hist *h, double seconds) {
+    size_t rss = 0;
+    mgr_backend_stats stats;
+
+    fprintf(dest, "%s%8.1lf%s\t%12.0lf\t%8.0lf\t%8llu\t%8llu\t%8llu\t%10llu",
+            KGRN_b, t, KNRM,
+            (double)(h->total) / seconds,
+            mgr_hist_mean(h),
+            (unsigned long long)(mgr_hist_percentile(h, 50.0)),
+            (unsigned long long)(mgr_hist_percentile(h, 99.0)),
+            (unsigned long long)(mgr_hist_percentile(h, 99.9)),
+            (unsigned long long)(h->total ? h->max : 0));
+
+    if (mgr_rss_bytes(&rss)) {
+        fprintf(dest, "\t%10.1lf", (double)(rss) / 1048576.0);
+    } else {
+        fprintf(dest, "\t%10s", "-");
+    }
+
+    if (mgr_backend_current->stats_fn && mgr_backend_current->stats_fn(&stats) == 0) {
+        fprintf(dest, "\t%10.1lf\n", (double)(stats.mapped) / 1048576.0);
+    } else {
+        fprintf(dest, "\t%10s\n", "-");
+    }
+}
+
+/*!
+    \brief  Runs the soak workload (see mgr_soak.h) and outputs one row
+            per time window to dest
+
+    \details    Objects are kept in a heap allocated from the C library,
+                outside of the allocator under test; only the free and
+                malloc of every step are timed.
+
+    \param[in]  opts    soak settings
+    \param[in]  dest    destination file stream
+
+    \return     0 on success, -1 if the live set cannot be tracked
+                or the allocator runs out of memory while filling
+ */
+int mgr_run_soak(const mgr_soak_opts *opts, FILE *dest) {
+    const uint32_t min = opts->min;
+    const uint32_t max = opts->max;
+    const double mean_size = ((double)(min) + (double)(max)) / 2.0;
+    const size_t count = mean_size > 0.0 ? (size_t)((double)(opts->bytes) / mean_size) : 0;
+
+    if (count == 0) {
+        fprintf(stderr, "memgrind: soak: a live set of %llu bytes holds no objects\n",
+                (unsigned long long)(opts->bytes));
+        return -1;
+    }
+
+    soak_object *heap = calloc(count, sizeof *heap);
+    mgr_hist *window = malloc(sizeof *window);
+
+    if (heap == NULL || window == NULL) {
+        fprintf(stderr, "memgrind: soak: cannot track %zu objects\n", count);
+        free(heap);
+        free(window);
+        return -1;
+    }
+
+    fprintf(dest, "\n%s (%s %llu %s, %zu %s of %u-%u %s, %s %s)\n",
+                  KGRN_b"soak"KNRM,
+                  "live set", (unsigned long long)(opts->bytes), "bytes",
+                  count, "objects", min, max, "bytes",
+                  mgr_lifetime_name(opts->lifetime), "lifetimes");
+
+    // fill: every object is born at step 0
+    const uint64_t fill_start = mgr_clock_ns();
+    int status = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t size = mgr_rand_between(min, max);
+
+        heap[i].ptr = mgr_malloc(size);
+        heap[i].size = size;
+        heap[i].death = soak_lifetime(opts->lifetime, (double)(count));
+
+        if (heap[i].ptr == NULL) {
+            fprintf(stderr, "memgrind: soak: out of memory after %zu objects\n", i);
+            status = -1;
+            break;
+        }
+
+        soak_touch(heap[i].ptr, size);
+    }
+
+    const uint64_t fill_end = mgr_clock_ns();
+
+    if (status == 0) {
+        for (size_t i = count / 2; i-- > 0;) {
+            soak_sift_down(heap, count, i);
+        }
+
+        fprintf(dest, "%s %.3lf s\n\n", "filled in", (double)(fill_end - fill_start) / 1e9);
+        fprintf(dest, "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+                KWHT_b"time (s)"KNRM, KWHT_b"  steps/s"KNRM, KWHT_b"mean ns"KNRM,
+                KWHT_b"p50 ns"KNRM, KWHT_b"p99 ns"KNRM, KWHT_b"p99.9 ns"KNRM,
+                KWHT_b"max ns"KNRM, KWHT_b"rss MiB"KNRM, KWHT_b"heap MiB"KNRM);
+    }
+
+    const uint64_t window_ns = (uint64_t)(opts->window_ms > 0 ? opts->window_ms : 1) * 1000000ull;
+    const uint64_t start = mgr_clock_ns();
+    const uint64_t end = start + (uint64_t)(opts->seconds * 1e9);
+    uint64_t window_start = start;
+    uint64_t step = 0;
+
+    mgr_hist_reset(window);
+
+    while (status == 0) {
+        soak_object *victim = &heap[0];
+        const uint32_t size = mgr_rand_between(min, max);
+
+        const uint64_t x = mgr_clock_ns();
+        mgr_free(victim->ptr);
+        char *ptr = mgr_malloc(size);
+        const uint64_t y = mgr_clock_ns();
+
+        mgr_hist_record(window, y - x);
+
+        if (ptr == NULL) {
+            fprintf(stderr, "memgrind: soak: out of memory at step %llu\n", (unsigned long long)(step));
+            victim->ptr = NULL;
+            status = -1;
+            break;
+        }
+
+        soak_touch(ptr, size);
+
+        ++step;
+        victim->ptr = ptr;
+        victim->size = size;
+        victim->death = step + soak_lifetime(opts->lifetime, (double)(count));
+        soak_sift_down(heap, count, 0);
+
+        if (y - window_start >= window_ns || y >= end) {
+            soak_fprint_window(dest, (double)(y - start) / 1e9, window,
+                               (double)(y - window_start) / 1e9);
+
+            mgr_hist_reset(window);
+            window_start = y;
+
+            if (y >= end) {
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (heap[i].ptr) {
+            mgr_free(heap[i].ptr);
+        }
+    }
+
+    free(heap);
+    free(window);
+
+    return status;
+}
@@ -0,0 +1,55 @@
+/*!
+    \file       mgr_soak.h
+    \brief      Header file for the memgrind_c steady-state soak workload
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    The soak fills the heap to a target number of live bytes, then, for
+    a given time, keeps it there: every step frees the live object whose
+    lifetime ran out first and allocates its replacement, of a random
+    size in [min, max]. Every object is given a lifetime when it is
+    allocated, drawn from one of:
+
+    - exp: exponential (memoryless; the victim is effectively random)
+    - fifo: the same for every object (the oldest object dies first)
+    - pareto: heavy-tailed (shape 1.5); most objects die young, while a
+      few outlive many generations of their neighbours, which is what
+      fragments long-running heaps
+
+    Lifetimes are counted in steps and scaled to a mean of one live set
+    (so, in steady state, the live set is replaced once per that many
+    steps on average).
+
+    Throughput, step latency (free + malloc), resident set size and,
+    if the backend reports it, heap size are printed per time window.
+ */
+
+#ifndef MGR_SOAK_H
+#define MGR_SOAK_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum mgr_lifetime {
+    MGR_LIFETIME_EXP,
+    MGR_LIFETIME_FIFO,
+    MGR_LIFETIME_PARETO
+} mgr_lifetime;
+
+typedef struct mgr_soak_opts {
+    uint64_t bytes;         // target live bytes
+    uint32_t min;           // smallest object
+    uint32_t max;           // largest object
+    double seconds;         // steady-state run time, after the fill
+    uint32_t window_ms;     // reporting window
+    mgr_lifetime lifetime;
+} mgr_soak_opts;
+
+int mgr_lifetime_parse(const char *name, mgr_lifetime *out);
+const char *mgr_lifetime_name(mgr_lifetime lifetime);
+
+int mgr_run_soak(const mgr_soak_opts *opts, FILE *dest);
+
+#endif /* MGR_SOAK_H */
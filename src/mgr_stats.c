@@ -0,0 +1,167 @@
+/*!
+    \file       mgr_stats.c
+    \brief      Source file for memgrind_c timing samples and summary statistics
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mgr_stats.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Two-sided 95% critical values of Student's t distribution,
+    indexed by degrees of freedom (1...30).
+    Beyond 30 degrees of freedom, the normal value 1.96 is close enough.
+ */
+static const double t_crit_95[] = {
+    0.0,
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static int compare_double(const void *d0, const void *d1) {
+    const double a = *(const double *)(d0);
+    const double b = *(const double *)(d1);
+    return (a > b) - (a < b);
+}
+
+/*!
+    \brief  Initializes a sample store with room for capacity samples
+
+    \param[out] s           sample store
+    \param[in]  capacity    initial capacity (grows as needed)
+ */
+void mgr_samples_init(mgr_samples *s, size_t capacity) {
+    s->capacity = capacity > 0 ? capacity : 1;
+    s->size = 0;
+    s->data = malloc(sizeof *s->data * s->capacity);
+
+    if (s->data == NULL) {
+        s->capacity = 0;
+    }
+}
+
+/*!
+    \brief  Releases the memory held by a sample store
+
+    \param[in]  s   sample store
+ */
+void mgr_samples_deinit(mgr_samples *s) {
+    free(s->data);
+    s->data = NULL;
+    s->size = 0;
+    s->capacity = 0;
+}
+
+/*!
+    \brief  Discards all samples, keeping the capacity
+
+    \param[in]  s   sample store
+ */
+void mgr_samples_clear(mgr_samples *s) {
+    s->size = 0;
+}
+
+/*!
+    \brief  Appends a sample, doubling the store's capacity if full
+
+    \param[in]  s       sample store
+    \param[in]  value   sample value
+ */
+void mgr_samples_push(mgr_samples *s, double value) {
+    if (s->size == s->capacity) {
+        size_t capacity = s->capacity > 0 ? s->capacity * 2 : 16;
+        double *data = realloc(s->data, sizeof *data * capacity);
+
+        if (data == NULL) {
+            return;
+        }
+
+        s->data = data;
+        s->capacity = capacity;
+    }
+
+    s->data[s->size++] = value;
+}
+
+/*!
+    \brief  Percentile of an ascending array, linearly interpolated
+            between the two closest ranks
+
+    \param[in]  sorted  ascending array of values
+    \param[in]  n       number of values in sorted
+    \param[in]  p       percentile, in [0, 100]
+
+    \return     the pth percentile of sorted, or 0.0 if n is 0
+ */
+double mgr_percentile_sorted(const double *sorted, size_t n, double p) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    const double rank = (p / 100.0) * (double)(n - 1);
+    const size_t lo = (size_t)(rank);
+    const size_t hi = lo + 1 < n ? lo + 1 : lo;
+    const double frac = rank - (double)(lo);
+
+    return sorted[lo] + ((sorted[hi] - sorted[lo]) * frac);
+}
+
+/*!
+    \brief  Computes order statistics, standard deviation, and a
+            95% confidence interval of the mean for a sample store
+
+    \details    The samples are sorted in place.
+                The standard deviation is the sample (n - 1) deviation,
+                accumulated with Welford's method for stability.
+
+    \param[in]  s   sample store
+    \param[out] out summary of s
+ */
+void mgr_summarize(mgr_samples *s, mgr_summary *out) {
+    memset(out, 0, sizeof *out);
+
+    if (s->size == 0) {
+        return;
+    }
+
+    qsort(s->data, s->size, sizeof *s->data, compare_double);
+
+    double mean = 0.0;
+    double m2 = 0.0;
+    double total = 0.0;
+
+    for (size_t i = 0; i < s->size; ++i) {
+        const double x = s->data[i];
+        const double delta = x - mean;
+
+        mean += delta / (double)(i + 1);
+        m2 += delta * (x - mean);
+        total += x;
+    }
+
+    out->count = s->size;
+    out->total = total;
+    out->mean = mean;
+    out->min = s->data[0];
+    out->max = s->data[s->size - 1];
+    out->median = mgr_percentile_sorted(s->data, s->size, 50.0);
+    out->p90 = mgr_percentile_sorted(s->data, s->size, 90.0);
+    out->p99 = mgr_percentile_sorted(s->data, s->size, 99.0);
+
+    if (s->size > 1) {
+        const size_t df = s->size - 1;
+        const size_t t_len = sizeof t_crit_95 / sizeof *t_crit_95;
+        const double t = df < t_len ? t_crit_95[df] : 1.96;
+
+        out->stddev = sqrt(m2 / (double)(df));
+        out->ci95 = t * out->stddev / sqrt((double)(s->size));
+    }
+}
@@ -0,0 +1,69 @@
+/*!
+    \file       mgr_stats.h
+    \brief      Header file for memgrind_c timing samples and summary statistics
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#ifndef MGR_STATS_H
+#define MGR_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+/*!
+    \brief  Growable store of per-repetition timing samples (nanoseconds)
+ */
+typedef struct mgr_samples {
+    double *data;
+    size_t size;
+    size_t capacity;
+} mgr_samples;
+
+/*!
+    \brief  Order statistics and dispersion of a set of samples
+ */
+typedef struct mgr_summary {
+    size_t count;
+
+    double total;
+    double mean;
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double max;
+    double stddev;
+
+    // half-width of the 95% confidence interval of the mean
+    double ci95;
+} mgr_summary;
+
+void mgr_samples_init(mgr_samples *s, size_t capacity);
+void mgr_samples_deinit(mgr_samples *s);
+void mgr_samples_clear(mgr_samples *s);
+void mgr_samples_push(mgr_samples *s, double value);
+
+// Sorts the samples in place, then fills out
+void mgr_summarize(mgr_samples *s, mgr_summary *out);
+
+// Percentile p in [0, 100] of an ascending array, linearly interpolated
+double mgr_percentile_sorted(const double *sorted, size_t n, double p);
+
+/*!
+    \brief  Reads the monotonic clock, in nanoseconds.
+
+    \details    CLOCK_MONOTONIC is immune to NTP slews and wall-clock
+                adjustments, which CLOCK_REALTIME is not.
+
+    \return     nanoseconds since an unspecified starting point
+ */
+static inline uint64_t mgr_clock_ns(void) {
+    struct timespec ts = { 0, 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)(ts.tv_sec) * UINT64_C(1000000000)) + (uint64_t)(ts.tv_nsec);
+}
+
+#endif /* MGR_STATS_H */
@@ -0,0 +1,952 @@
+/*!
+    \file       mgr_thread.c
+    \brief      Source file for memgrind_c multithreaded contention runs
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Threaded runs start every thread behind a barrier, so all threads
+    enter the allocator at the same moment instead of trickling in
+    while pthread_create is still spawning the rest.
+
+    Threads are pinned round-robin to the online cpus where the
+    platform supports it (Linux); elsewhere they float.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "mgr_thread.h"
+#include "mgr_alloc.h"
+#include "mgr_rand.h"
+
+#include "cgcs_ulog.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// capacity of each producer/consumer handoff ring
+#define MGR_XFREE_RING_CAPACITY 1024
+
+// operations per latency sample of a producer/consumer thread
+#define MGR_XFREE_BATCH 64
+
+// blocks a remote free queue holds before its producers back off
+#define MGR_REMOTE_INFLIGHT 4096
+
+/*
+    Portable counting barrier (pthread_barrier_t is optional in POSIX,
+    and missing on macOS).
+ */
+typedef struct mgr_barrier {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t waiting;
+    uint32_t phase;
+} mgr_barrier;
+
+/*
+    Bounded ring through which a producer hands
+    allocated blocks to its consumer.
+ */
+typedef struct mgr_ring {
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    void *slots[MGR_XFREE_RING_CAPACITY];
+    size_t head;
+    size_t size;
+    bool done;
+} mgr_ring;
+
+/*
+    Intrusive lock-free multi-producer, single-consumer queue (Vyukov):
+    the first bytes of a handed-over block are its link and the time it
+    was pushed, so a push allocates nothing. A push is one atomic
+    exchange; a pop, by the queue's one consumer, takes no lock.
+ */
+typedef struct mgr_mpsc_node {
+    _Atomic(struct mgr_mpsc_node *) next;
+    uint64_t pushed_ns;
+} mgr_mpsc_node;
+
+typedef struct mgr_mpsc {
+    _Alignas(64) _Atomic(mgr_mpsc_node *) head;     // producers push here
+    atomic_uint pending;                            // pushed, not yet popped
+    _Alignas(64) mgr_mpsc_node *tail;               // the consumer pops here
+    mgr_mpsc_node stub;
+} mgr_mpsc;
+
+/*
+    Queues of a remote free run, one per consumer,
+    and how many producers are still pushing.
+ */
+typedef struct mgr_remote {
+    mgr_mpsc *queues;
+    uint32_t nqueues;
+    atomic_uint producers;
+} mgr_remote;
+
+typedef enum mgr_role {
+    MGR_ROLE_WORKLOAD,
+    MGR_ROLE_PRODUCER,
+    MGR_ROLE_CONSUMER,
+    MGR_ROLE_REMOTE_PRODUCER,
+    MGR_ROLE_REMOTE_CONSUMER
+} mgr_role;
+
+typedef struct mgr_worker {
+    pthread_t tid;
+    mgr_role role;
+    int cpu;
+    uint64_t stream;    // random stream of this thread
+
+    mgr_barrier *barrier;
+    mgr_ring *ring;
+    mgr_remote *remote;
+    uint32_t queue;     // remote free: queue consumed, or first queue pushed to
+    mgr_hist *handoff;  // remote free consumer: push-to-free latency (ns)
+
+    memgrind_func_t test;
+    uint32_t min;
+    uint32_t max;
+    uint32_t interval;
+    uint32_t warmup;
+    uint32_t reps;
+
+    mgr_oplat *oplat;
+    mgr_samples samples;
+    mgr_thread_stat stat;
+} mgr_worker;
+
+static void mgr_barrier_init(mgr_barrier *b, uint32_t count) {
+    pthread_mutex_init(&b->mutex, NULL);
+    pthread_cond_init(&b->cond, NULL);
+    b->count = count;
+    b->waiting = 0;
+    b->phase = 0;
+}
+
+static void mgr_barrier_deinit(mgr_barrier *b) {
+    pthread_cond_destroy(&b->cond);
+    pthread_mutex_destroy(&b->mutex);
+}
+
+static void mgr_barrier_wait(mgr_barrier *b) {
+    pthread_mutex_lock(&b->mutex);
+
+    const uint32_t phase = b->phase;
+
+    if (++b->waiting == b->count) {
+        b->waiting = 0;
+        ++b->phase;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (phase == b->phase) {
+            pthread_cond_wait(&b->cond, &b->mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&b->mutex);
+}
+
+static void mgr_ring_init(mgr_ring *r) {
+    pthread_mutex_init(&r->mutex, NULL);
+    pthread_cond_init(&r->not_empty, NULL);
+    pthread_cond_init(&r->not_full, NULL);
+    r->head = 0;
+    r->size = 0;
+    r->done = false;
+}
+
+static void mgr_ring_deinit(mgr_ring *r) {
+    pthread_cond_destroy(&r->not_full);
+    pthread_cond_destroy(&r->not_empty);
+    pthread_mutex_destroy(&r->mutex);
+}
+
+/*
+    Returns false if the ring was closed (its consumer never started).
+ */
+static bool mgr_ring_push(mgr_ring *r, void *ptr) {
+    pthread_mutex_lock(&r->mutex);
+
+    while (r->size == MGR_XFREE_RING_CAPACITY && r->done == false) {
+        pthread_cond_wait(&r->not_full, &r->mutex);
+    }
+
+    if (r->done) {
+        pthread_mutex_unlock(&r->mutex);
+        return false;
+    }
+
+    r->slots[(r->head + r->size) % MGR_XFREE_RING_CAPACITY] = ptr;
+    ++r->size;
+
+    pthread_cond_signal(&r->not_empty);
+    pthread_mutex_unlock(&r->mutex);
+    return true;
+}
+
+static void mgr_ring_close(mgr_ring *r) {
+    pthread_mutex_lock(&r->mutex);
+    r->done = true;
+    pthread_cond_broadcast(&r->not_empty);
+    pthread_cond_broadcast(&r->not_full);
+    pthread_mutex_unlock(&r->mutex);
+}
+
+/*
+    Returns false once the ring is closed and drained.
+ */
+static bool mgr_ring_pop(mgr_ring *r, void **ptr) {
+    pthread_mutex_lock(&r->mutex);
+
+    while (r->size == 0 && r->done == false) {
+        pthread_cond_wait(&r->not_empty, &r->mutex);
+    }
+
+    if (r->size == 0) {
+        pthread_mutex_unlock(&r->mutex);
+        return false;
+    }
+
+    *ptr = r->slots[r->head];
+    r->head = (r->head + 1) % MGR_XFREE_RING_CAPACITY;
+    --r->size;
+
+    pthread_cond_signal(&r->not_full);
+    pthread_mutex_unlock(&r->mutex);
+    return true;
+}
+
+static void mgr_mpsc_init(mgr_mpsc *q) {
+    atomic_init(&q->stub.next, NULL);
+    atomic_init(&q->head, &q->stub);
+    atomic_init(&q->pending, 0);
+    q->tail = &q->stub;
+}
+
+static void mgr_mpsc_push(mgr_mpsc *q, mgr_mpsc_node *n) {
+    atomic_store_explicit(&n->next, NULL, memory_order_relaxed);
+
+    mgr_mpsc_node *prev = atomic_exchange_explicit(&q->head, n, memory_order_acq_rel);
+
+    // until this store, the consumer sees the queue end at prev
+    atomic_store_explicit(&prev->next, n, memory_order_release);
+}
+
+/*
+    Returns NULL if the queue is empty, or if a push has not linked
+    its node yet.
+ */
+static mgr_mpsc_node *mgr_mpsc_pop(mgr_mpsc *q) {
+    mgr_mpsc_node *tail = q->tail;
+    mgr_mpsc_node *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (tail == &q->stub) {
+        if (next == NULL) {
+            return NULL;
+        }
+
+        q->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+
+    if (next) {
+        q->tail = next;
+        return tail;
+    }
+
+    if (tail != atomic_load_explicit(&q->head, memory_order_acquire)) {
+        return NULL;
+    }
+
+    // tail is the last node: put the stub behind it so that it can go
+    mgr_mpsc_push(q, &q->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (next) {
+        q->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+/*!
+    \brief  Pins the calling thread to a cpu
+
+    \param[in]  cpu     cpu index
+
+    \return     cpu if pinned, -1 if pinning is unsupported or refused
+ */
+int mgr_pin(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof set, &set) == 0) {
+        return cpu;
+    }
+#else
+    (void)(cpu);
+#endif
+    return -1;
+}
+
+/*!
+    \brief  Number of online cpus
+
+    \return     online cpu count, at least 1
+ */
+uint32_t mgr_cpu_count(void) {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (uint32_t)(n) : 1;
+}
+
+static void mgr_worker_run_workload(mgr_worker *w) {
+    uint64_t draws = 0;
+
+    for (uint32_t i = 0; i < w->warmup; ++i) {
+        mgr_rand_tls.draws = 0;
+        w->test(w->min, w->max, w->interval);
+        draws = mgr_rand_tls.draws > draws ? mgr_rand_tls.draws : draws;
+    }
+
+    const bool tape = mgr_rand_tape_enabled && draws > 0 && mgr_rand_tape_reserve(mgr_rand_tape_length(draws)) == 0;
+
+    mgr_barrier_wait(w->barrier);
+
+    mgr_oplat_active = w->oplat;
+    mgr_op_count = 0;
+    w->stat.start_ns = mgr_clock_ns();
+
+    for (uint32_t i = 0; i < w->reps; ++i) {
+        if (tape) {
+            mgr_rand_tape_fill();
+        }
+
+        const uint64_t x = mgr_clock_ns();
+        w->test(w->min, w->max, w->interval);
+        const uint64_t y = mgr_clock_ns();
+
+        mgr_samples_push(&w->samples, (double)(y - x));
+    }
+
+    w->stat.end_ns = mgr_clock_ns();
+    mgr_rand_tape_release();
+}
+
+static void mgr_worker_run_producer(mgr_worker *w) {
+    mgr_barrier_wait(w->barrier);
+
+    mgr_oplat_active = w->oplat;
+    mgr_op_count = 0;
+    w->stat.start_ns = mgr_clock_ns();
+
+    uint64_t x = w->stat.start_ns;
+
+    for (uint32_t i = 0; i < w->reps; ++i) {
+        void *ptr = mgr_malloc(mgr_rand_between(w->min, w->max));
+
+        if (ptr && mgr_ring_push(w->ring, ptr) == false) {
+            mgr_free(ptr);
+        }
+
+        if ((i + 1) % MGR_XFREE_BATCH == 0) {
+            const uint64_t y = mgr_clock_ns();
+            mgr_samples_push(&w->samples, (double)(y - x) / MGR_XFREE_BATCH);
+            x = y;
+        }
+    }
+
+    mgr_ring_close(w->ring);
+    w->stat.end_ns = mgr_clock_ns();
+}
+
+static void mgr_worker_run_consumer(mgr_worker *w) {
+    void *ptr = NULL;
+    uint64_t n = 0;
+
+    mgr_barrier_wait(w->barrier);
+
+    mgr_oplat_active = w->oplat;
+    mgr_op_count = 0;
+    w->stat.start_ns = mgr_clock_ns();
+
+    uint64_t x = w->stat.start_ns;
+
+    while (mgr_ring_pop(w->ring, &ptr)) {
+        mgr_free(ptr);
+
+        if (++n % MGR_XFREE_BATCH == 0) {
+            const uint64_t y = mgr_clock_ns();
+            mgr_samples_push(&w->samples, (double)(y - x) / MGR_XFREE_BATCH);
+            x = y;
+        }
+    }
+
+    w->stat.end_ns = mgr_clock_ns();
+}
+
+static void mgr_worker_run_remote_producer(mgr_worker *w) {
+    mgr_remote *r = w->remote;
+
+    mgr_barrier_wait(w->barrier);
+
+    mgr_oplat_active = w->oplat;
+    mgr_op_count = 0;
+    w->stat.start_ns = mgr_clock_ns();
+
+    uint64_t x = w->stat.start_ns;
+
+    for (uint32_t i = 0; i < w->reps; ++i) {
+        mgr_mpsc_node *n = mgr_malloc(mgr_rand_between(w->min, w->max));
+
+        if (n) {
+            mgr_mpsc *q = r->queues + ((w->queue + i) % r->nqueues);
+
+            while (atomic_load_explicit(&q->pending, memory_order_relaxed) >= MGR_REMOTE_INFLIGHT) {
+                sched_yield();
+            }
+
+            atomic_fetch_add_explicit(&q->pending, 1, memory_order_relaxed);
+            n->pushed_ns = mgr_clock_ns();
+            mgr_mpsc_push(q, n);
+        }
+
+        if ((i + 1) % MGR_XFREE_BATCH == 0) {
+            const uint64_t y = mgr_clock_ns();
+            mgr_samples_push(&w->samples, (double)(y - x) / MGR_XFREE_BATCH);
+            x = y;
+        }
+    }
+
+    w->stat.end_ns = mgr_clock_ns();
+    atomic_fetch_sub_explicit(&r->producers, 1, memory_order_release);
+}
+
+static void mgr_worker_run_remote_consumer(mgr_worker *w) {
+    mgr_remote *r = w->remote;
+    mgr_mpsc *q = r->queues + w->queue;
+    uint64_t free_ns = 0;
+    uint64_t n = 0;
+
+    mgr_barrier_wait(w->barrier);
+
+    mgr_oplat_active = w->oplat;
+    mgr_op_count = 0;
+    w->stat.start_ns = mgr_clock_ns();
+
+    for (;;) {
+        // once no producer is left, every push is linked: empty means done
+        const bool last = atomic_load_explicit(&r->producers, memory_order_acquire) == 0;
+        mgr_mpsc_node *node = mgr_mpsc_pop(q);
+
+        if (node == NULL) {
+            if (last) {
+                break;
+            }
+
+            sched_yield();
+            continue;
+        }
+
+        atomic_fetch_sub_explicit(&q->pending, 1, memory_order_relaxed);
+
+        const uint64_t x = mgr_clock_ns();
+        mgr_hist_record(w->handoff, x - node->pushed_ns);
+        mgr_free(node);
+        const uint64_t y = mgr_clock_ns();
+
+        free_ns += y - x;
+
+        if (++n % MGR_XFREE_BATCH == 0) {
+            mgr_samples_push(&w->samples, (double)(free_ns) / MGR_XFREE_BATCH);
+            free_ns = 0;
+        }
+    }
+
+    w->stat.end_ns = mgr_clock_ns();
+}
+
+static void *mgr_worker_main(void *arg) {
+    mgr_worker *w = arg;
+
+    w->stat.cpu = mgr_pin(w->cpu);
+    mgr_rand_seed_thread(w->stream);
+
+    switch (w->role) {
+    case MGR_ROLE_WORKLOAD:
+        mgr_worker_run_workload(w);
+        break;
+    case MGR_ROLE_PRODUCER:
+        mgr_worker_run_producer(w);
+        break;
+    case MGR_ROLE_CONSUMER:
+        mgr_worker_run_consumer(w);
+        break;
+    case MGR_ROLE_REMOTE_PRODUCER:
+        mgr_worker_run_remote_producer(w);
+        break;
+    case MGR_ROLE_REMOTE_CONSUMER:
+        mgr_worker_run_remote_consumer(w);
+        break;
+    }
+
+    w->stat.ops = mgr_op_count;
+    mgr_oplat_active = NULL;
+
+    return NULL;
+}
+
+/*!
+    \brief  Spawns nthreads workers behind a common barrier, joins them,
+            and aggregates their results into report
+
+    \details    On return, report->threads is owned by the caller
+                (see mgr_thread_report_deinit).
+                Per-thread latency recorders are merged into oplat.
+
+    \return     0 on success, -1 if a thread could not be created
+ */
+static int mgr_spawn_join(mgr_worker *workers,
+                          uint32_t nthreads,
+                          mgr_oplat *oplat,
+                          mgr_thread_report *report) {
+    const uint32_t ncpu = mgr_cpu_count();
+    const bool serialized = mgr_alloc_serialized;
+    const bool shared = mgr_alloc_shared;
+
+    uint32_t spawned = 0;
+    int status = 0;
+
+    mgr_barrier barrier;
+    mgr_barrier_init(&barrier, nthreads);
+
+    mgr_alloc_serialized = serialized || (nthreads > 1 && mgr_backend_current->thread_safe == false);
+    mgr_alloc_shared = shared || nthreads > 1;
+
+    for (uint32_t i = 0; i < nthreads; ++i) {
+        mgr_worker *w = workers + i;
+
+        w->cpu = (int)(i % ncpu);
+        w->stream = i + 1;
+        w->barrier = &barrier;
+        w->oplat = oplat ? mgr_oplat_new() : NULL;
+        memset(&w->stat, 0, sizeof w->stat);
+        mgr_samples_init(&w->samples, w->reps > 0 ? w->reps : 1);
+    }
+
+    for (; spawned < nthreads; ++spawned) {
+        mgr_worker *w = workers + spawned;
+
+        if (pthread_create(&w->tid, NULL, mgr_worker_main, w) != 0) {
+            status = -1;
+            break;
+        }
+    }
+
+    if (spawned < nthreads) {
+        /*
+            The barrier can never release if a thread is missing,
+            so shrink it to the threads that did start.
+         */
+        pthread_mutex_lock(&barrier.mutex);
+        barrier.count = spawned;
+
+        if (barrier.waiting >= spawned && spawned > 0) {
+            barrier.waiting = 0;
+            ++barrier.phase;
+            pthread_cond_broadcast(&barrier.cond);
+        }
+
+        pthread_mutex_unlock(&barrier.mutex);
+
+        for (uint32_t i = spawned; i < nthreads; ++i) {
+            if (workers[i].ring && workers[i].role == MGR_ROLE_CONSUMER) {
+                mgr_ring_close(workers[i].ring);
+            }
+
+            // consumers stop once every producer that will ever run is done
+            if (workers[i].remote && workers[i].role == MGR_ROLE_REMOTE_PRODUCER) {
+                atomic_fetch_sub_explicit(&workers[i].remote->producers, 1, memory_order_release);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < spawned; ++i) {
+        pthread_join(workers[i].tid, NULL);
+    }
+
+    mgr_alloc_serialized = serialized;
+    mgr_alloc_shared = shared;
+
+    report->nthreads = spawned;
+    report->ops = 0;
+    report->threads = calloc(nthreads, sizeof *report->threads);
+
+    uint64_t first = UINT64_MAX;
+    uint64_t last = 0;
+
+    for (uint32_t i = 0; i < nthreads; ++i) {
+        mgr_worker *w = workers + i;
+
+        if (i < spawned) {
+            mgr_summarize(&w->samples, &w->stat.run);
+
+            report->ops += w->stat.ops;
+            first = w->stat.start_ns < first ? w->stat.start_ns : first;
+            last = w->stat.end_ns > last ? w->stat.end_ns : last;
+
+            if (report->threads) {
+                report->threads[i] = w->stat;
+            }
+
+            if (oplat && w->oplat) {
+                mgr_oplat_merge(oplat, w->oplat);
+            }
+        }
+
+        mgr_oplat_delete(w->oplat);
+        mgr_samples_deinit(&w->samples);
+    }
+
+    report->elapsed_ns = last > first ? last - first : 0;
+    report->ops_per_sec = report->elapsed_ns > 0 ?
+                          (double)(report->ops) * 1e9 / (double)(report->elapsed_ns) :
+                          0.0;
+
+    mgr_barrier_deinit(&barrier);
+    return status;
+}
+
+/*!
+    \brief  Runs a workload concurrently on nthreads pinned threads
+
+    \details    Each thread runs warmup untimed repetitions, waits at the
+                start barrier, then runs reps timed repetitions.
+
+    \param[in]  test        workload
+    \param[in]  min         first workload parameter
+    \param[in]  max         second workload parameter
+    \param[in]  interval    third workload parameter
+    \param[in]  nthreads    number of threads
+    \param[in]  warmup      untimed repetitions per thread
+    \param[in]  reps        timed repetitions per thread
+    \param[out] oplat       per-op latency recorder, or NULL
+    \param[out] report      aggregate and per-thread results
+
+    \return     0 on success, -1 if not every thread could be created
+ */
+int mgr_run_threaded(memgrind_func_t test,
+                     uint32_t min,
+                     uint32_t max,
+                     uint32_t interval,
+                     uint32_t nthreads,
+                     uint32_t warmup,
+                     uint32_t reps,
+                     mgr_oplat *oplat,
+                     mgr_thread_report *report) {
+    memset(report, 0, sizeof *report);
+
+    mgr_worker *workers = calloc(nthreads, sizeof *workers);
+
+    if (workers == NULL) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < nthreads; ++i) {
+        workers[i].role = MGR_ROLE_WORKLOAD;
+        workers[i].test = test;
+        workers[i].min = min;
+        workers[i].max = max;
+        workers[i].interval = interval;
+        workers[i].warmup = warmup;
+        workers[i].reps = reps;
+    }
+
+    const int status = mgr_spawn_join(workers, nthreads, oplat, report);
+
+    free(workers);
+    return status;
+}
+
+/*!
+    \brief  Cross-thread free: each of pairs producer threads allocates
+            count blocks and hands them to its own consumer thread,
+            which frees them
+
+    \details    Block sizes are drawn uniformly from [min, max].
+                Producers are workers 0, 2, 4...; consumers 1, 3, 5...
+                Each thread's latency samples are the mean per-op time
+                over batches of MGR_XFREE_BATCH operations.
+
+    \param[in]  pairs   number of producer/consumer pairs
+    \param[in]  count   blocks allocated by each producer
+    \param[in]  min     minimum block size
+    \param[in]  max     maximum block size
+    \param[out] oplat   per-op latency recorder, or NULL
+    \param[out] report  aggregate and per-thread results
+
+    \return     0 on success, -1 on failure
+ */
+int mgr_run_xfree(uint32_t pairs,
+                  uint32_t count,
+                  uint32_t min,
+                  uint32_t max,
+                  mgr_oplat *oplat,
+                  mgr_thread_report *report) {
+    memset(report, 0, sizeof *report);
+
+    const uint32_t nthreads = pairs * 2;
+
+    mgr_worker *workers = calloc(nthreads, sizeof *workers);
+    mgr_ring *rings = calloc(pairs, sizeof *rings);
+
+    if (workers == NULL || rings == NULL) {
+        free(workers);
+        free(rings);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < pairs; ++i) {
+        mgr_ring_init(rings + i);
+
+        mgr_worker *producer = workers + (i * 2);
+        mgr_worker *consumer = producer + 1;
+
+        producer->role = MGR_ROLE_PRODUCER;
+        producer->ring = rings + i;
+        producer->min = min;
+        producer->max = max;
+        producer->reps = count;
+
+        consumer->role = MGR_ROLE_CONSUMER;
+        consumer->ring = rings + i;
+    }
+
+    const int status = mgr_spawn_join(workers, nthreads, oplat, report);
+
+    for (uint32_t i = 0; i < pairs; ++i) {
+        mgr_ring_deinit(rings + i);
+    }
+
+    free(rings);
+    free(workers);
+    return status;
+}
+
+/*!
+    \brief  Remote free: each producer thread allocates count blocks
+            and hands them, through lock-free queues, to the consumer
+            threads, which free them
+
+    \details    Each consumer drains its own multi-producer queue;
+                producer i pushes its blocks round-robin to every queue,
+                starting at queue i, so producers > consumers is fan-in
+                and consumers > producers is fan-out. A producer backs
+                off while a queue holds MGR_REMOTE_INFLIGHT blocks.
+
+                Consumers are workers 0 through consumers - 1; producers
+                follow. Producers' latency samples are the mean time per
+                malloc and push, consumers' the mean time per free, over
+                batches of MGR_XFREE_BATCH blocks. The time from each
+                push to the start of its free is recorded into handoff.
+
+    \param[in]  producers   producer threads
+    \param[in]  consumers   consumer threads (and queues)
+    \param[in]  count       blocks allocated by each producer
+    \param[in]  min         minimum block size (raised to fit the queue link)
+    \param[in]  max         maximum block size
+    \param[out] oplat       per-op latency recorder, or NULL
+    \param[out] handoff     push-to-free latency (ns)
+    \param[out] report      aggregate and per-thread results
+
+    \return     0 on success, -1 on failure
+ */
+int mgr_run_remote(uint32_t producers,
+                   uint32_t consumers,
+                   uint32_t count,
+                   uint32_t min,
+                   uint32_t max,
+                   mgr_oplat *oplat,
+                   mgr_hist *handoff,
+                   mgr_thread_report *report) {
+    memset(report, 0, sizeof *report);
+    mgr_hist_reset(handoff);
+
+    if (producers == 0 || consumers == 0) {
+        return -1;
+    }
+
+    const uint32_t nthreads = consumers + producers;
+
+    mgr_remote remote;
+    mgr_worker *workers = calloc(nthreads, sizeof *workers);
+    mgr_hist *hists = calloc(consumers, sizeof *hists);
+
+    remote.nqueues = consumers;
+    remote.queues = aligned_alloc(_Alignof(mgr_mpsc), sizeof *remote.queues * consumers);
+    atomic_init(&remote.producers, producers);
+
+    if (workers == NULL || hists == NULL || remote.queues == NULL) {
+        free(workers);
+        free(hists);
+        free(remote.queues);
+        return -1;
+    }
+
+    min = min < sizeof(mgr_mpsc_node) ? sizeof(mgr_mpsc_node) : min;
+
+    for (uint32_t i = 0; i < nthreads; ++i) {
+        mgr_worker *w = workers + i;
+
+        w->remote = &remote;
+
+        if (i < consumers) {
+            mgr_mpsc_init(remote.queues + i);
+            mgr_hist_reset(hists + i);
+
+            w->role = MGR_ROLE_REMOTE_CONSUMER;
+            w->queue = i;
+            w->handoff = hists + i;
+            w->reps = (uint32_t)(((uint64_t)(count) * producers / consumers) / MGR_XFREE_BATCH);
+        } else {
+            w->role = MGR_ROLE_REMOTE_PRODUCER;
+            w->queue = (i - consumers) % consumers;
+            w->min = min;
+            w->max = max;
+            w->reps = count;
+        }
+    }
+
+    const int status = mgr_spawn_join(workers, nthreads, oplat, report);
+
+    for (uint32_t i = 0; i < consumers; ++i) {
+        mgr_hist_merge(handoff, hists + i);
+    }
+
+    free(remote.queues);
+    free(hists);
+    free(workers);
+    return status;
+}
+
+/*!
+    \brief  Runs a workload at 1, 2, 4... up to max_threads threads
+            and prints one row per thread count
+
+    \param[in]  test        workload
+    \param[in]  tch         character that represents the test case
+    \param[in]  min         first workload parameter
+    \param[in]  max         second workload parameter
+    \param[in]  interval    third workload parameter
+    \param[in]  max_threads largest thread count
+    \param[in]  warmup      untimed repetitions per thread
+    \param[in]  reps        timed repetitions per thread
+    \param[in]  dest        destination file stream
+ */
+void mgr_run_scaling(memgrind_func_t test,
+                     char tch,
+                     uint32_t min,
+                     uint32_t max,
+                     uint32_t interval,
+                     uint32_t max_threads,
+                     uint32_t warmup,
+                     uint32_t reps,
+                     FILE *dest) {
+    uint32_t n = 1;
+
+    for (;;) {
+        mgr_thread_report report;
+
+        if (mgr_run_threaded(test, min, max, interval, n, warmup, reps, NULL, &report) != 0) {
+            fprintf(dest, "%s%c%s\t%u\t%sthread creation failed%s\n", KGRN_b, tch, KNRM, n, KRED_b, KNRM);
+            mgr_thread_report_deinit(&report);
+            break;
+        }
+
+        double mean = 0.0;
+        double worst_p99 = 0.0;
+
+        for (uint32_t i = 0; i < report.nthreads; ++i) {
+            mean += report.threads[i].run.mean / report.nthreads;
+            worst_p99 = report.threads[i].run.p99 > worst_p99 ? report.threads[i].run.p99 : worst_p99;
+        }
+
+        fprintf(dest,
+                "%s%c%s\t%u\t%.0lf\t\t%.5lf\t\t%.5lf\n",
+                KGRN_b, tch, KNRM,
+                report.nthreads,
+                report.ops_per_sec,
+                mean * 1e-3,
+                worst_p99 * 1e-3);
+
+        mgr_thread_report_deinit(&report);
+
+        if (n >= max_threads) {
+            break;
+        }
+
+        n = n * 2 < max_threads ? n * 2 : max_threads;
+    }
+}
+
+/*!
+    \brief  Prints the per-thread rows of a threaded run report
+
+    \param[in]  dest    destination file stream
+    \param[in]  report  threaded run report
+ */
+void mgr_thread_report_fprint(FILE *dest, const mgr_thread_report *report) {
+    fprintf(dest,
+            "%s\t%s\t%s\t\t%s\t\t%s\t\t%s\t\t%s\n",
+            KWHT_b"thread"KNRM, KWHT_b"cpu"KNRM, KWHT_b"ops"KNRM, KWHT_b"ops/s"KNRM,
+            KWHT_b"mean"KNRM, KWHT_b"p99"KNRM, KWHT_b"max"KNRM);
+
+    for (uint32_t i = 0; i < report->nthreads; ++i) {
+        const mgr_thread_stat *t = report->threads + i;
+        const uint64_t elapsed = t->end_ns > t->start_ns ? t->end_ns - t->start_ns : 0;
+
+        fprintf(dest,
+                "%u\t%d\t%llu\t\t%.0lf\t\t%.5lf\t\t%.5lf\t\t%.5lf\n",
+                i,
+                t->cpu,
+                (unsigned long long)(t->ops),
+                elapsed > 0 ? (double)(t->ops) * 1e9 / (double)(elapsed) : 0.0,
+                t->run.mean * 1e-3,
+                t->run.p99 * 1e-3,
+                t->run.max * 1e-3);
+    }
+
+    fprintf(dest,
+            "%s\t\t%llu\t\t%.0lf\n",
+            KWHT_b"total"KNRM,
+            (unsigned long long)(report->ops),
+            report->ops_per_sec);
+}
+
+/*!
+    \brief  Releases the per-thread results of a report
+
+    \param[in]  report  threaded run report
+ */
+void mgr_thread_report_deinit(mgr_thread_report *report) {
+    free(report->threads);
+    report->threads = NULL;
+    report->nthreads = 0;
+}
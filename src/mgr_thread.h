@@ -0,0 +1,84 @@
+/*!
+    \file       mgr_thread.h
+    \brief      Header file for memgrind_c multithreaded contention runs
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#ifndef MGR_THREAD_H
+#define MGR_THREAD_H
+
+#include "mgr_hist.h"
+#include "mgr_stats.h"
+#include "mgr_workload.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*!
+    \brief  Results of one thread of a threaded run
+ */
+typedef struct mgr_thread_stat {
+    int cpu;                // cpu the thread was pinned to, -1 if unpinned
+    uint64_t ops;           // allocator calls made in the timed region
+    uint64_t start_ns;      // barrier release, monotonic clock
+    uint64_t end_ns;        // end of the last repetition, monotonic clock
+    mgr_summary run;        // latency of one workload repetition (ns)
+} mgr_thread_stat;
+
+/*!
+    \brief  Aggregate results of a threaded run
+ */
+typedef struct mgr_thread_report {
+    uint32_t nthreads;
+    uint64_t ops;
+    uint64_t elapsed_ns;    // first thread start to last thread end
+    double ops_per_sec;
+    mgr_thread_stat *threads;
+} mgr_thread_report;
+
+// Number of online cpus (at least 1)
+uint32_t mgr_cpu_count(void);
+int mgr_pin(int cpu);
+
+int mgr_run_threaded(memgrind_func_t test,
+                     uint32_t min,
+                     uint32_t max,
+                     uint32_t interval,
+                     uint32_t nthreads,
+                     uint32_t warmup,
+                     uint32_t reps,
+                     mgr_oplat *oplat,
+                     mgr_thread_report *report);
+
+int mgr_run_xfree(uint32_t pairs,
+                  uint32_t count,
+                  uint32_t min,
+                  uint32_t max,
+                  mgr_oplat *oplat,
+                  mgr_thread_report *report);
+
+int mgr_run_remote(uint32_t producers,
+                   uint32_t consumers,
+                   uint32_t count,
+                   uint32_t min,
+                   uint32_t max,
+                   mgr_oplat *oplat,
+                   mgr_hist *handoff,
+                   mgr_thread_report *report);
+
+void mgr_run_scaling(memgrind_func_t test,
+                     char tch,
+                     uint32_t min,
+                     uint32_t max,
+                     uint32_t interval,
+                     uint32_t max_threads,
+                     uint32_t warmup,
+                     uint32_t reps,
+                     FILE *dest);
+
+void mgr_thread_report_fprint(FILE *dest, const mgr_thread_report *report);
+void mgr_thread_report_deinit(mgr_thread_report *report);
+
+#endif /* MGR_THREAD_H */
@@ -0,0 +1,706 @@
+/*!
+    \file       mgr_trace.c
+    \brief      Source file for memgrind_c allocation trace recording and replay
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mgr_trace.h"
+#include "mgr_ptrmap.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// stdio buffer of the trace writer
+#define MGR_TRACE_WRITE_BUFFER (1u << 20)
+
+struct mgr_trace_writer {
+    FILE *file;
+    char *buffer;
+    uint32_t flags;
+    uint64_t op_count;
+    uint32_t slot_count;
+};
+
+static void put_u32(uint8_t *dst, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        dst[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void put_u64(uint8_t *dst, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        dst[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t *src) {
+    uint32_t value = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        value |= (uint32_t)(src[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+static uint64_t get_u64(const uint8_t *src) {
+    uint64_t value = 0;
+
+    for (int i = 0; i < 8; ++i) {
+        value |= (uint64_t)(src[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+static size_t put_varint(uint8_t *dst, uint64_t value) {
+    size_t n = 0;
+
+    while (value >= 0x80) {
+        dst[n++] = (uint8_t)(value) | 0x80;
+        value >>= 7;
+    }
+
+    dst[n++] = (uint8_t)(value);
+    return n;
+}
+
+static inline bool get_varint(mgr_trace_reader *r, uint64_t *out) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+
+    while (r->cursor < r->length && shift < 64) {
+        const uint8_t byte = r->base[r->cursor++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0) {
+            *out = value;
+            return true;
+        }
+
+        shift += 7;
+    }
+
+    return false;
+}
+
+/*!
+    \brief  Memory-maps a trace file and validates its header
+
+    \details    The file is never read into the heap; pages are faulted
+                in on demand as the reader advances, with a sequential
+                access hint to the kernel.
+
+    \param[out] r       reader
+    \param[in]  path    trace file
+
+    \return     0 on success, -1 on failure (reported on stderr)
+ */
+int mgr_trace_reader_open(mgr_trace_reader *r, const char *path) {
+    memset(r, 0, sizeof *r);
+
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (size_t)(st.st_size) < MGR_TRACE_HEADER_SIZE) {
+        fprintf(stderr, "memgrind: %s: not a trace file\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void *base = mmap(NULL, (size_t)(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+
+    posix_madvise(base, (size_t)(st.st_size), POSIX_MADV_SEQUENTIAL);
+
+    r->base = base;
+    r->length = (size_t)(st.st_size);
+
+    if (memcmp(r->base, MGR_TRACE_MAGIC, 8) != 0 || get_u32(r->base + 8) != MGR_TRACE_VERSION) {
+        fprintf(stderr, "memgrind: %s: not a version %d trace file\n", path, MGR_TRACE_VERSION);
+        mgr_trace_reader_close(r);
+        return -1;
+    }
+
+    r->flags = get_u32(r->base + 12);
+    r->op_count = get_u64(r->base + 16);
+    r->slot_count = get_u32(r->base + 24);
+    r->cursor = MGR_TRACE_HEADER_SIZE;
+
+    return 0;
+}
+
+/*!
+    \brief  Unmaps a trace file
+
+    \param[in]  r   reader
+ */
+void mgr_trace_reader_close(mgr_trace_reader *r) {
+    if (r->base) {
+        munmap((void *)(r->base), r->length);
+    }
+
+    memset(r, 0, sizeof *r);
+}
+
+/*!
+    \brief  Moves a reader back to the first record
+
+    \param[in]  r   reader
+ */
+void mgr_trace_reader_rewind(mgr_trace_reader *r) {
+    r->cursor = MGR_TRACE_HEADER_SIZE;
+}
+
+/*!
+    \brief  Decodes the next record of a trace
+
+    \param[in]  r   reader
+    \param[out] op  decoded record
+
+    \return     true if a record was decoded, false at the end of the
+                trace or at a truncated/malformed record
+ */
+bool mgr_trace_next(mgr_trace_reader *r, mgr_trace_op *op) {
+    uint64_t value = 0;
+
+    if (r->cursor >= r->length) {
+        return false;
+    }
+
+    op->op = (mgr_trace_opcode)(r->base[r->cursor++]);
+    op->size = 0;
+    op->thread = 0;
+    op->delta_ns = 0;
+
+    if (op->op < MGR_TRACE_MALLOC || op->op > MGR_TRACE_CALLOC || get_varint(r, &value) == false) {
+        return false;
+    }
+
+    op->slot = (uint32_t)(value);
+
+    if (op->op != MGR_TRACE_FREE && get_varint(r, &op->size) == false) {
+        return false;
+    }
+
+    if (r->flags & MGR_TRACE_F_THREAD) {
+        if (get_varint(r, &value) == false) {
+            return false;
+        }
+
+        op->thread = (uint32_t)(value);
+    }
+
+    if ((r->flags & MGR_TRACE_F_TIME) && get_varint(r, &op->delta_ns) == false) {
+        return false;
+    }
+
+    return true;
+}
+
+static int mgr_trace_write_header(mgr_trace_writer *w) {
+    uint8_t header[MGR_TRACE_HEADER_SIZE] = { 0 };
+
+    memcpy(header, MGR_TRACE_MAGIC, 8);
+    put_u32(header + 8, MGR_TRACE_VERSION);
+    put_u32(header + 12, w->flags);
+    put_u64(header + 16, w->op_count);
+    put_u32(header + 24, w->slot_count);
+
+    return fwrite(header, sizeof header, 1, w->file) == 1 ? 0 : -1;
+}
+
+/*!
+    \brief  Creates a trace file
+
+    \param[in]  path    trace file
+    \param[in]  flags   MGR_TRACE_F_* fields to include in every record
+
+    \return     a new writer, or NULL on failure (reported on stderr)
+ */
+mgr_trace_writer *mgr_trace_writer_open(const char *path, uint32_t flags) {
+    mgr_trace_writer *w = calloc(1, sizeof *w);
+
+    if (w == NULL) {
+        return NULL;
+    }
+
+    w->flags = flags & (MGR_TRACE_F_THREAD | MGR_TRACE_F_TIME);
+    w->file = fopen(path, "wb");
+    w->buffer = malloc(MGR_TRACE_WRITE_BUFFER);
+
+    if (w->file == NULL) {
+        perror(path);
+        free(w->buffer);
+        free(w);
+        return NULL;
+    }
+
+    if (w->buffer) {
+        setvbuf(w->file, w->buffer, _IOFBF, MGR_TRACE_WRITE_BUFFER);
+    }
+
+    // placeholder; counts are patched in by mgr_trace_writer_close
+    mgr_trace_write_header(w);
+    return w;
+}
+
+/*!
+    \brief  Appends one record to a trace
+
+    \param[in]  w   writer
+    \param[in]  op  record to append
+ */
+void mgr_trace_write(mgr_trace_writer *w, const mgr_trace_op *op) {
+    uint8_t record[1 + (4 * 10)];
+    size_t n = 0;
+
+    record[n++] = (uint8_t)(op->op);
+    n += put_varint(record + n, op->slot);
+
+    if (op->op != MGR_TRACE_FREE) {
+        n += put_varint(record + n, op->size);
+    }
+
+    if (w->flags & MGR_TRACE_F_THREAD) {
+        n += put_varint(record + n, op->thread);
+    }
+
+    if (w->flags & MGR_TRACE_F_TIME) {
+        n += put_varint(record + n, op->delta_ns);
+    }
+
+    fwrite(record, n, 1, w->file);
+
+    ++w->op_count;
+    w->slot_count = op->slot + 1 > w->slot_count ? op->slot + 1 : w->slot_count;
+}
+
+/*!
+    \brief  Finalizes the header of a trace and closes it
+
+    \param[in]  w   writer
+
+    \return     0 on success, -1 if the trace could not be written
+ */
+int mgr_trace_writer_close(mgr_trace_writer *w) {
+    int status = 0;
+
+    if (fflush(w->file) != 0 || fseek(w->file, 0, SEEK_SET) != 0 || mgr_trace_write_header(w) != 0) {
+        status = -1;
+    }
+
+    if (fclose(w->file) != 0) {
+        status = -1;
+    }
+
+    free(w->buffer);
+    free(w);
+    return status;
+}
+
+/*
+    Recording backend:
+    wraps the backend that was current when recording began, and logs
+    every call it forwards. Live blocks are mapped to slot ids through
+    an open-addressing table keyed by address; freed slot ids are
+    recycled so the slot table of a replay stays as small as the
+    peak live set.
+
+    Calls are serialized so records land in the order the calls took
+    effect, which keeps cross-thread malloc/free pairs consistent.
+ */
+
+static struct {
+    pthread_mutex_t mutex;
+    const mgr_backend *inner;
+    mgr_trace_writer *writer;
+    uint64_t last_ns;
+    uint32_t next_thread;
+
+    mgr_ptrmap slots;
+
+    uint32_t *free_slots;
+    size_t free_size;
+    size_t free_capacity;
+    uint32_t next_slot;
+} rec = { PTHREAD_MUTEX_INITIALIZER };
+
+static _Thread_local uint32_t rec_thread = 0;
+
+static uint32_t rec_insert(void *ptr) {
+    uint32_t slot = rec.next_slot;
+
+    if (rec.free_size > 0) {
+        slot = rec.free_slots[--rec.free_size];
+    } else {
+        ++rec.next_slot;
+    }
+
+    mgr_ptrmap_insert(&rec.slots, ptr, slot);
+    return slot;
+}
+
+/*
+    Removes ptr from the slot map, and returns its slot id to the free list.
+    Returns UINT32_MAX if ptr was never recorded.
+ */
+static uint32_t rec_remove(void *ptr) {
+    uint64_t value = 0;
+
+    if (mgr_ptrmap_remove(&rec.slots, ptr, &value) == false) {
+        return UINT32_MAX;
+    }
+
+    const uint32_t slot = (uint32_t)(value);
+
+    if (rec.free_size == rec.free_capacity) {
+        const size_t capacity = rec.free_capacity > 0 ? rec.free_capacity * 2 : 256;
+        uint32_t *free_slots = realloc(rec.free_slots, sizeof *free_slots * capacity);
+
+        if (free_slots == NULL) {
+            return slot;
+        }
+
+        rec.free_slots = free_slots;
+        rec.free_capacity = capacity;
+    }
+
+    rec.free_slots[rec.free_size++] = slot;
+    return slot;
+}
+
+static void rec_log(mgr_trace_opcode opcode, uint32_t slot, size_t size) {
+    if (rec_thread == 0) {
+        rec_thread = ++rec.next_thread;
+    }
+
+    const uint64_t now = mgr_clock_ns();
+
+    mgr_trace_op op = {
+        .op = opcode,
+        .slot = slot,
+        .size = size,
+        .thread = rec_thread - 1,
+        .delta_ns = rec.last_ns > 0 ? now - rec.last_ns : 0
+    };
+
+    rec.last_ns = now;
+    mgr_trace_write(rec.writer, &op);
+}
+
+static void *rec_malloc(size_t size) {
+    pthread_mutex_lock(&rec.mutex);
+
+    void *ptr = rec.inner->malloc_fn(size);
+
+    if (ptr) {
+        rec_log(MGR_TRACE_MALLOC, rec_insert(ptr), size);
+    }
+
+    pthread_mutex_unlock(&rec.mutex);
+    return ptr;
+}
+
+static void rec_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&rec.mutex);
+
+    const uint32_t slot = rec_remove(ptr);
+
+    if (slot != UINT32_MAX) {
+        rec_log(MGR_TRACE_FREE, slot, 0);
+    }
+
+    rec.inner->free_fn(ptr);
+    pthread_mutex_unlock(&rec.mutex);
+}
+
+static void *rec_realloc(void *ptr, size_t old_size, size_t new_size) {
+    void *res = NULL;
+
+    pthread_mutex_lock(&rec.mutex);
+
+    if (rec.inner->realloc_fn) {
+        res = rec.inner->realloc_fn(ptr, old_size, new_size);
+    } else if (ptr == NULL || new_size > 0) {
+        res = rec.inner->malloc_fn(new_size);
+
+        if (res && ptr) {
+            memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+            rec.inner->free_fn(ptr);
+        }
+    } else {
+        rec.inner->free_fn(ptr);
+    }
+
+    if (ptr == NULL) {
+        if (res) {
+            rec_log(MGR_TRACE_MALLOC, rec_insert(res), new_size);
+        }
+    } else if (res || new_size == 0) {
+        const uint32_t slot = rec_remove(ptr);
+
+        if (res) {
+            // rec_remove just freed slot, so rec_insert hands it back
+            const uint32_t new_slot = rec_insert(res);
+            rec_log(slot != UINT32_MAX ? MGR_TRACE_REALLOC : MGR_TRACE_MALLOC, new_slot, new_size);
+        } else if (slot != UINT32_MAX) {
+            rec_log(MGR_TRACE_FREE, slot, 0);
+        }
+    }
+
+    pthread_mutex_unlock(&rec.mutex);
+    return res;
+}
+
+static void *rec_calloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&rec.mutex);
+
+    void *ptr = NULL;
+
+    if (rec.inner->calloc_fn) {
+        ptr = rec.inner->calloc_fn(count, size);
+    } else if ((ptr = rec.inner->malloc_fn(count * size))) {
+        memset(ptr, 0, count * size);
+    }
+
+    if (ptr) {
+        rec_log(MGR_TRACE_CALLOC, rec_insert(ptr), count * size);
+    }
+
+    pthread_mutex_unlock(&rec.mutex);
+    return ptr;
+}
+
+static const mgr_backend mgr_backend_record = {
+    .name = "trace-record",
+    .thread_safe = true,
+    .init_fn = NULL,
+    .teardown_fn = NULL,
+    .malloc_fn = rec_malloc,
+    .free_fn = rec_free,
+    .realloc_fn = rec_realloc,
+    .calloc_fn = rec_calloc,
+    .aligned_malloc_fn = NULL,         // emulated, so replays as the malloc it was
+    .stats_fn = NULL,
+    .usable_size_fn = NULL,
+    .batch_malloc_fn = NULL,
+    .batch_free_fn = NULL,
+    .reset_fn = NULL,
+    .cache_stats_fn = NULL,
+    .walk_fn = NULL
+};
+
+/*!
+    \brief  Starts recording every allocator call into a trace file
+
+    \details    The current backend keeps serving the calls;
+                it is restored by mgr_trace_record_end.
+
+    \param[in]  path    trace file to create
+    \param[in]  flags   MGR_TRACE_F_* fields to record
+
+    \return     0 on success, -1 on failure
+ */
+int mgr_trace_record_begin(const char *path, uint32_t flags) {
+    if (rec.writer) {
+        return -1;
+    }
+
+    rec.writer = mgr_trace_writer_open(path, flags);
+
+    if (rec.writer == NULL) {
+        return -1;
+    }
+
+    rec.inner = mgr_backend_current;
+    rec.last_ns = 0;
+    mgr_backend_current = &mgr_backend_record;
+
+    return 0;
+}
+
+/*!
+    \brief  Stops recording, restores the recorded backend,
+            and finalizes the trace file
+
+    \return     0 on success, -1 on failure
+ */
+int mgr_trace_record_end(void) {
+    if (rec.writer == NULL) {
+        return -1;
+    }
+
+    mgr_backend_current = rec.inner;
+
+    const int status = mgr_trace_writer_close(rec.writer);
+
+    mgr_ptrmap_deinit(&rec.slots);
+    free(rec.free_slots);
+
+    rec.writer = NULL;
+    rec.free_slots = NULL;
+    rec.free_size = 0;
+    rec.free_capacity = 0;
+    rec.next_slot = 0;
+
+    return status;
+}
+
+/*
+    Replay state: the loaded trace, and the block living in each slot.
+ */
+typedef struct mgr_replay_slot {
+    void *ptr;
+    size_t size;
+} mgr_replay_slot;
+
+static mgr_trace_reader replay;
+static mgr_replay_slot *replay_slots = NULL;
+
+/*!
+    \brief  Maps a trace for mgr_trace_replay
+
+    \details    If the header's counts were never patched (the recording
+                process died), the trace is scanned once to recover them.
+
+    \param[in]  path    trace file
+
+    \return     0 on success, -1 on failure
+ */
+int mgr_trace_replay_load(const char *path) {
+    mgr_trace_replay_unload();
+
+    if (mgr_trace_reader_open(&replay, path) != 0) {
+        return -1;
+    }
+
+    if (replay.op_count == 0 || replay.slot_count == 0) {
+        mgr_trace_op op;
+
+        while (mgr_trace_next(&replay, &op)) {
+            ++replay.op_count;
+            replay.slot_count = op.slot + 1 > replay.slot_count ? op.slot + 1 : replay.slot_count;
+        }
+
+        mgr_trace_reader_rewind(&replay);
+    }
+
+    replay_slots = calloc(replay.slot_count > 0 ? replay.slot_count : 1, sizeof *replay_slots);
+
+    if (replay_slots == NULL) {
+        mgr_trace_reader_close(&replay);
+        return -1;
+    }
+
+    return 0;
+}
+
+/*!
+    \brief  Unmaps the trace loaded by mgr_trace_replay_load
+ */
+void mgr_trace_replay_unload(void) {
+    free(replay_slots);
+    replay_slots = NULL;
+    mgr_trace_reader_close(&replay);
+}
+
+/*!
+    \brief  Workload: replays the loaded trace through the current
+            backend, in trace order, then frees every block the trace
+            left live (so repetitions start from the same state)
+
+    \details    Records are decoded straight from the mapping as they
+                are replayed. Thread ids and timestamps are not honored;
+                records naming a slot outside the header's slot count
+                are skipped.
+
+    \param[in]  unused_value0   unused value -- needed for function uniformity
+    \param[in]  unused_value1   unused value -- needed for function uniformity
+    \param[in]  unused_value2   unused value -- needed for function uniformity
+ */
+void mgr_trace_replay(uint32_t unused_value0, uint32_t unused_value1, uint32_t unused_value2) {
+    mgr_trace_op op;
+
+    if (replay_slots == NULL) {
+        return;
+    }
+
+    mgr_trace_reader_rewind(&replay);
+
+    while (mgr_trace_next(&replay, &op)) {
+        if (op.slot >= replay.slot_count) {
+            continue;
+        }
+
+        mgr_replay_slot *s = replay_slots + op.slot;
+
+        switch (op.op) {
+        case MGR_TRACE_MALLOC:
+        case MGR_TRACE_CALLOC:
+            if (s->ptr) {
+                mgr_free(s->ptr);
+            }
+
+            s->ptr = op.op == MGR_TRACE_MALLOC ?
+                     mgr_malloc((size_t)(op.size)) :
+                     mgr_calloc(1, (size_t)(op.size));
+            s->size = (size_t)(op.size);
+            break;
+
+        case MGR_TRACE_REALLOC: {
+            void *res = mgr_realloc(s->ptr, s->size, (size_t)(op.size));
+
+            if (res || op.size == 0) {
+                s->ptr = res;
+                s->size = (size_t)(op.size);
+            }
+
+            break;
+        }
+
+        case MGR_TRACE_FREE:
+            if (s->ptr) {
+                mgr_free(s->ptr);
+                s->ptr = NULL;
+            }
+
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < replay.slot_count; ++i) {
+        if (replay_slots[i].ptr) {
+            mgr_free(replay_slots[i].ptr);
+            replay_slots[i].ptr = NULL;
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*!
+    \file       mgr_trace.h
+    \brief      Header file for memgrind_c allocation trace recording and replay
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+
+    \details
+    Trace file layout (all integers little-endian):
+
+        header, 32 bytes
+            char     magic[8]       "MGRTRACE"
+            uint32_t version        MGR_TRACE_VERSION
+            uint32_t flags          MGR_TRACE_F_*
+            uint64_t op_count       number of records
+            uint32_t slot_count     1 + largest slot id used
+            uint32_t reserved       0
+
+        records, back to back, each:
+            uint8_t  op             mgr_trace_opcode
+            varint   slot           slot id the block lives in
+            varint   size           (malloc, calloc, realloc only) new size
+            varint   thread         (if MGR_TRACE_F_THREAD) thread id
+            varint   delta_ns       (if MGR_TRACE_F_TIME) ns since previous record
+
+    Varints are unsigned LEB128: 7 bits per byte, low bits first,
+    high bit set on every byte but the last.
+
+    A slot names one live block; slot ids are reused after a free,
+    so slot_count bounds the live set, not the number of allocations.
+ */
+
+#ifndef MGR_TRACE_H
+#define MGR_TRACE_H
+
+#include "mgr_alloc.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define MGR_TRACE_MAGIC "MGRTRACE"
+#define MGR_TRACE_VERSION 1
+#define MGR_TRACE_HEADER_SIZE 32
+
+#define MGR_TRACE_F_THREAD 0x1u
+#define MGR_TRACE_F_TIME 0x2u
+
+typedef enum mgr_trace_opcode {
+    MGR_TRACE_MALLOC = 1,
+    MGR_TRACE_FREE = 2,
+    MGR_TRACE_REALLOC = 3,
+    MGR_TRACE_CALLOC = 4
+} mgr_trace_opcode;
+
+/*!
+    \brief  One decoded trace record
+ */
+typedef struct mgr_trace_op {
+    mgr_trace_opcode op;
+    uint32_t slot;
+    uint64_t size;
+    uint32_t thread;
+    uint64_t delta_ns;
+} mgr_trace_op;
+
+/*!
+    \brief  Streaming reader over a memory-mapped trace file
+ */
+typedef struct mgr_trace_reader {
+    const uint8_t *base;
+    size_t length;
+    size_t cursor;
+
+    uint32_t flags;
+    uint64_t op_count;
+    uint32_t slot_count;
+} mgr_trace_reader;
+
+typedef struct mgr_trace_writer mgr_trace_writer;
+
+int mgr_trace_reader_open(mgr_trace_reader *r, const char *path);
+void mgr_trace_reader_close(mgr_trace_reader *r);
+void mgr_trace_reader_rewind(mgr_trace_reader *r);
+bool mgr_trace_next(mgr_trace_reader *r, mgr_trace_op *op);
+
+mgr_trace_writer *mgr_trace_writer_open(const char *path, uint32_t flags);
+void mgr_trace_write(mgr_trace_writer *w, const mgr_trace_op *op);
+int mgr_trace_writer_close(mgr_trace_writer *w);
+
+int mgr_trace_record_begin(const char *path, uint32_t flags);
+int mgr_trace_record_end(void);
+
+int mgr_trace_replay_load(const char *path);
+void mgr_trace_replay_unload(void);
+void mgr_trace_replay(uint32_t unused_value0, uint32_t unused_value1, uint32_t unused_value2);
+
+#endif /* MGR_TRACE_H */
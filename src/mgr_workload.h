@@ -0,0 +1,69 @@
+/*!
+    \file       mgr_workload.h
+    \brief      Header file for the memgrind_c workload signature and workloads
+
+    \author     Gemuele Aludino
+    \date       17 Oct 2026
+ */
+
+#ifndef MGR_WORKLOAD_H
+#define MGR_WORKLOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Every workload takes three nonnegative parameters,
+    whose meaning differs between workloads.
+ */
+typedef void (*memgrind_func_t)(uint32_t, uint32_t, uint32_t);
+
+/*!
+    \brief  One entry of the test table: a workload and its parameters
+
+    \details    params names the workload's three parameters, in order,
+                for configuration keys such as "d.max";
+                NULL marks an unused parameter.
+ */
+typedef struct mgr_test {
+    memgrind_func_t test;
+    char tch;
+    uint32_t min;
+    uint32_t max;
+    uint32_t interval;
+    const char *params[3];
+    bool enabled;
+} mgr_test;
+
+/*!
+    \brief  Address of the ith parameter (min, max, interval) of a test
+
+    \param[in]  t   test table entry
+    \param[in]  i   parameter index, in [0, 3)
+
+    \return     address of the parameter
+ */
+static inline uint32_t *mgr_test_param(mgr_test *t, int i) {
+    return i == 0 ? &t->min : (i == 1 ? &t->max : &t->interval);
+}
+
+// memgrind: tests a through r (in order)
+void mgr_simple_alloc_free(uint32_t max_iter, uint32_t alloc_sz, uint32_t unused_value);
+void mgr_alloc_array_interval(uint32_t max_iter, uint32_t alloc_sz, uint32_t interval);
+void mgr_alloc_array_range(uint32_t max_allocs, uint32_t alloc_sz_min, uint32_t alloc_sz_max);
+void mgr_char_ptr_array(uint32_t min, uint32_t max, uint32_t unused_value);
+void mgr_vector(uint32_t min, uint32_t max, uint32_t initial);
+void mgr_size_class_churn(uint32_t size, uint32_t live, uint32_t ops);
+void mgr_vector_realloc(uint32_t min, uint32_t max, uint32_t initial);
+void mgr_realloc_growth(uint32_t max, uint32_t growth, uint32_t step);
+void mgr_calloc_blocks(uint32_t count, uint32_t size, uint32_t use_memset);
+void mgr_batch_alloc(uint32_t count, uint32_t size, uint32_t batch);
+void mgr_vector_bulk(uint32_t min, uint32_t max, uint32_t initial);
+void mgr_char_ptr_array_scoped(uint32_t min, uint32_t max, uint32_t unused_value);
+void mgr_vector_scoped(uint32_t min, uint32_t max, uint32_t initial);
+void mgr_list_traverse(uint32_t nodes, uint32_t passes, uint32_t noise);
+void mgr_tree_traverse(uint32_t nodes, uint32_t passes, uint32_t noise);
+void mgr_hash_chains(uint32_t nodes, uint32_t passes, uint32_t noise);
+void mgr_aligned_array_range(uint32_t max_allocs, uint32_t alignment, uint32_t alloc_sz_max);
+
+#endif /* MGR_WORKLOAD_H */